@@ -41,8 +41,13 @@ import m5.objects
 
 def config_etrace(cpu_cls, cpu_list, options):
     if issubclass(cpu_cls, m5.objects.DerivO3CPU):
-        # Assign the same file name to all cpus for now. This must be
-        # revisited when creating elastic traces for multi processor systems.
+        # Assign the same file name to all cpus. The probe prefixes it with
+        # its own name, so each cpu writes separate traces. Synchronization
+        # points are numbered across all cpus so that the per-cpu traces can
+        # be replayed together on Trace CPUs sharing a TraceSync.
+        sync_order = None
+        if len(cpu_list) > 1:
+            sync_order = m5.objects.ElasticTraceSync()
         for cpu in cpu_list:
             # Attach the elastic trace probe listener. Set the protobuf trace
             # file names. Set the dependency window size equal to the cpu it
@@ -51,6 +56,8 @@ def config_etrace(cpu_cls, cpu_list, options):
                                 instFetchTraceFile = options.inst_trace_file,
                                 dataDepTraceFile = options.data_trace_file,
                                 depWindowSize = 3 * cpu.numROBEntries)
+            if sync_order:
+                cpu.traceListener.syncOrder = sync_order
             # Make the number of entries in the ROB, LQ and SQ very
             # large so that there are no stalls due to resource
             # limitation as such stalls will get captured in the trace
@@ -137,6 +137,8 @@ def config_mem(options, system):
     opt_dram_powerdown = getattr(options, "enable_dram_powerdown", None)
     opt_mem_channels_intlv = getattr(options, "mem_channels_intlv", 128)
     opt_xor_low_bit = getattr(options, "xor_low_bit", 0)
+    opt_mem_eventqs = getattr(options, "mem_eventqs", 0)
+    opt_mem_eventq_latency = getattr(options, "mem_eventq_latency", "4ns")
 
     if opt_mem_type == "HMC_2500_1x32":
         HMChost = HMC.config_hmc_host_ctrl(options, system)
@@ -261,7 +263,12 @@ def config_mem(options, system):
     for i in range(len(nvm_intfs)):
         mem_ctrls[i].nvm = nvm_intfs[i];
 
+    if opt_mem_eventqs and opt_mem_type == "HMC_2500_1x32":
+        fatal("Memory channels on separate event queues are not "
+              "supported with HMC")
+
     # Connect the controller to the xbar port
+    mem_bridges = []
     for i in range(len(mem_ctrls)):
         if opt_mem_type == "HMC_2500_1x32":
             # Connect the controllers to the membus
@@ -269,8 +276,39 @@ def config_mem(options, system):
             # Set memory device size. There is an independent controller
             # for each vault. All vaults are same size.
             mem_ctrls[i].dram.device_size = options.hmc_dev_vault_size
+        elif opt_mem_eventqs:
+            # Simulate the channel, including its interfaces, on an
+            # event queue of its own, the first one being the one
+            # shared with the rest of the system. The bridge latency
+            # is the lookahead between the two, and the bridge buffers
+            # as many requests as the controller does.
+            eventq = 1 + i % opt_mem_eventqs
+            mem_ctrls[i].eventq_index = eventq
+
+            if isinstance(mem_ctrls[i], m5.objects.MemCtrl):
+                intfs = [intf for intf in (mem_ctrls[i].dram,
+                                           mem_ctrls[i].nvm)
+                         if isinstance(intf, m5.objects.MemInterface)]
+                ranges = [intf.range for intf in intfs]
+                queue_size = sum(intf.read_buffer_size.value +
+                                 intf.write_buffer_size.value
+                                 for intf in intfs)
+            else:
+                ranges = [mem_ctrls[i].range]
+                queue_size = 16
+
+            bridge = m5.objects.Bridge(delay = opt_mem_eventq_latency,
+                                       mem_side_eventq_index = eventq,
+                                       ranges = ranges,
+                                       req_size = queue_size,
+                                       resp_size = queue_size)
+            bridge.cpu_side_port = xbar.master
+            bridge.mem_side_port = mem_ctrls[i].port
+            mem_bridges.append(bridge)
         else:
             # Connect the controllers to the membus
             mem_ctrls[i].port = xbar.master
 
     subsystem.mem_ctrls = mem_ctrls
+    if mem_bridges:
+        subsystem.mem_bridges = mem_bridges
@@ -112,6 +112,14 @@ def addNoISAOptions(parser):
                        help="Enable low-power states in DRAMInterface")
     parser.add_option("--mem-channels-intlv", type="int", default=0,
                       help="Memory channels interleave")
+    parser.add_option("--mem-eventqs", type="int", default=0,
+                      help="Simulate the memory channels on this many "
+                      "event queues of their own, in parallel with the "
+                      "rest of the system")
+    parser.add_option("--mem-eventq-latency", type="string", default="4ns",
+                      help="Latency from the memory bus to a channel on "
+                      "its own event queue, also used as the simulation "
+                      "quantum")
 
 
     parser.add_option("--memchecker", action="store_true")
@@ -301,6 +309,11 @@ def addCommonOptions(parser):
     parser.add_option("--restore-simpoint-checkpoint", action="store_true",
         help="restore from a simpoint checkpoint taken with " +
              "--take-simpoint-checkpoints")
+    parser.add_option("--simpoint-jobs", action="store", type="int",
+        default=None,
+        help="Restore all simpoint checkpoints, running <N> of them in "
+             "parallel, and merge their weighted stats (use with "
+             "--restore-simpoint-checkpoint instead of -r)")
 
     # Checkpointing options
     ###Note that performing checkpointing via python script files will override
@@ -339,6 +352,19 @@ def addCommonOptions(parser):
     parser.add_option("-p", "--prog-interval", type="str",
         help="CPU Progress Interval")
 
+    # Sampled simulation
+    parser.add_option("--sample", action="store", type="string",
+        default=None,
+        help="<period,warmup,measurement> Sample the workload, simulating "
+             "<warmup> + <measurement> of every <period> instructions on "
+             "--cpu-type and the rest on an atomic CPU")
+    parser.add_option("--sample-error", action="store", type="float",
+        default=None,
+        help="Stop sampling once the relative CPI error is below this")
+    parser.add_option("--sample-confidence", action="store", type="float",
+        default=0.95,
+        help="Confidence level of the sampled CPI (default: 0.95)")
+
     # Fastforwarding and simpoint related materials
     parser.add_option("-W", "--warmup-insts", action="store", type="int",
         default=None,
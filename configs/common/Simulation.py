@@ -41,6 +41,8 @@ from __future__ import print_function
 from __future__ import absolute_import
 
 import six
+import os
+import re
 import sys
 from os import getcwd
 from os.path import join as joinpath
@@ -51,6 +53,7 @@ from common import ObjectList
 import m5
 from m5.defines import buildEnv
 from m5.objects import *
+from m5.sampling import Sampler
 from m5.util import *
 
 if six.PY3:
@@ -79,11 +82,11 @@ def setCPUClass(options):
             not options.caches and not options.ruby:
         fatal("%s must be used with caches" % options.cpu_type)
 
-    if options.checkpoint_restore != None:
+    if options.checkpoint_restore != None or options.simpoint_jobs:
         if options.restore_with_cpu != options.cpu_type:
             CPUClass = TmpClass
             TmpClass, test_mem_mode = getCPUClass(options.restore_with_cpu)
-    elif options.fast_forward:
+    elif options.fast_forward or options.sample:
         CPUClass = TmpClass
         TmpClass = AtomicSimpleCPU
         test_mem_mode = 'atomic'
@@ -118,6 +121,15 @@ def setWorkCountOptions(system, options):
     if options.work_cpus_checkpoint_count != None:
         system.work_cpus_ckpt_count = options.work_cpus_checkpoint_count
 
+# SimPoint checkpoint directories are named as follows by
+# takeSimpointCheckpoints()
+simpointCptRE = re.compile(r'cpt\.simpoint_(\d+)_inst_(\d+)' +
+    r'_weight_([\d\.e\-]+)_interval_(\d+)_warmup_(\d+)')
+
+def simpointCheckpoints(cptdir):
+    """Returns the sorted names of the SimPoint checkpoints in cptdir."""
+    return sorted(d for d in os.listdir(cptdir) if simpointCptRE.match(d))
+
 def findCptDir(options, cptdir, testsys):
     """Figures out the directory from which the checkpointed state is read.
 
@@ -153,22 +165,13 @@ def findCptDir(options, cptdir, testsys):
 
     elif options.restore_simpoint_checkpoint:
         # Restore from SimPoint checkpoints
-        # Assumes that the checkpoint dir names are formatted as follows:
-        dirs = listdir(cptdir)
-        expr = re.compile('cpt\.simpoint_(\d+)_inst_(\d+)' +
-                    '_weight_([\d\.e\-]+)_interval_(\d+)_warmup_(\d+)')
-        cpts = []
-        for dir in dirs:
-            match = expr.match(dir)
-            if match:
-                cpts.append(dir)
-        cpts.sort()
+        cpts = simpointCheckpoints(cptdir)
 
         cpt_num = options.checkpoint_restore
         if cpt_num > len(cpts):
             fatal('Checkpoint %d not found', cpt_num)
         checkpoint_dir = joinpath(cptdir, cpts[cpt_num - 1])
-        match = expr.match(cpts[cpt_num - 1])
+        match = simpointCptRE.match(cpts[cpt_num - 1])
         if match:
             index = int(match.group(1))
             start_inst = int(match.group(2))
@@ -411,6 +414,111 @@ def restoreSimpointCheckpoint():
     print('Exiting @ tick %i because %s' % (m5.curTick(), exit_cause))
     sys.exit(exit_event.getCode())
 
+def readLastStatsDump(filename):
+    """Returns the numeric stats of the last dump in a stats.txt file as an
+    ordered list of (name, value) pairs."""
+    values = []
+    with open(filename) as f:
+        for line in f:
+            if line.startswith('---------- Begin Simulation Statistics'):
+                values = []
+                continue
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            try:
+                values.append((fields[0], float(fields[1])))
+            except ValueError:
+                pass
+    return values
+
+def mergeSimpointStats(regions, filename):
+    """Write the weighted mean of the stats of all SimPoint regions.
+
+    regions is a list of (weight, stats.txt path) pairs.
+    """
+    total_weight = sum(weight for weight, _ in regions)
+    merged = {}
+    order = []
+    for weight, stats_file in regions:
+        for name, value in readLastStatsDump(stats_file):
+            if name not in merged:
+                merged[name] = 0.0
+                order.append(name)
+            merged[name] += value * weight / total_weight
+
+    with open(filename, 'w') as f:
+        print("# Weighted mean of %d SimPoint regions" % len(regions), file=f)
+        for weight, stats_file in regions:
+            print("# %f %s" % (weight, stats_file), file=f)
+        for name in order:
+            print("%-50s %.6f" % (name, merged[name]), file=f)
+
+def forkSimpointRegions(options, cptdir):
+    """Run every SimPoint checkpoint in cptdir in its own process.
+
+    The configuration is elaborated once. Each region is then run by a
+    forked child that restores its checkpoint into a private output
+    directory, with at most options.simpoint_jobs children running at a
+    time. In the children this function returns with
+    options.checkpoint_restore pointing at the region to run. The parent
+    waits for all regions, writes their weighted stats to
+    weighted_stats.txt and exits.
+    """
+    if not os.path.isdir(cptdir):
+        fatal("checkpoint dir %s does not exist!", cptdir)
+    cpts = simpointCheckpoints(cptdir)
+    if not cpts:
+        fatal("No SimPoint checkpoints found in %s", cptdir)
+    if options.simpoint_jobs < 1:
+        fatal("--simpoint-jobs must be at least 1")
+
+    outdir = m5.options.outdir
+    # Strip any URL scheme and options from the (text) stats file name
+    stats_file = re.sub(r'^\w+://|\?.*$', '', m5.options.stats_file)
+    running = {}
+    regions = []
+    failed = 0
+
+    def wait_region():
+        pid, status = os.wait()
+        cpt_num = running.pop(pid)
+        if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0:
+            print("SimPoint region %d (%s) failed with status %d" %
+                  (cpt_num, cpts[cpt_num - 1], status))
+            return 1
+        return 0
+
+    for cpt_num, cpt in enumerate(cpts, 1):
+        while len(running) >= options.simpoint_jobs:
+            failed += wait_region()
+
+        region_outdir = joinpath(outdir, "simpoint.%d" % cpt_num)
+        sys.stdout.flush()
+        pid = os.fork()
+        if pid == 0:
+            m5.options.outdir = region_outdir
+            m5.core.setOutputDir(region_outdir)
+            options.checkpoint_restore = cpt_num
+            return
+
+        print("Running SimPoint region %d from %s in %s (pid %d)" %
+              (cpt_num, cpt, region_outdir, pid))
+        running[pid] = cpt_num
+        weight = float(simpointCptRE.match(cpt).group(3))
+        regions.append((weight, joinpath(region_outdir, stats_file)))
+
+    while running:
+        failed += wait_region()
+
+    if failed:
+        fatal("%d of %d SimPoint regions failed", failed, len(cpts))
+
+    mergeSimpointStats(regions, joinpath(outdir, "weighted_stats.txt"))
+    print("Merged the stats of %d SimPoint regions into %s" %
+          (len(regions), joinpath(outdir, "weighted_stats.txt")))
+    sys.exit(0)
+
 def repeatSwitch(testsys, repeat_switch_cpu_list, maxtick, switch_freq):
     print("starting switch loop")
     while True:
@@ -431,6 +539,21 @@ def repeatSwitch(testsys, repeat_switch_cpu_list, maxtick, switch_freq):
             exit_event = m5.simulate(maxtick - m5.curTick())
             return exit_event
 
+def sampleSimulation(options, testsys, switch_cpu_list, maxtick):
+    try:
+        period, warmup, measurement = map(int, options.sample.split(','))
+    except ValueError:
+        fatal("--sample expects <period,warmup,measurement>")
+
+    sampler = Sampler(testsys, switch_cpu_list, period, warmup, measurement,
+                      confidence=options.sample_confidence,
+                      error_target=options.sample_error)
+
+    print("starting sampling loop")
+    exit_event = sampler.run(maxtick)
+    print("Sampled %s" % sampler.results)
+    return exit_event
+
 def run(options, root, testsys, cpu_class):
     if options.checkpoint_dir:
         cptdir = options.checkpoint_dir
@@ -451,6 +574,11 @@ def run(options, root, testsys, cpu_class):
     if options.repeat_switch and options.take_checkpoints:
         fatal("Can't specify both --repeat-switch and --take-checkpoints")
 
+    if options.sample and (options.fast_forward or options.standard_switch or
+                           options.repeat_switch or options.take_checkpoints):
+        fatal("Can't specify --sample with --fast-forward, --standard-switch, "
+              "--repeat-switch or --take-checkpoints")
+
     # Setup global stat filtering.
     stat_root_simobjs = []
     for stat_root_str in options.stats_root:
@@ -615,9 +743,27 @@ def run(options, root, testsys, cpu_class):
     if options.take_simpoint_checkpoints != None:
         simpoints, interval_length = parseSimpointAnalysisFile(options, testsys)
 
+    # Run all SimPoint regions in parallel. Only the forked child processes
+    # return here, each set up to restore a single region.
+    if options.simpoint_jobs:
+        if not options.restore_simpoint_checkpoint or \
+                options.checkpoint_restore != None:
+            fatal("--simpoint-jobs requires --restore-simpoint-checkpoint "
+                  "and no -r")
+        forkSimpointRegions(options, cptdir)
+
     checkpoint_dir = None
     if options.checkpoint_restore:
         cpt_starttick, checkpoint_dir = findCptDir(options, cptdir, testsys)
+    # The memory channels on their own event queues are kept in step
+    # with the rest of the system using the bridge latency as lookahead
+    if getattr(options, "mem_eventqs", 0):
+        inform("Simulating memory channels on %d event queues with a %s "
+               "simulation quantum", options.mem_eventqs,
+               options.mem_eventq_latency)
+        root.sim_quantum = m5.ticks.fromSeconds(
+            convert.anyToLatency(options.mem_eventq_latency))
+
     root.apply_config(options.param)
     m5.instantiate(checkpoint_dir)
 
@@ -663,7 +809,7 @@ def run(options, root, testsys, cpu_class):
         fatal("Bad maxtick (%d) specified: " \
               "Checkpoint starts starts from tick: %d", maxtick, cpt_starttick)
 
-    if options.standard_switch or cpu_class:
+    if (options.standard_switch or cpu_class) and not options.sample:
         if options.standard_switch:
             print("Switch at instruction count:%s" %
                     str(testsys.cpu[0].max_insts_any_thread))
@@ -727,7 +873,10 @@ def run(options, root, testsys, cpu_class):
 
         # If checkpoints are being taken, then the checkpoint instruction
         # will occur in the benchmark code it self.
-        if options.repeat_switch and maxtick > options.repeat_switch:
+        if options.sample:
+            exit_event = sampleSimulation(options, testsys, switch_cpu_list,
+                                          maxtick)
+        elif options.repeat_switch and maxtick > options.repeat_switch:
             exit_event = repeatSwitch(testsys, repeat_switch_cpu_list,
                                       maxtick, options.repeat_switch)
         else:
@@ -0,0 +1,160 @@
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from __future__ import print_function
+from __future__ import absolute_import
+
+import optparse
+import sys
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, convert
+
+addToPath('../')
+
+from common import ObjectList
+from common import MemConfig
+
+# this script is a host-performance microbenchmark for the memory
+# controller scheduler: a DramGen oversubscribes a single channel with
+# random traffic spread across all banks, so that the read and write
+# queues stay full, and the host time spent simulating a fixed amount
+# of time is reported alongside the achieved bandwidth
+
+parser = optparse.OptionParser()
+
+parser.add_option("--mem-type", type="choice", default="HBM_1000_4H_1x128",
+                  choices=ObjectList.mem_list.get_names(),
+                  help = "type of memory to use")
+
+parser.add_option("--mem-ranks", "-r", type="int", default=1,
+                  help = "Number of ranks to iterate across")
+
+parser.add_option("--queue-depth", type="int", default=256,
+                  help = "Size of the controller read and write buffers")
+
+parser.add_option("--mem-sched", type="choice", default="frfcfs",
+                  choices=["fcfs", "frfcfs"],
+                  help = "Memory controller scheduling policy")
+
+parser.add_option("--rd_perc", type="int", default=70,
+                  help = "Percentage of read commands")
+
+parser.add_option("--addr-map", type="choice",
+                  choices=ObjectList.dram_addr_map_list.get_names(),
+                  default="RoRaBaCoCh", help = "DRAM address map policy")
+
+parser.add_option("--duration", type="string", default="1ms",
+                  help = "Simulated time to run for")
+
+(options, args) = parser.parse_args()
+
+if args:
+    print("Error: script doesn't take any positional arguments")
+    sys.exit(1)
+
+system = System(membus = IOXBar(width = 32))
+system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                   voltage_domain =
+                                   VoltageDomain(voltage = '1V'))
+
+mem_range = AddrRange('256MB')
+system.mem_ranges = [mem_range]
+
+# do not worry about reserving space for the backing store
+system.mmap_using_noreserve = True
+
+# force a single channel to match the assumptions in the DRAM traffic
+# generator
+options.mem_channels = 1
+options.external_memory_system = 0
+options.tlm_memory = 0
+options.elastic_trace_en = 0
+MemConfig.config_mem(options, system)
+
+ctrl = system.mem_ctrls[0]
+
+# the following assumes that we are using the native DRAM
+# controller, check to be sure
+if not isinstance(ctrl, m5.objects.MemCtrl):
+    fatal("This script assumes the controller is a MemCtrl subclass")
+if not isinstance(ctrl.dram, m5.objects.DRAMInterface):
+    fatal("This script assumes the memory is a DRAMInterface subclass")
+
+ctrl.mem_sched_policy = options.mem_sched
+ctrl.read_buffer_size = options.queue_depth
+ctrl.write_buffer_size = options.queue_depth
+
+# there is no point slowing things down by saving any data
+ctrl.dram.null = True
+ctrl.dram.addr_mapping = options.addr_map
+
+nbr_banks = ctrl.dram.banks_per_rank.value
+
+burst_size = int((ctrl.dram.devices_per_rank.value *
+                  ctrl.dram.device_bus_width.value *
+                  ctrl.dram.burst_length.value) / 8)
+
+page_size = ctrl.dram.devices_per_rank.value * \
+    ctrl.dram.device_rowbuffer_size.value
+
+# issue requests at twice the peak bandwidth of the memory, so that
+# the controller queues fill up and stay full
+itt = getattr(ctrl.dram.tBURST_MIN, 'value',
+              ctrl.dram.tBURST.value) * 1000000000000 / 2
+
+system.tgen = PyTrafficGen()
+system.tgen.port = system.membus.slave
+system.system_port = system.membus.slave
+
+root = Root(full_system = False, system = system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+def trace():
+    addr_map = ObjectList.dram_addr_map_list.get(options.addr_map)
+    duration = int(m5.ticks.fromSeconds(
+        convert.anyToLatency(options.duration)))
+    yield system.tgen.createDram(duration,
+                                 0, mem_range.end, burst_size,
+                                 int(itt), int(itt),
+                                 options.rd_perc, 0,
+                                 1, page_size, nbr_banks, nbr_banks,
+                                 addr_map, options.mem_ranks)
+    yield system.tgen.createExit(0)
+
+system.tgen.start(trace())
+
+start = time.time()
+event = m5.simulate()
+host_seconds = time.time() - start
+
+print("Exiting @ tick %i because %s" % (m5.curTick(), event.getCause()))
+print("Scheduler %s, queue depth %d, %d banks: %.2f host seconds" %
+      (options.mem_sched, options.queue_depth, nbr_banks, host_seconds))
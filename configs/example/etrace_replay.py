@@ -70,15 +70,21 @@ if options.cpu_type != "TraceCPU":
     fatal("This is a script for elastic trace replay simulation, use "\
             "--cpu-type=TraceCPU\n");
 
-if options.num_cpus > 1:
-    fatal("This script does not support multi-processor trace replay.\n")
+# For multi-processor replay, the trace file options hold a comma-separated
+# list with one trace per CPU, in the order of the recorded CPUs.
+inst_trace_files = options.inst_trace_file.split(',')
+data_trace_files = options.data_trace_file.split(',')
+if len(inst_trace_files) != options.num_cpus or \
+   len(data_trace_files) != options.num_cpus:
+    fatal("Expected %d instruction and data trace files, one per CPU.\n" %
+          options.num_cpus)
 
 # In this case FutureClass will be None as there is not fast forwarding or
 # switching
 (CPUClass, test_mem_mode, FutureClass) = Simulation.setCPUClass(options)
 CPUClass.numThreads = numThreads
 
-system = System(cpu = CPUClass(cpu_id=0),
+system = System(cpu = [CPUClass(cpu_id=i) for i in range(options.num_cpus)],
                 mem_mode = test_mem_mode,
                 mem_ranges = [AddrRange(options.mem_size)],
                 cache_line_size = options.cacheline_size)
@@ -110,9 +116,18 @@ for cpu in system.cpu:
 for cpu in system.cpu:
     cpu.createThreads()
 
-# Assign input trace files to the Trace CPU
-system.cpu.instTraceFile=options.inst_trace_file
-system.cpu.dataTraceFile=options.data_trace_file
+# Assign input trace files to the Trace CPUs
+for (cpu, inst_trace, data_trace) in \
+        zip(system.cpu, inst_trace_files, data_trace_files):
+    cpu.instTraceFile = inst_trace
+    cpu.dataTraceFile = data_trace
+
+# Trace CPUs replaying a multi-core trace share the order of the recorded
+# synchronization points, e.g. atomics and barriers
+if options.num_cpus > 1:
+    system.trace_sync = TraceSync()
+    for cpu in system.cpu:
+        cpu.traceSync = system.trace_sync
 
 # Configure the classic memory system options
 MemClass = Simulation.setMemClass(options)
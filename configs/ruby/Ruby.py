@@ -65,6 +65,13 @@ def define_options(parser):
     parser.add_option("--access-backing-store", action="store_true", default=False,
                       help="Should ruby maintain a second copy of memory")
 
+    parser.add_option("--ruby-parallel-warmup", action="store_true",
+                      default=False,
+                      help="Replay the checkpointed cache contents on all "
+                           "sequencers concurrently when restoring. The "
+                           "replacement state of shared caches can differ "
+                           "from a sequential warmup")
+
     # Options related to cache structure
     parser.add_option("--ports", action="store", type="int", default=4,
                       help="used of transitions per cycle which is a proxy \
@@ -236,6 +243,8 @@ def create_system(options, full_system, system, piobus = None, dma_ports = [],
     ruby._cpu_ports = cpu_sequencers
     ruby.num_of_sequencers = len(cpu_sequencers)
 
+    ruby.parallel_warmup = options.ruby_parallel_warmup
+
     # Create a backing copy of physical memory in case required
     if options.access_backing_store:
         ruby.access_backing_store = True
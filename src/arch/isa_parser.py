@@ -297,11 +297,14 @@ class GenCode(object):
     # interwoven by the write_top_level_files().
     def emit(self):
         if self.header_output:
-            self.parser.get_file('header').write(self.header_output)
+            self.parser.get_file('header').write(
+                    self.parser.addDirectExecute(self.header_output, False))
         if self.decoder_output:
-            self.parser.get_file('decoder').write(self.decoder_output)
+            self.parser.get_file('decoder').write(
+                    self.parser.addDirectExecute(self.decoder_output, False))
         if self.exec_output:
-            self.parser.get_file('exec').write(self.exec_output)
+            self.parser.get_file('exec').write(
+                    self.parser.addDirectExecute(self.exec_output, True))
         if self.decode_block:
             self.parser.get_file('decode_block').write(self.decode_block)
 
@@ -1549,10 +1552,14 @@ class LineTracker(object):
 #
 
 class ISAParser(Grammar):
-    def __init__(self, output_dir):
+    def __init__(self, output_dir, direct_execute=False):
         super(ISAParser, self).__init__()
         self.output_dir = output_dir
 
+        # Also generate an executeDirect() method for the simple CPUs next
+        # to every execute() method (see addDirectExecute()).
+        self.direct_execute = direct_execute
+
         self.filename = None # for output file watermarking/scaremongering
 
         # variable to hold templates
@@ -1717,6 +1724,8 @@ class ISAParser(Grammar):
                 assert(fn in self.files)
                 f.write('#include "%s"\n' % fn)
                 f.write('#include "cpu/exec_context.hh"\n')
+                if self.direct_execute:
+                    f.write('#include "cpu/simple/exec_context.hh"\n')
                 f.write('#include "decoder.hh"\n')
 
                 fn = 'exec-ns.cc.inc'
@@ -2618,6 +2627,93 @@ StaticInstPtr
         if any.  Will match base_name attribute of Operand object.)'''
         return self.operandsWithExtRE.sub(r'\1', code)
 
+    # Matches the declaration or the start of the definition of an
+    # instruction's execute() method.
+    executeRE = re.compile(r'''
+        (?P<head>(?:template\s*<[^<>{};]*>\s*)?(?:virtual\s+)?Fault\s+
+                 (?:[\w<>, ]+::\s*)*)
+        execute\s*\(\s*ExecContext\s*\*\s*(?P<xc>\w*)\s*,
+        \s*Trace::InstRecord\s*\*\s*(?P<trace>\w*)\s*\)
+        \s*const(?P<spec>(?:\s+(?:override|final))*)\s*(?P<end>[;{])
+        ''', re.VERBOSE)
+
+    @staticmethod
+    def findClosingBrace(code, pos):
+        '''Find the brace that closes the one at code[pos], skipping over
+        comments and string and character literals.'''
+        depth = 0
+        i = pos
+        while i < len(code):
+            c = code[i]
+            if c == '{':
+                depth += 1
+            elif c == '}':
+                depth -= 1
+                if depth == 0:
+                    return i
+            elif c in '"\'':
+                i += 1
+                while i < len(code) and code[i] != c:
+                    if code[i] == '\\':
+                        i += 1
+                    i += 1
+                if i >= len(code):
+                    error('Unterminated literal in execute() method:\n%s' %
+                          code[pos:])
+            elif code.startswith('//', i):
+                i = code.find('\n', i)
+                if i < 0:
+                    break
+            elif code.startswith('/*', i):
+                i = code.find('*/', i + 2)
+                if i < 0:
+                    error('Unterminated comment in execute() method:\n%s' %
+                          code[pos:])
+                i += 1
+            i += 1
+        error('Unbalanced braces in execute() method:\n%s' % code[pos:])
+
+    def addDirectExecute(self, code, copy_body):
+        '''Add an executeDirect() method after every execute() method in
+        a chunk of generated code.
+
+        executeDirect() takes a SimpleExecContext instead of the generic
+        ExecContext. When copy_body is set, it gets a copy of the body of
+        execute(). Since SimpleExecContext is final and its accessors are
+        defined in its header, the compiler can then resolve and inline
+        the operand accesses, which otherwise are virtual calls. Without
+        copy_body, or for execute() methods defined in headers where
+        SimpleExecContext is incomplete, executeDirect() forwards to
+        execute().'''
+        if not self.direct_execute:
+            return code
+
+        out = []
+        last = 0
+        for m in self.executeRE.finditer(code):
+            if m.start() < last:
+                continue
+            xc = m.group('xc') or 'xc'
+            trace = m.group('trace') or 'traceData'
+            sig = '%sexecuteDirect(SimpleExecContext *%s, ' \
+                  'Trace::InstRecord *%s) const%s' % \
+                  (m.group('head'), xc, trace, m.group('spec'))
+            if m.group('end') == ';':
+                end = m.end()
+                direct = sig + ';'
+            else:
+                end = self.findClosingBrace(code, m.end() - 1) + 1
+                if copy_body:
+                    direct = sig + '\n' + code[m.end() - 1:end]
+                else:
+                    direct = sig + '\n{\n    return ' \
+                        '::StaticInst::executeDirect(%s, %s);\n}' % (xc, trace)
+            out.append(code[last:end])
+            out.append('\n\n' + direct)
+            last = end
+        out.append(code[last:])
+        return ''.join(out)
+
     def mungeSnippet(self, s):
         '''Fix up code snippets for final substitution in templates.'''
         if isinstance(s, str):
@@ -2721,4 +2817,5 @@ StaticInstPtr
 # Called as script: get args from command line.
 # Args are: <isa desc file> <output dir>
 if __name__ == '__main__':
-    ISAParser(sys.argv[2]).parse_isa_desc(sys.argv[1])
+    ISAParser(sys.argv[2], '--direct-execute' in sys.argv[3:]
+            ).parse_isa_desc(sys.argv[1])
@@ -41,6 +41,8 @@ class RiscvPagetableWalker(ClockedObject):
     system = Param.System(Parent.any, "system object")
     num_squash_per_cycle = Param.Unsigned(4,
             "Number of outstanding walks that can be squashed per cycle")
+    num_walk_slots = Param.Unsigned(1,
+            "Number of page table walks which can be in progress at once")
 
 class RiscvTLB(BaseTLB):
     type = 'RiscvTLB'
@@ -50,6 +50,7 @@
 
 #include "arch/riscv/pagetable_walker.hh"
 
+#include <algorithm>
 #include <memory>
 
 #include "arch/riscv/faults.hh"
@@ -69,12 +70,30 @@ Fault
 Walker::start(ThreadContext * _tc, BaseTLB::Translation *_translation,
               const RequestPtr &_req, BaseTLB::Mode _mode)
 {
-    // TODO: in timing mode, instead of blocking when there are other
-    // outstanding requests, see if this request can be coalesced with
-    // another one (i.e. either coalesce or start walk)
     WalkerState * newState = new WalkerState(this, _translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
-    if (currStates.size()) {
+    if (newState->isTiming()) {
+        // Wait for a walk of the same page rather than walking it again,
+        // as long as that walk updates the page table entries the way
+        // this one would. Only a write walk sets the dirty bit, so it
+        // covers reads and fetches, while the others only cover walks
+        // of their own kind.
+        const Addr vpn = _req->getVaddr() >> PageShift;
+        for (auto *walkerState : currStates) {
+            if (walkerState->tc == _tc &&
+                    walkerState->req->getVaddr() >> PageShift == vpn &&
+                    (walkerState->mode == _mode ||
+                     walkerState->mode == BaseTLB::Write)) {
+                DPRINTF(PageTableWalker, "Coalescing walk for %#x\n",
+                        _req->getVaddr());
+                walkerState->coalesced.push_back(newState);
+                stats.coalescedWalks++;
+                return NoFault;
+            }
+        }
+    }
+    if (currStates.size() > numStartedWalks() ||
+            numStartedWalks() >= numWalkSlots) {
         assert(newState->isTiming());
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
         currStates.push_back(newState);
@@ -121,9 +140,10 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
+        finishCoalesced(senderWalk);
         delete senderWalk;
-        // Since we block requests when another is outstanding, we
-        // need to check if there is a waiting request to be serviced
+        // Since we limit the number of walks in progress, we need to
+        // check if there is a waiting request to be serviced
         if (currStates.size() && !startWalkWrapperEvent.scheduled())
             // delay sending any new requests until we are finished
             // with the responses
@@ -191,41 +211,79 @@ Walker::WalkerState::initState(ThreadContext * _tc,
     assert(satp.mode == AddrXlateMode::SV39);
 }
 
+unsigned
+Walker::numStartedWalks() const
+{
+    return std::count_if(currStates.begin(), currStates.end(),
+        [](const WalkerState *state) { return state->started; });
+}
+
+void
+Walker::finishCoalesced(WalkerState *state)
+{
+    for (WalkerState *waiting : state->coalesced) {
+        if (waiting->translation->squashed()) {
+            waiting->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                waiting->req, waiting->tc, waiting->mode);
+        } else {
+            bool delayedResponse;
+            Fault fault = tlb->translate(waiting->req, waiting->tc,
+                    waiting->translation, waiting->mode, delayedResponse);
+            if (!delayedResponse) {
+                waiting->translation->finish(fault, waiting->req,
+                                             waiting->tc, waiting->mode);
+            }
+        }
+        delete waiting;
+    }
+    state->coalesced.clear();
+}
+
 void
 Walker::startWalkWrapper()
 {
     unsigned num_squashed = 0;
-    WalkerState *currState = currStates.front();
-    while ((num_squashed < numSquashable) && currState &&
-        currState->translation->squashed()) {
-        currStates.pop_front();
-        num_squashed++;
-
-        DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
-            currState->req->getVaddr());
-
-        // finish the translation which will delete the translation object
-        currState->translation->finish(
-            std::make_shared<UnimpFault>("Squashed Inst"),
-            currState->req, currState->tc, currState->mode);
-
-        // delete the current request if there are no inflight packets.
-        // if there is something in flight, delete when the packets are
-        // received and inflight is zero.
-        if (currState->numInflight() == 0) {
-            delete currState;
-        } else {
-            currState->squash();
+    unsigned num_started = numStartedWalks();
+    auto iter = currStates.begin();
+    while (iter != currStates.end() && num_started < numWalkSlots) {
+        WalkerState *currState = *iter;
+        if (currState->wasStarted()) {
+            ++iter;
+            continue;
+        }
+
+        if (num_squashed < numSquashable &&
+                currState->translation->squashed()) {
+            num_squashed++;
+
+            DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
+                currState->req->getVaddr());
+
+            // The walks waiting for this one take its place in the queue.
+            currStates.splice(std::next(iter), currState->coalesced);
+            iter = currStates.erase(iter);
+
+            // finish the translation which will delete the translation object
+            currState->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                currState->req, currState->tc, currState->mode);
+
+            // delete the current request if there are no inflight packets.
+            // if there is something in flight, delete when the packets are
+            // received and inflight is zero.
+            if (currState->numInflight() == 0) {
+                delete currState;
+            } else {
+                currState->squash();
+            }
+            continue;
         }
 
-        // check the next translation request, if it exists
-        if (currStates.size())
-            currState = currStates.front();
-        else
-            currState = NULL;
-    }
-    if (currState && !currState->wasStarted())
         currState->startWalk();
+        num_started++;
+        ++iter;
+    }
 }
 
 Fault
@@ -578,6 +636,13 @@ Walker::WalkerState::pageFault(bool present)
     return walker->tlb->createPagefault(entry.vaddr, mode);
 }
 
+Walker::WalkerStats::WalkerStats(Stats::Group *parent)
+  : Stats::Group(parent),
+    ADD_STAT(coalescedWalks,
+             "Misses which waited for a walk of the same page")
+{
+}
+
 } /* end namespace RiscvISA */
 
 RiscvISA::Walker *
@@ -43,11 +43,13 @@
 
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/tlb.hh"
+#include "base/logging.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/RiscvPagetableWalker.hh"
 #include "sim/clocked_object.hh"
 #include "sim/faults.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 class ThreadContext;
@@ -108,6 +110,8 @@ namespace RiscvISA
             bool retrying;
             bool started;
             bool squashed;
+            // Walks of the same page which wait for this one to finish.
+            std::list<WalkerState *> coalesced;
           public:
             WalkerState(Walker * _walker, BaseTLB::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -146,6 +150,13 @@ namespace RiscvISA
         // State for functional accesses (only need one of these per walker)
         WalkerState funcState;
 
+        struct WalkerStats : public Stats::Group
+        {
+            WalkerStats(Stats::Group *parent);
+
+            Stats::Scalar coalescedWalks;
+        } stats;
+
         struct WalkerSenderState : public Packet::SenderState
         {
             WalkerState * senderWalk;
@@ -171,6 +182,18 @@ namespace RiscvISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // The number of walks which can be in progress at once.
+        unsigned numWalkSlots;
+
+        unsigned numStartedWalks() const;
+
+        /**
+         * Finish the translations which waited for a walk of their page,
+         * now that the walk filled the TLB. Ones whose walk faulted look
+         * the TLB up, miss and walk again on their own.
+         */
+        void finishCoalesced(WalkerState *state);
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -201,11 +224,14 @@ namespace RiscvISA
 
         Walker(const Params *params) :
             ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params->system),
-            requestorId(sys->getRequestorId(this)),
+            funcState(this, NULL, NULL, true), stats(this), tlb(NULL),
+            sys(params->system), requestorId(sys->getRequestorId(this)),
             numSquashable(params->num_squash_per_cycle),
+            numWalkSlots(params->num_walk_slots),
             startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
         {
+            fatal_if(!numWalkSlots, "%s needs at least one walk slot.\n",
+                     name());
         }
     };
 }
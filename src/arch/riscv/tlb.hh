@@ -53,6 +53,8 @@ class Walker;
 
 class TLB : public BaseTLB
   {
+    friend class Walker;
+
     typedef std::list<TlbEntry *> EntryList;
 
   protected:
@@ -47,12 +47,39 @@ class X86PagetableWalker(ClockedObject):
     system = Param.System(Parent.any, "system object")
     num_squash_per_cycle = Param.Unsigned(4,
             "Number of outstanding walks that can be squashed per cycle")
+    num_walk_slots = Param.Unsigned(1,
+            "Number of page table walks which can be in progress at once")
+    # Paging structure caches which let long mode walks skip levels
+    pml4_cache_size = Param.Unsigned(0,
+            "Number of PML4 entries cached by the walker, 0 to disable")
+    pdp_cache_size = Param.Unsigned(0,
+            "Number of PDP entries cached by the walker, 0 to disable")
+    pde_cache_size = Param.Unsigned(0,
+            "Number of PD entries cached by the walker, 0 to disable")
 
 class X86TLB(BaseTLB):
     type = 'X86TLB'
     cxx_class = 'X86ISA::TLB'
     cxx_header = 'arch/x86/tlb.hh'
-    size = Param.Unsigned(64, "TLB size")
+    # By default a single fully associative L1 holds all page sizes
+    size = Param.Unsigned(64, "Number of L1 entries for 4KB pages")
+    assoc = Param.Unsigned(0,
+            "Associativity of the L1 for 4KB pages, 0 for fully associative")
+    size_2m = Param.Unsigned(0,
+            "Number of L1 entries for 2MB pages, 0 to share the 4KB L1")
+    assoc_2m = Param.Unsigned(0,
+            "Associativity of the L1 for 2MB pages, 0 for fully associative")
+    size_1g = Param.Unsigned(0,
+            "Number of L1 entries for 1GB pages, 0 to share the 4KB L1")
+    assoc_1g = Param.Unsigned(0,
+            "Associativity of the L1 for 1GB pages, 0 for fully associative")
+    l2_size = Param.Unsigned(0,
+            "Number of entries of the L2 shared by all page sizes, "
+            "0 to disable")
+    l2_assoc = Param.Unsigned(0,
+            "Associativity of the L2, 0 for fully associative")
+    l2_hit_latency = Param.Cycles(7,
+            "Extra latency of a timing translation which hits in the L2")
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(\
             X86PagetableWalker(), "page table walker")
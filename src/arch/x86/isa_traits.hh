@@ -46,6 +46,10 @@ namespace X86ISA
 
     const Addr PageShift = 12;
     const Addr PageBytes = ULL(1) << PageShift;
+
+    // The 2MB and 1GB pages mapped by PDEs and PDPEs in long mode.
+    const Addr LargePageShift = 21;
+    const Addr HugePageShift = 30;
 }
 
 #endif // __ARCH_X86_ISATRAITS_HH__
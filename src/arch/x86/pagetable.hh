@@ -46,20 +46,12 @@
 #include "arch/x86/isa_traits.hh"
 #include "base/bitunion.hh"
 #include "base/types.hh"
-#include "base/trie.hh"
 #include "debug/MMU.hh"
 #include "mem/port_proxy.hh"
 
 class Checkpoint;
 class ThreadContext;
 
-namespace X86ISA
-{
-    struct TlbEntry;
-}
-
-typedef Trie<Addr, X86ISA::TlbEntry> TlbEntryTrie;
-
 namespace X86ISA
 {
     struct TlbEntry : public Serializable
@@ -91,8 +83,6 @@ namespace X86ISA
         // A sequence number to keep track of LRU.
         uint64_t lruSeq;
 
-        TlbEntryTrie::Handle trieHandle;
-
         TlbEntry(Addr asn, Addr _vaddr, Addr _paddr,
                  bool uncacheable, bool read_only);
         TlbEntry();
@@ -151,6 +141,20 @@ namespace X86ISA
         Bitfield<0> p;
     EndBitUnion(PageTableEntry)
 
+    /**
+     * The physical base of the large page mapped by a long mode PD or
+     * PDP entry with PS set. Bit 12 of such an entry is the PAT bit,
+     * so only the bits from the page size up to bit 51 are the address.
+     *
+     * @param pte The PD or PDP entry.
+     * @param log_bytes The page size, LargePageShift or HugePageShift.
+     */
+    inline Addr
+    largePageBase(PageTableEntry pte, unsigned log_bytes)
+    {
+        return (uint64_t)pte & (mask(52 - log_bytes) << log_bytes);
+    }
+
     template <int first, int last>
     class LongModePTE
     {
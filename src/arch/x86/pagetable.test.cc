@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "arch/x86/isa_traits.hh"
+#include "arch/x86/pagetable.hh"
+
+using namespace X86ISA;
+
+/** A 2MB page takes its base from bits 51 to 21 of a PD entry. */
+TEST(X86PageTableTest, LargePageBase)
+{
+    PageTableEntry pte = 0;
+    pte.p = 1;
+    pte.w = 1;
+    pte.ps = 1;
+    pte.g = 1;
+    pte.nx = 1;
+    pte.base = 0x123456000 >> PageShift;
+    // The PAT bit and the ignored bits below the page size
+    pte = (uint64_t)pte | (1ULL << 12) | (1ULL << 20);
+
+    EXPECT_EQ(largePageBase(pte, LargePageShift), 0x123400000);
+}
+
+/** A 1GB page takes its base from bits 51 to 30 of a PDP entry. */
+TEST(X86PageTableTest, HugePageBase)
+{
+    PageTableEntry pte = 0;
+    pte.p = 1;
+    pte.ps = 1;
+    pte.nx = 1;
+    pte.base = 0xfedcba9876543000ULL >> PageShift;
+    pte = (uint64_t)pte | (1ULL << 12) | (1ULL << 29);
+
+    EXPECT_EQ(largePageBase(pte, HugePageShift), 0x000cba9840000000ULL);
+}
+
+/** The highest address a PDP entry can map. */
+TEST(X86PageTableTest, HugePageBaseTop)
+{
+    PageTableEntry pte = mask(64);
+
+    EXPECT_EQ(largePageBase(pte, HugePageShift), mask(52) & ~mask(30));
+    EXPECT_EQ(largePageBase(pte, LargePageShift), mask(52) & ~mask(21));
+}
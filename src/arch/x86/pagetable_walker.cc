@@ -49,13 +49,13 @@
 
 #include "arch/x86/pagetable_walker.hh"
 
+#include <algorithm>
 #include <memory>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
 #include "base/bitfield.hh"
-#include "base/trie.hh"
 #include "cpu/base.hh"
 #include "cpu/thread_context.hh"
 #include "debug/PageTableWalker.hh"
@@ -68,12 +68,30 @@ Fault
 Walker::start(ThreadContext * _tc, BaseTLB::Translation *_translation,
               const RequestPtr &_req, BaseTLB::Mode _mode)
 {
-    // TODO: in timing mode, instead of blocking when there are other
-    // outstanding requests, see if this request can be coalesced with
-    // another one (i.e. either coalesce or start walk)
     WalkerState * newState = new WalkerState(this, _translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
-    if (currStates.size()) {
+    if (newState->isTiming()) {
+        // Wait for a walk of the same page rather than walking it again,
+        // as long as that walk updates the page table entries the way
+        // this one would. Only a write walk sets the dirty bit, so it
+        // covers reads and fetches, while the others only cover walks
+        // of their own kind.
+        const Addr vpn = _req->getVaddr() >> PageShift;
+        for (auto *walkerState : currStates) {
+            if (walkerState->tc == _tc &&
+                    walkerState->req->getVaddr() >> PageShift == vpn &&
+                    (walkerState->mode == _mode ||
+                     walkerState->mode == BaseTLB::Write)) {
+                DPRINTF(PageTableWalker, "Coalescing walk for %#x\n",
+                        _req->getVaddr());
+                walkerState->coalesced.push_back(newState);
+                stats.coalescedWalks++;
+                return NoFault;
+            }
+        }
+    }
+    if (currStates.size() > numStartedWalks() ||
+            numStartedWalks() >= numWalkSlots) {
         assert(newState->isTiming());
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
         currStates.push_back(newState);
@@ -120,9 +138,10 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
+        finishCoalesced(senderWalk);
         delete senderWalk;
-        // Since we block requests when another is outstanding, we
-        // need to check if there is a waiting request to be serviced
+        // Since we limit the number of walks in progress, we need to
+        // check if there is a waiting request to be serviced
         if (currStates.size() && !startWalkWrapperEvent.scheduled())
             // delay sending any new requests until we are finished
             // with the responses
@@ -185,41 +204,83 @@ Walker::WalkerState::initState(ThreadContext * _tc,
     timing = _isTiming;
 }
 
+unsigned
+Walker::numStartedWalks() const
+{
+    return std::count_if(currStates.begin(), currStates.end(),
+        [](const WalkerState *state) { return state->started; });
+}
+
+void
+Walker::finishCoalesced(WalkerState *state)
+{
+    for (WalkerState *waiting : state->coalesced) {
+        if (waiting->translation->squashed()) {
+            waiting->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                waiting->req, waiting->tc, waiting->mode);
+        } else {
+            // The walk has already been paid for, so the latency of the
+            // TLB hit is not charged again.
+            bool delayedResponse;
+            Cycles latency;
+            Fault fault = tlb->translate(waiting->req, waiting->tc,
+                    waiting->translation, waiting->mode,
+                    delayedResponse, true, latency);
+            if (!delayedResponse) {
+                waiting->translation->finish(fault, waiting->req,
+                                             waiting->tc, waiting->mode);
+            }
+        }
+        delete waiting;
+    }
+    state->coalesced.clear();
+}
+
 void
 Walker::startWalkWrapper()
 {
     unsigned num_squashed = 0;
-    WalkerState *currState = currStates.front();
-    while ((num_squashed < numSquashable) && currState &&
-        currState->translation->squashed()) {
-        currStates.pop_front();
-        num_squashed++;
-
-        DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
-            currState->req->getVaddr());
-
-        // finish the translation which will delete the translation object
-        currState->translation->finish(
-            std::make_shared<UnimpFault>("Squashed Inst"),
-            currState->req, currState->tc, currState->mode);
-
-        // delete the current request if there are no inflight packets.
-        // if there is something in flight, delete when the packets are
-        // received and inflight is zero.
-        if (currState->numInflight() == 0) {
-            delete currState;
-        } else {
-            currState->squash();
+    unsigned num_started = numStartedWalks();
+    auto iter = currStates.begin();
+    while (iter != currStates.end() && num_started < numWalkSlots) {
+        WalkerState *currState = *iter;
+        if (currState->wasStarted()) {
+            ++iter;
+            continue;
+        }
+
+        if (num_squashed < numSquashable &&
+                currState->translation->squashed()) {
+            num_squashed++;
+
+            DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
+                currState->req->getVaddr());
+
+            // The walks waiting for this one take its place in the queue.
+            currStates.splice(std::next(iter), currState->coalesced);
+            iter = currStates.erase(iter);
+
+            // finish the translation which will delete the translation object
+            currState->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                currState->req, currState->tc, currState->mode);
+
+            // delete the current request if there are no inflight packets.
+            // if there is something in flight, delete when the packets are
+            // received and inflight is zero.
+            if (currState->numInflight() == 0) {
+                delete currState;
+            } else {
+                currState->squash();
+            }
+            continue;
         }
 
-        // check the next translation request, if it exists
-        if (currStates.size())
-            currState = currStates.front();
-        else
-            currState = NULL;
-    }
-    if (currState && !currState->wasStarted())
         currState->startWalk();
+        num_started++;
+        ++iter;
+    }
 }
 
 Fault
@@ -228,6 +289,7 @@ Walker::WalkerState::startWalk()
     Fault fault = NoFault;
     assert(!started);
     started = true;
+    walker->stats.walks++;
     setupWalk(req->getVaddr());
     if (timing) {
         nextState = state;
@@ -308,6 +370,9 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         entry.noExec = pte.nx;
+        upperNX = pte.nx;
+        cacheTable(walker->pml4Cache, (uint64_t)pte & (mask(40) << 12),
+                   uncacheable);
         nextState = LongPDP;
         break;
       case LongPDP:
@@ -323,6 +388,21 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             fault = pageFault(pte.p);
             break;
         }
+        if (pte.ps) {
+            // 1 GB page
+            entry.logBytes = HugePageShift;
+            entry.paddr = largePageBase(pte, HugePageShift);
+            entry.uncacheable = uncacheable;
+            entry.global = pte.g;
+            entry.patBit = bits(pte, 12);
+            entry.vaddr = entry.vaddr & ~mask(HugePageShift);
+            doTLBInsert = true;
+            doEndWalk = true;
+            break;
+        }
+        upperNX = upperNX || pte.nx;
+        cacheTable(walker->pdpCache, (uint64_t)pte & (mask(40) << 12),
+                   uncacheable);
         nextState = LongPD;
         break;
       case LongPD:
@@ -342,12 +422,15 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             entry.logBytes = 12;
             nextRead =
                 ((uint64_t)pte & (mask(40) << 12)) + vaddr.longl1 * dataSize;
+            upperNX = upperNX || pte.nx;
+            cacheTable(walker->pdeCache, (uint64_t)pte & (mask(40) << 12),
+                       uncacheable);
             nextState = LongPTE;
             break;
         } else {
             // 2 MB page
-            entry.logBytes = 21;
-            entry.paddr = (uint64_t)pte & (mask(31) << 21);
+            entry.logBytes = LargePageShift;
+            entry.paddr = largePageBase(pte, LargePageShift);
             entry.uncacheable = uncacheable;
             entry.global = pte.g;
             entry.patBit = bits(pte, 12);
@@ -407,8 +490,8 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         } else {
             // 2 MB page
-            entry.logBytes = 21;
-            entry.paddr = (uint64_t)pte & (mask(31) << 21);
+            entry.logBytes = LargePageShift;
+            entry.paddr = largePageBase(pte, LargePageShift);
             entry.uncacheable = uncacheable;
             entry.global = pte.g;
             entry.patBit = bits(pte, 12);
@@ -544,6 +627,16 @@ Walker::WalkerState::endWalk()
     read = NULL;
 }
 
+void
+Walker::WalkerState::cacheTable(WalkCache &cache, Addr table,
+                                bool uncacheable)
+{
+    if (functional || upperNX)
+        return;
+    cache.insert(entry.vaddr,
+                 { 0, table, uncacheable, entry.writable, entry.user, 0 });
+}
+
 void
 Walker::WalkerState::setupWalk(Addr vaddr)
 {
@@ -553,11 +646,39 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Efer efer = tc->readMiscRegNoEffect(MISCREG_EFER);
     dataSize = 8;
     Addr topAddr;
+    bool uncacheable = cr3.pcd;
     if (efer.lma) {
         // Do long mode.
         state = LongPML4;
         topAddr = (cr3.longPdtb << 12) + addr.longl4 * dataSize;
         enableNX = efer.nxe;
+        upperNX = false;
+        entry.noExec = false;
+
+        // Start the walk at the lowest table the paging structure caches
+        // know of. Functional walks always read the page table.
+        const WalkCache::Entry *cached = nullptr;
+        if (!functional) {
+            if ((cached = walker->pdeCache.lookup(vaddr))) {
+                walker->stats.pdeCacheHits++;
+                state = LongPTE;
+                topAddr = cached->table + addr.longl1 * dataSize;
+                entry.logBytes = 12;
+            } else if ((cached = walker->pdpCache.lookup(vaddr))) {
+                walker->stats.pdpCacheHits++;
+                state = LongPD;
+                topAddr = cached->table + addr.longl2 * dataSize;
+            } else if ((cached = walker->pml4Cache.lookup(vaddr))) {
+                walker->stats.pml4CacheHits++;
+                state = LongPDP;
+                topAddr = cached->table + addr.longl3 * dataSize;
+            }
+        }
+        if (cached) {
+            uncacheable = cached->uncacheable;
+            entry.writable = cached->writable;
+            entry.user = cached->user;
+        }
     } else {
         // We're in some flavor of legacy mode.
         CR4 cr4 = tc->readMiscRegNoEffect(MISCREG_CR4);
@@ -584,7 +705,7 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     entry.vaddr = vaddr;
 
     Request::Flags flags = Request::PHYSICAL;
-    if (cr3.pcd)
+    if (uncacheable)
         flags.set(Request::UNCACHEABLE);
 
     RequestPtr request = std::make_shared<Request>(
@@ -639,8 +760,10 @@ Walker::WalkerState::recvPacket(PacketPtr pkt)
              * well.
              */
             bool delayedResponse;
+            Cycles latency;
             Fault fault = walker->tlb->translate(req, tc, NULL, mode,
-                                                 delayedResponse, true);
+                                                 delayedResponse, true,
+                                                 latency);
             assert(!delayedResponse);
             // Let the CPU continue.
             translation->finish(fault, req, tc, mode);
@@ -735,6 +858,58 @@ Walker::WalkerState::pageFault(bool present)
                                        m5reg.cpl == 3, false);
 }
 
+Walker::WalkCache::WalkCache(unsigned _size, unsigned _shift)
+    : size(_size), shift(_shift), lruSeq(0)
+{
+    entries.reserve(size);
+}
+
+const Walker::WalkCache::Entry *
+Walker::WalkCache::lookup(Addr vaddr)
+{
+    for (auto &entry : entries) {
+        if (entry.tag == tag(vaddr)) {
+            entry.lruSeq = ++lruSeq;
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void
+Walker::WalkCache::insert(Addr vaddr, const Entry &entry)
+{
+    if (!size)
+        return;
+
+    auto slot = std::find_if(entries.begin(), entries.end(),
+        [this, vaddr](const Entry &e) { return e.tag == tag(vaddr); });
+    if (slot == entries.end()) {
+        if (entries.size() < size) {
+            slot = entries.insert(entries.end(), entry);
+        } else {
+            slot = std::min_element(entries.begin(), entries.end(),
+                [](const Entry &a, const Entry &b) {
+                    return a.lruSeq < b.lruSeq;
+                });
+        }
+    }
+    *slot = entry;
+    slot->tag = tag(vaddr);
+    slot->lruSeq = ++lruSeq;
+}
+
+Walker::WalkerStats::WalkerStats(Stats::Group *parent)
+  : Stats::Group(parent),
+    ADD_STAT(walks, "Number of page table walks"),
+    ADD_STAT(coalescedWalks,
+             "Misses which waited for a walk of the same page"),
+    ADD_STAT(pml4CacheHits, "Walks which started below a cached PML4 entry"),
+    ADD_STAT(pdpCacheHits, "Walks which started below a cached PDP entry"),
+    ADD_STAT(pdeCacheHits, "Walks which started below a cached PD entry")
+{
+}
+
 /* end namespace X86ISA */ }
 
 X86ISA::Walker *
@@ -42,11 +42,14 @@
 
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "base/bitfield.hh"
+#include "base/logging.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
 #include "sim/clocked_object.hh"
 #include "sim/faults.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 class ThreadContext;
@@ -74,6 +77,46 @@ namespace X86ISA
         friend class WalkerPort;
         WalkerPort port;
 
+        /**
+         * A fully associative paging structure cache. It maps the upper
+         * bits of a virtual address to the table the walk reads next, and
+         * the permissions accumulated on the way to it, so that walks can
+         * skip the levels above that table. Paths with NX set above the
+         * table aren't cached, so that fetches still fault on them.
+         */
+        class WalkCache
+        {
+          public:
+            struct Entry
+            {
+                Addr tag;
+                // The physical address of the next table.
+                Addr table;
+                bool uncacheable;
+                bool writable;
+                bool user;
+                uint64_t lruSeq;
+            };
+
+            /**
+             * @param size The number of entries, 0 disables the cache.
+             * @param shift The lowest virtual address bit of the tag.
+             */
+            WalkCache(unsigned size, unsigned shift);
+
+            const Entry *lookup(Addr vaddr);
+            void insert(Addr vaddr, const Entry &entry);
+            void flush() { entries.clear(); }
+
+          protected:
+            const unsigned size;
+            const unsigned shift;
+            std::vector<Entry> entries;
+            uint64_t lruSeq;
+
+            Addr tag(Addr vaddr) const { return bits(vaddr, 47, shift); }
+        };
+
         // State to track each walk of the page table
         class WalkerState
         {
@@ -98,6 +141,8 @@ namespace X86ISA
             State nextState;
             int dataSize;
             bool enableNX;
+            // Whether any of the long mode entries read so far had NX set.
+            bool upperNX;
             unsigned inflight;
             TlbEntry entry;
             PacketPtr read;
@@ -110,6 +155,8 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            // Walks of the same page which wait for this one to finish.
+            std::list<WalkerState *> coalesced;
           public:
             WalkerState(Walker * _walker, BaseTLB::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -135,6 +182,7 @@ namespace X86ISA
 
           private:
             void setupWalk(Addr vaddr);
+            void cacheTable(WalkCache &cache, Addr table, bool uncacheable);
             Fault stepWalk(PacketPtr &write);
             void sendPackets();
             void endWalk();
@@ -148,6 +196,22 @@ namespace X86ISA
         // State for functional accesses (only need one of these per walker)
         WalkerState funcState;
 
+        // Caches of PML4, PDP and PD entries for long mode walks.
+        WalkCache pml4Cache;
+        WalkCache pdpCache;
+        WalkCache pdeCache;
+
+        struct WalkerStats : public Stats::Group
+        {
+            WalkerStats(Stats::Group *parent);
+
+            Stats::Scalar walks;
+            Stats::Scalar coalescedWalks;
+            Stats::Scalar pml4CacheHits;
+            Stats::Scalar pdpCacheHits;
+            Stats::Scalar pdeCacheHits;
+        } stats;
+
         struct WalkerSenderState : public Packet::SenderState
         {
             WalkerState * senderWalk;
@@ -164,6 +228,15 @@ namespace X86ISA
         Port &getPort(const std::string &if_name,
                       PortID idx=InvalidPortID) override;
 
+        /** Invalidate the paging structure caches. */
+        void
+        flushWalkCaches()
+        {
+            pml4Cache.flush();
+            pdpCache.flush();
+            pdeCache.flush();
+        }
+
       protected:
         // The TLB we're supposed to load.
         TLB * tlb;
@@ -173,6 +246,18 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // The number of walks which can be in progress at once.
+        unsigned numWalkSlots;
+
+        unsigned numStartedWalks() const;
+
+        /**
+         * Finish the translations which waited for a walk of their page,
+         * now that the walk filled the TLB. Ones whose walk faulted look
+         * the TLB up, miss and walk again on their own.
+         */
+        void finishCoalesced(WalkerState *state);
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -203,11 +288,18 @@ namespace X86ISA
 
         Walker(const Params *params) :
             ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params->system),
+            funcState(this, NULL, NULL, true),
+            pml4Cache(params->pml4_cache_size, 39),
+            pdpCache(params->pdp_cache_size, 30),
+            pdeCache(params->pde_cache_size, 21),
+            stats(this), tlb(NULL), sys(params->system),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params->num_squash_per_cycle),
+            numWalkSlots(params->num_walk_slots),
             startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
         {
+            fatal_if(!numWalkSlots, "%s needs at least one walk slot.\n",
+                     name());
         }
     };
 }
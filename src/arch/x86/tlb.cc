@@ -46,6 +46,7 @@
 #include "arch/x86/pseudo_inst_abi.hh"
 #include "arch/x86/regs/misc.hh"
 #include "arch/x86/regs/msr.hh"
+#include "arch/x86/tlb_array_impl.hh"
 #include "arch/x86/x86_traits.hh"
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
@@ -59,70 +60,96 @@
 
 namespace X86ISA {
 
-TLB::TLB(const Params *p)
-    : BaseTLB(p), configAddress(0), size(p->size),
-      tlb(size), lruSeq(0), m5opRange(p->system->m5opRange()), stats(this)
+namespace
 {
-    if (!size)
-        fatal("TLBs must have a non-zero size.\n");
 
-    for (int x = 0; x < size; x++) {
-        tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
+// The page sizes held by the L1 for 4KB pages, which also holds the large
+// pages that have no L1 of their own.
+std::vector<unsigned>
+l1PageSizes(const X86TLBParams *p)
+{
+    std::vector<unsigned> log_bytes = { PageShift };
+    if (!p->size_2m)
+        log_bytes.push_back(LargePageShift);
+    if (!p->size_1g)
+        log_bytes.push_back(HugePageShift);
+    return log_bytes;
+}
+
+} // anonymous namespace
+
+TLB::TLB(const Params *p)
+    : BaseTLB(p), configAddress(0),
+      l1Tlb4K(p->size, p->assoc, l1PageSizes(p)),
+      l2HitLatency(p->l2_hit_latency),
+      m5opRange(p->system->m5opRange()), stats(this)
+{
+    l1Tlbs.push_back(&l1Tlb4K);
+    if (p->size_2m) {
+        l1Tlb2M.reset(new EntryArray(p->size_2m, p->assoc_2m,
+                                     { LargePageShift }));
+        l1Tlbs.push_back(l1Tlb2M.get());
+    }
+    if (p->size_1g) {
+        l1Tlb1G.reset(new EntryArray(p->size_1g, p->assoc_1g,
+                                     { HugePageShift }));
+        l1Tlbs.push_back(l1Tlb1G.get());
+    }
+    if (p->l2_size) {
+        l2Tlb.reset(new EntryArray(p->l2_size, p->l2_assoc,
+                { PageShift, LargePageShift, HugePageShift }));
     }
 
     walker = p->walker;
     walker->setTLB(this);
 }
 
-void
-TLB::evictLRU()
+TLB::EntryArray &
+TLB::l1Tlb(unsigned log_bytes)
 {
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
-
-    unsigned lru = 0;
-    for (unsigned i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
+    switch (log_bytes) {
+      case PageShift:
+        return l1Tlb4K;
+      case LargePageShift:
+        return l1Tlb2M ? *l1Tlb2M : l1Tlb4K;
+      case HugePageShift:
+        return l1Tlb1G ? *l1Tlb1G : l1Tlb4K;
+      default:
+        panic("No TLB for pages of %d address bits.\n", log_bytes);
     }
-
-    assert(tlb[lru].trieHandle);
-    trie.remove(tlb[lru].trieHandle);
-    tlb[lru].trieHandle = NULL;
-    freeList.push_back(&tlb[lru]);
 }
 
 TlbEntry *
 TLB::insert(Addr vpn, const TlbEntry &entry)
 {
-    // If somebody beat us to it, just use that existing entry.
-    TlbEntry *newEntry = trie.lookup(vpn);
-    if (newEntry) {
-        assert(newEntry->vaddr == vpn);
-        return newEntry;
-    }
-
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
-
-    *newEntry = entry;
-    newEntry->lruSeq = nextSeq();
-    newEntry->vaddr = vpn;
-    newEntry->trieHandle =
-    trie.insert(vpn, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
-    return newEntry;
+    if (l2Tlb)
+        l2Tlb->insert(vpn, entry);
+    return l1Tlb(entry.logBytes).insert(vpn, entry);
 }
 
 TlbEntry *
-TLB::lookup(Addr va, bool update_lru)
+TLB::lookup(Addr va, bool update_lru, bool *l2_hit)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry && update_lru)
-        entry->lruSeq = nextSeq();
+    if (l2_hit)
+        *l2_hit = false;
+
+    TlbEntry *entry = nullptr;
+    for (auto it = l1Tlbs.begin(); !entry && it != l1Tlbs.end(); ++it)
+        entry = (*it)->lookup(va, update_lru);
+    if (entry || !l2Tlb)
+        return entry;
+
+    entry = l2Tlb->lookup(va, update_lru);
+    if (l2_hit)
+        *l2_hit = entry != nullptr;
+    if (update_lru) {
+        if (entry) {
+            stats.l2Hits++;
+            entry = l1Tlb(entry->logBytes).insert(entry->vaddr, *entry);
+        } else {
+            stats.l2Misses++;
+        }
+    }
     return entry;
 }
 
@@ -130,13 +157,11 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
-    for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
-    }
+    for (EntryArray *array : l1Tlbs)
+        array->flushAll();
+    if (l2Tlb)
+        l2Tlb->flushAll();
+    walker->flushWalkCaches();
 }
 
 void
@@ -149,24 +174,23 @@ void
 TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
-    for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle && !tlb[i].global) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
-    }
+    for (EntryArray *array : l1Tlbs)
+        array->flushNonGlobal();
+    if (l2Tlb)
+        l2Tlb->flushNonGlobal();
+    walker->flushWalkCaches();
 }
 
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry) {
-        trie.remove(entry->trieHandle);
-        entry->trieHandle = NULL;
-        freeList.push_back(entry);
-    }
+    for (EntryArray *array : l1Tlbs)
+        array->demapPage(va);
+    if (l2Tlb)
+        l2Tlb->demapPage(va);
+    // The paging structure caches aren't tagged with the pages they lead
+    // to, so drop them all.
+    walker->flushWalkCaches();
 }
 
 namespace
@@ -306,13 +330,14 @@ TLB::finalizePhysical(const RequestPtr &req,
 Fault
 TLB::translate(const RequestPtr &req,
         ThreadContext *tc, Translation *translation,
-        Mode mode, bool &delayedResponse, bool timing)
+        Mode mode, bool &delayedResponse, bool timing, Cycles &latency)
 {
     Request::Flags flags = req->getFlags();
     int seg = flags & SegmentFlagMask;
     bool storeCheck = flags & (StoreCheck << FlagShift);
 
     delayedResponse = false;
+    latency = Cycles(0);
 
     // If this is true, we're dealing with a request to a non-memory address
     // space.
@@ -371,7 +396,10 @@ TLB::translate(const RequestPtr &req,
         if (m5Reg.paging) {
             DPRINTF(TLB, "Paging enabled.\n");
             // The vaddr already has the segment base applied.
-            TlbEntry *entry = lookup(vaddr);
+            bool l2_hit;
+            TlbEntry *entry = lookup(vaddr, true, &l2_hit);
+            if (l2_hit)
+                latency = l2HitLatency;
             if (mode == Read) {
                 stats.rdAccesses++;
             } else {
@@ -461,7 +489,9 @@ Fault
 TLB::translateAtomic(const RequestPtr &req, ThreadContext *tc, Mode mode)
 {
     bool delayedResponse;
-    return TLB::translate(req, tc, NULL, mode, delayedResponse, false);
+    Cycles latency;
+    return TLB::translate(req, tc, NULL, mode, delayedResponse, false,
+                          latency);
 }
 
 Fault
@@ -503,13 +533,23 @@ TLB::translateTiming(const RequestPtr &req, ThreadContext *tc,
         Translation *translation, Mode mode)
 {
     bool delayedResponse;
+    Cycles latency;
     assert(translation);
-    Fault fault =
-        TLB::translate(req, tc, translation, mode, delayedResponse, true);
-    if (!delayedResponse)
+    Fault fault = TLB::translate(req, tc, translation, mode,
+                                 delayedResponse, true, latency);
+    if (!delayedResponse && latency) {
+        // Finish once the L2 has been accessed. The TLB isn't clocked
+        // itself, so use the clock of its walker.
+        translation->markDelayed();
+        schedule(new EventFunctionWrapper(
+                    [=]{ translation->finish(fault, req, tc, mode); },
+                    name() + ".l2Hit", true),
+                 walker->clockEdge(latency));
+    } else if (!delayedResponse) {
         translation->finish(fault, req, tc, mode);
-    else
+    } else {
         translation->markDelayed();
+    }
 }
 
 Walker *
@@ -523,44 +563,55 @@ TLB::TlbStats::TlbStats(Stats::Group *parent)
     ADD_STAT(rdAccesses, "TLB accesses on read requests"),
     ADD_STAT(wrAccesses, "TLB accesses on write requests"),
     ADD_STAT(rdMisses, "TLB misses on read requests"),
-    ADD_STAT(wrMisses, "TLB misses on write requests")
+    ADD_STAT(wrMisses, "TLB misses on write requests"),
+    ADD_STAT(l2Hits, "L1 TLB misses which hit in the L2 TLB"),
+    ADD_STAT(l2Misses, "L1 TLB misses which missed in the L2 TLB")
 {
 }
 
 void
 TLB::serialize(CheckpointOut &cp) const
 {
-    // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    // Only store the entries in use, from least to most recently used so
+    // that inserting them in order restores the LRU state.
+    std::vector<const TlbEntry *> entries;
+    for (const EntryArray *array : l1Tlbs) {
+        const auto valid = array->validEntries();
+        entries.insert(entries.end(), valid.begin(), valid.end());
+    }
+    uint32_t _size = entries.size();
     SERIALIZE_SCALAR(_size);
-    SERIALIZE_SCALAR(lruSeq);
-
-    uint32_t _count = 0;
-    for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
-            tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
+    for (uint32_t x = 0; x < _size; x++)
+        entries[x]->serializeSection(cp, csprintf("Entry%d", x));
+
+    if (l2Tlb) {
+        entries = l2Tlb->validEntries();
+        uint32_t _l2Size = entries.size();
+        SERIALIZE_SCALAR(_l2Size);
+        for (uint32_t x = 0; x < _l2Size; x++)
+            entries[x]->serializeSection(cp, csprintf("L2Entry%d", x));
     }
 }
 
 void
 TLB::unserialize(CheckpointIn &cp)
 {
-    // Do not allow to restore with a smaller tlb.
+    // Entries which don't fit in a smaller TLB evict each other.
     uint32_t _size;
     UNSERIALIZE_SCALAR(_size);
-    if (_size > size) {
-        fatal("TLB size less than the one in checkpoint!");
-    }
-
-    UNSERIALIZE_SCALAR(lruSeq);
-
     for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
+        TlbEntry entry;
+        entry.unserializeSection(cp, csprintf("Entry%d", x));
+        l1Tlb(entry.logBytes).insert(entry.vaddr, entry);
+    }
 
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        newEntry->trieHandle = trie.insert(newEntry->vaddr,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+    // Checkpoints taken without an L2 TLB have no L2 entries.
+    uint32_t _l2Size = 0;
+    UNSERIALIZE_OPT_SCALAR(_l2Size);
+    for (uint32_t x = 0; l2Tlb && x < _l2Size; x++) {
+        TlbEntry entry;
+        entry.unserializeSection(cp, csprintf("L2Entry%d", x));
+        l2Tlb->insert(entry.vaddr, entry);
     }
 }
 
@@ -39,11 +39,12 @@
 #define __ARCH_X86_TLB_HH__
 
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "arch/x86/pagetable.hh"
-#include "base/trie.hh"
+#include "arch/x86/tlb_array.hh"
 #include "mem/request.hh"
 #include "params/X86TLB.hh"
 #include "sim/stats.hh"
@@ -59,8 +60,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry *> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -70,14 +69,20 @@ namespace X86ISA
 
         void takeOverFrom(BaseTLB *otlb) override {}
 
-        TlbEntry *lookup(Addr va, bool update_lru = true);
+        /**
+         * Look a translation up, first in the L1 array of each page size
+         * and then in the L2. An L2 hit refills the L1 when the LRU state
+         * is updated.
+         *
+         * @param l2_hit Set if the translation was found in the L2.
+         */
+        TlbEntry *lookup(Addr va, bool update_lru = true,
+                         bool *l2_hit = nullptr);
 
         void setConfigAddress(uint32_t addr);
 
       protected:
 
-        EntryList::iterator lookupIt(Addr va, bool update_lru = true);
-
         Walker * walker;
 
       public:
@@ -90,14 +95,22 @@ namespace X86ISA
         void demapPage(Addr va, uint64_t asn) override;
 
       protected:
-        uint32_t size;
+        typedef TlbArray<TlbEntry> EntryArray;
 
-        std::vector<TlbEntry> tlb;
+        // The L1 arrays for 4KB, 2MB and 1GB pages. Large pages share the
+        // 4KB array when no separate array is configured for them.
+        EntryArray l1Tlb4K;
+        std::unique_ptr<EntryArray> l1Tlb2M;
+        std::unique_ptr<EntryArray> l1Tlb1G;
+        // The L1 arrays in use, in the order they are looked up in.
+        std::vector<EntryArray *> l1Tlbs;
 
-        EntryList freeList;
+        // The unified L2 for all page sizes, if any.
+        std::unique_ptr<EntryArray> l2Tlb;
+        // The extra latency of a translation which hits in the L2.
+        const Cycles l2HitLatency;
 
-        TlbEntryTrie trie;
-        uint64_t lruSeq;
+        EntryArray &l1Tlb(unsigned log_bytes);
 
         AddrRange m5opRange;
 
@@ -108,24 +121,18 @@ namespace X86ISA
             Stats::Scalar wrAccesses;
             Stats::Scalar rdMisses;
             Stats::Scalar wrMisses;
+            Stats::Scalar l2Hits;
+            Stats::Scalar l2Misses;
         } stats;
 
         Fault translateInt(bool read, RequestPtr req, ThreadContext *tc);
 
         Fault translate(const RequestPtr &req, ThreadContext *tc,
                 Translation *translation, Mode mode,
-                bool &delayedResponse, bool timing);
+                bool &delayedResponse, bool timing, Cycles &latency);
 
       public:
 
-        void evictLRU();
-
-        uint64_t
-        nextSeq()
-        {
-            return ++lruSeq;
-        }
-
         Fault translateAtomic(
             const RequestPtr &req, ThreadContext *tc, Mode mode) override;
         Fault translateFunctional(
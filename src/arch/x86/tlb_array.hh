@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_X86_TLB_ARRAY_HH__
+#define __ARCH_X86_TLB_ARRAY_HH__
+
+#include <list>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace X86ISA
+{
+    /**
+     * A set associative array of TLB entries with LRU replacement. The
+     * entries of each page size are indexed with the page number of that
+     * size, so an array which holds several page sizes is probed once per
+     * size. An associativity of 0 makes the array fully associative.
+     *
+     * @tparam Entry The entry type, which has vaddr, logBytes and global
+     *         members.
+     */
+    template <class Entry>
+    class TlbArray
+    {
+      public:
+        typedef std::list<Entry *> EntryList;
+
+        TlbArray(unsigned size, unsigned assoc,
+                 const std::vector<unsigned> &log_bytes);
+
+        TlbArray(const TlbArray &) = delete;
+        TlbArray &operator=(const TlbArray &) = delete;
+
+        Entry *lookup(Addr va, bool update_lru = true);
+
+        /**
+         * Insert an entry, evicting the least recently used entry of its
+         * set if the set is full. If the page is already mapped the
+         * existing entry is returned.
+         */
+        Entry *insert(Addr vpn, const Entry &entry);
+
+        void flushAll();
+        void flushNonGlobal();
+        void demapPage(Addr va);
+
+        /** The entries in use, from least to most recently used. */
+        std::vector<const Entry *> validEntries() const;
+
+      protected:
+        const unsigned numSets;
+        const Addr setMask;
+        // The page sizes held, in address bits.
+        const std::vector<unsigned> logBytes;
+
+        std::vector<Entry> tlb;
+
+        // The free and in use entries of each set, the latter in most
+        // recently used order.
+        std::vector<EntryList> freeList;
+        std::vector<EntryList> entryList;
+
+        unsigned
+        setIndex(Addr va, unsigned log_bytes) const
+        {
+            return (va >> log_bytes) & setMask;
+        }
+
+        typename EntryList::iterator lookupIt(Addr va, unsigned log_bytes);
+    };
+}
+
+#endif // __ARCH_X86_TLB_ARRAY_HH__
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "arch/x86/isa_traits.hh"
+#include "arch/x86/tlb_array_impl.hh"
+
+using namespace X86ISA;
+
+namespace {
+
+/** The fields of a Entry the array looks at */
+struct Entry
+{
+    Addr vaddr = 0;
+    unsigned logBytes = 0;
+    bool global = false;
+};
+
+typedef TlbArray<Entry> EntryArray;
+
+/** Make an entry mapping a page of the given size */
+Entry
+makeEntry(Addr vaddr, unsigned log_bytes = PageShift, bool global = false)
+{
+    Entry entry;
+    entry.vaddr = vaddr;
+    entry.logBytes = log_bytes;
+    entry.global = global;
+    return entry;
+}
+
+/** The virtual addresses of the valid entries, least recently used first */
+std::vector<Addr>
+validPages(const EntryArray &array)
+{
+    std::vector<Addr> pages;
+    for (const Entry *entry : array.validEntries())
+        pages.push_back(entry->vaddr);
+    return pages;
+}
+
+} // anonymous namespace
+
+TEST(TlbArrayTest, FullyAssociativeLru)
+{
+    // An associativity of 0 puts every entry in a single set
+    EntryArray array(4, 0, { PageShift });
+    for (Addr page = 0; page < 4; page++)
+        array.insert(page << PageShift, makeEntry(page << PageShift));
+
+    // Touch the oldest page so the second one is evicted instead
+    ASSERT_NE(array.lookup(0x0), nullptr);
+    array.insert(0x4000, makeEntry(0x4000));
+
+    EXPECT_EQ(array.lookup(0x1000), nullptr);
+    EXPECT_EQ(validPages(array),
+              std::vector<Addr>({ 0x2000, 0x3000, 0x0, 0x4000 }));
+}
+
+TEST(TlbArrayTest, LookupWithoutLruUpdate)
+{
+    EntryArray array(2, 0, { PageShift });
+    array.insert(0x0, makeEntry(0x0));
+    array.insert(0x1000, makeEntry(0x1000));
+
+    // A lookup which doesn't update the LRU state leaves 0x0 the oldest
+    ASSERT_NE(array.lookup(0x0, false), nullptr);
+    array.insert(0x2000, makeEntry(0x2000));
+    EXPECT_EQ(array.lookup(0x0), nullptr);
+    EXPECT_NE(array.lookup(0x1000), nullptr);
+}
+
+TEST(TlbArrayTest, SetAssociativeEviction)
+{
+    // Two sets of two ways, indexed by the low bit of the page number
+    EntryArray array(4, 2, { PageShift });
+    array.insert(0x0, makeEntry(0x0));
+    array.insert(0x2000, makeEntry(0x2000));
+    array.insert(0x1000, makeEntry(0x1000));
+
+    // Filling the even set evicts from it but not from the odd set
+    array.insert(0x4000, makeEntry(0x4000));
+    EXPECT_EQ(array.lookup(0x0), nullptr);
+    EXPECT_NE(array.lookup(0x2000), nullptr);
+    EXPECT_NE(array.lookup(0x4000), nullptr);
+    EXPECT_NE(array.lookup(0x1000), nullptr);
+}
+
+TEST(TlbArrayTest, LookupWithinPage)
+{
+    EntryArray array(4, 0, { PageShift });
+    Entry *entry = array.insert(0x5000, makeEntry(0x5000));
+
+    EXPECT_EQ(array.lookup(0x5abc), entry);
+    EXPECT_EQ(array.lookup(0x6000), nullptr);
+}
+
+TEST(TlbArrayTest, InsertExisting)
+{
+    EntryArray array(4, 0, { PageShift });
+    Entry *first = array.insert(0x1000, makeEntry(0x1000));
+    Entry *second = array.insert(0x1000, makeEntry(0x1000));
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(array.validEntries().size(), 1);
+}
+
+TEST(TlbArrayTest, MixedPageSizes)
+{
+    EntryArray array(8, 2, { PageShift, LargePageShift, HugePageShift });
+    Entry *small = array.insert(0x1000, makeEntry(0x1000));
+    Entry *large = array.insert(0x400000,
+                                   makeEntry(0x400000, LargePageShift));
+    Entry *huge = array.insert(0x80000000,
+                                  makeEntry(0x80000000, HugePageShift));
+
+    EXPECT_EQ(array.lookup(0x1fff), small);
+    EXPECT_EQ(array.lookup(0x5fffff), large);
+    EXPECT_EQ(array.lookup(0xbfffffff), huge);
+    EXPECT_EQ(array.lookup(0x2000), nullptr);
+
+    array.demapPage(0x4abcde);
+    EXPECT_EQ(array.lookup(0x400000), nullptr);
+    EXPECT_EQ(array.lookup(0x1000), small);
+    EXPECT_EQ(array.lookup(0x80000000), huge);
+}
+
+TEST(TlbArrayTest, Flush)
+{
+    EntryArray array(4, 2, { PageShift });
+    array.insert(0x0, makeEntry(0x0, PageShift, true));
+    array.insert(0x1000, makeEntry(0x1000));
+    array.insert(0x2000, makeEntry(0x2000));
+
+    array.flushNonGlobal();
+    EXPECT_EQ(validPages(array), std::vector<Addr>({ 0x0 }));
+
+    // The flushed entries can be reused
+    for (Addr page = 1; page < 4; page++)
+        array.insert(page << PageShift, makeEntry(page << PageShift));
+    EXPECT_EQ(array.validEntries().size(), 4);
+
+    array.flushAll();
+    EXPECT_TRUE(array.validEntries().empty());
+    EXPECT_EQ(array.lookup(0x0), nullptr);
+}
+
+TEST(TlbArrayTest, BadGeometry)
+{
+    EXPECT_ANY_THROW(EntryArray(0, 0, { PageShift }));
+    EXPECT_ANY_THROW(EntryArray(6, 4, { PageShift }));
+    EXPECT_ANY_THROW(EntryArray(12, 4, { PageShift }));
+}
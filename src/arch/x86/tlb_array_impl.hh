@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_X86_TLB_ARRAY_IMPL_HH__
+#define __ARCH_X86_TLB_ARRAY_IMPL_HH__
+
+#include <iterator>
+
+#include "arch/x86/tlb_array.hh"
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace X86ISA {
+
+template <class Entry>
+TlbArray<Entry>::TlbArray(unsigned size, unsigned assoc,
+                          const std::vector<unsigned> &log_bytes)
+    : numSets(assoc ? size / assoc : 1), setMask(numSets - 1),
+      logBytes(log_bytes), tlb(size), freeList(numSets), entryList(numSets)
+{
+    fatal_if(!size, "TLBs must have a non-zero size.\n");
+    const bool uneven_sets = assoc && size % assoc;
+    fatal_if(uneven_sets,
+             "TLB size %d is not a multiple of its associativity %d.\n",
+             size, assoc);
+    fatal_if(!isPowerOf2(numSets),
+             "The number of TLB sets, %d, is not a power of 2.\n", numSets);
+
+    for (unsigned x = 0; x < size; x++)
+        freeList[x % numSets].push_back(&tlb[x]);
+}
+
+template <class Entry>
+typename TlbArray<Entry>::EntryList::iterator
+TlbArray<Entry>::lookupIt(Addr va, unsigned log_bytes)
+{
+    const Addr vpn = va & ~mask(log_bytes);
+    EntryList &set = entryList[setIndex(va, log_bytes)];
+    auto entry = set.begin();
+    for (; entry != set.end(); ++entry) {
+        if ((*entry)->logBytes == log_bytes && (*entry)->vaddr == vpn)
+            break;
+    }
+    return entry;
+}
+
+template <class Entry>
+Entry *
+TlbArray<Entry>::lookup(Addr va, bool update_lru)
+{
+    for (unsigned log_bytes : logBytes) {
+        EntryList &set = entryList[setIndex(va, log_bytes)];
+        auto entry = lookupIt(va, log_bytes);
+        if (entry == set.end())
+            continue;
+        if (update_lru && entry != set.begin())
+            set.splice(set.begin(), set, entry);
+        return *entry;
+    }
+    return nullptr;
+}
+
+template <class Entry>
+Entry *
+TlbArray<Entry>::insert(Addr vpn, const Entry &entry)
+{
+    const unsigned set = setIndex(vpn, entry.logBytes);
+
+    // If somebody beat us to it, just use that existing entry.
+    auto it = lookupIt(vpn, entry.logBytes);
+    if (it != entryList[set].end())
+        return *it;
+
+    Entry *newEntry;
+    if (!freeList[set].empty()) {
+        newEntry = freeList[set].front();
+        freeList[set].pop_front();
+    } else {
+        newEntry = entryList[set].back();
+        entryList[set].pop_back();
+    }
+
+    *newEntry = entry;
+    newEntry->vaddr = vpn;
+    entryList[set].push_front(newEntry);
+    return newEntry;
+}
+
+template <class Entry>
+void
+TlbArray<Entry>::flushAll()
+{
+    for (unsigned set = 0; set < numSets; set++)
+        freeList[set].splice(freeList[set].end(), entryList[set]);
+}
+
+template <class Entry>
+void
+TlbArray<Entry>::flushNonGlobal()
+{
+    for (unsigned set = 0; set < numSets; set++) {
+        for (auto entry = entryList[set].begin();
+                entry != entryList[set].end();) {
+            auto next = std::next(entry);
+            if (!(*entry)->global)
+                freeList[set].splice(freeList[set].end(), entryList[set],
+                                     entry);
+            entry = next;
+        }
+    }
+}
+
+template <class Entry>
+void
+TlbArray<Entry>::demapPage(Addr va)
+{
+    for (unsigned log_bytes : logBytes) {
+        EntryList &set = entryList[setIndex(va, log_bytes)];
+        auto entry = lookupIt(va, log_bytes);
+        if (entry != set.end()) {
+            freeList[setIndex(va, log_bytes)].push_back(*entry);
+            set.erase(entry);
+        }
+    }
+}
+
+template <class Entry>
+std::vector<const Entry *>
+TlbArray<Entry>::validEntries() const
+{
+    std::vector<const Entry *> entries;
+    for (const auto &set : entryList)
+        entries.insert(entries.end(), set.rbegin(), set.rend());
+    return entries;
+}
+
+} // namespace X86ISA
+
+#endif // __ARCH_X86_TLB_ARRAY_IMPL_HH__
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <atomic>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+#include "sim/core.hh"
+
+namespace Trace
+{
+
+namespace
+{
+
+template <typename T>
+void
+put(std::vector<uint8_t> &buf, const T &val)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&val);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+void
+putString(std::vector<uint8_t> &buf, const char *str, size_t len)
+{
+    put<uint32_t>(buf, len);
+    buf.insert(buf.end(), str, str + len);
+}
+
+std::atomic<uint64_t> nextInstance(1);
+
+} // anonymous namespace
+
+const uint32_t BinaryLogger::version;
+
+BinaryLogger::BinaryLogger(std::ostream &stream_)
+    : stream(stream_), instance(nextInstance++), writing(false),
+      stopping(false), lineBuf(*this), lineStream(&lineBuf)
+{
+    takesRecords = true;
+
+    // the header is written before the writer is started
+    const char magic[8] = { 'g', 'e', 'm', '5', 'd', 'b', 'g', '\0' };
+    uint8_t options = (DTRACE(FmtFlag) ? ShowFlag : 0) |
+        (DTRACE(FmtTicksOff) ? TicksOff : 0);
+
+    stream.write(magic, sizeof(magic));
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    stream.write(reinterpret_cast<const char *>(&options), sizeof(options));
+
+    writer = std::thread([this]{ writeChunks(); });
+
+    // the buffers of the simulation threads are only written out in
+    // full when the simulator exits
+    registerExitCallback([this]{ flush(); });
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    flush();
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    chunksQueued.notify_one();
+    writer.join();
+}
+
+BinaryLogger::ThreadBuffer &
+BinaryLogger::threadBuffer()
+{
+    // a thread normally logs to the same logger over and over again
+    static __thread uint64_t cached_instance = 0;
+    static __thread ThreadBuffer *cached_buffer = nullptr;
+
+    if (cached_instance == instance)
+        return *cached_buffer;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto &buf = threadBuffers[std::this_thread::get_id()];
+    if (!buf) {
+        buf.reset(new ThreadBuffer);
+        buf->data.reserve(chunkSize);
+    }
+
+    cached_instance = instance;
+    cached_buffer = buf.get();
+
+    return *buf;
+}
+
+uint32_t
+BinaryLogger::internString(const std::string &str)
+{
+    auto it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+
+    // id 0 is reserved for the empty string
+    uint32_t id = stringIds.size() + 1;
+    stringIds.emplace(str, id);
+
+    // strings go out ahead of any chunk that refers to them
+    std::vector<uint8_t> chunk;
+    put<uint8_t>(chunk, StringEntry);
+    put<uint32_t>(chunk, id);
+    putString(chunk, str.data(), str.size());
+    queueChunk(std::move(chunk));
+
+    return id;
+}
+
+uint32_t
+BinaryLogger::addrId(ThreadBuffer &buf, const void *addr,
+                     const char *str, size_t len)
+{
+    if (len == 0)
+        return 0;
+
+    auto it = buf.addrIds.find(addr);
+    if (it != buf.addrIds.end() && it->second.first.size() == len &&
+        memcmp(it->second.first.data(), str, len) == 0) {
+        return it->second.second;
+    }
+
+    std::string s(str, len);
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        id = internString(s);
+    }
+    buf.addrIds[addr] = std::make_pair(std::move(s), id);
+
+    return id;
+}
+
+uint32_t
+BinaryLogger::flagId(ThreadBuffer &buf, const std::string &flag)
+{
+    if (flag.empty())
+        return 0;
+
+    auto it = buf.flagIds.find(flag);
+    if (it != buf.flagIds.end())
+        return it->second;
+
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        id = internString(flag);
+    }
+    buf.flagIds.emplace(flag, id);
+
+    return id;
+}
+
+void
+BinaryLogger::submit(ThreadBuffer &buf)
+{
+    std::vector<uint8_t> chunk;
+    chunk.reserve(chunkSize);
+    chunk.swap(buf.data);
+
+    std::lock_guard<std::mutex> guard(lock);
+    queueChunk(std::move(chunk));
+}
+
+void
+BinaryLogger::queueChunk(std::vector<uint8_t> &&chunk)
+{
+    chunks.push_back(std::move(chunk));
+    chunksQueued.notify_one();
+}
+
+void
+BinaryLogger::writeChunks()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    while (true) {
+        chunksQueued.wait(guard, [this]{
+                return stopping || !chunks.empty();
+            });
+
+        if (chunks.empty())
+            break;
+
+        std::vector<uint8_t> chunk(std::move(chunks.front()));
+        chunks.pop_front();
+
+        // let the simulation threads carry on while we write
+        writing = true;
+        guard.unlock();
+        stream.write(reinterpret_cast<const char *>(chunk.data()),
+                     chunk.size());
+        guard.lock();
+        writing = false;
+
+        if (chunks.empty())
+            chunksWritten.notify_all();
+    }
+}
+
+void
+BinaryLogger::flush()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    for (auto &tb : threadBuffers) {
+        if (!tb.second->data.empty()) {
+            queueChunk(std::move(tb.second->data));
+            tb.second->data.clear();
+        }
+    }
+
+    chunksWritten.wait(guard, [this]{ return chunks.empty() && !writing; });
+    stream.flush();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    ThreadBuffer &buf = threadBuffer();
+    const uint32_t name_id = addrId(buf, &name, name.data(), name.size());
+    const uint32_t flag_id = flagId(buf, flag);
+
+    put<uint8_t>(buf.data, MessageEntry);
+    put<uint64_t>(buf.data, when);
+    put<uint32_t>(buf.data, name_id);
+    put<uint32_t>(buf.data, flag_id);
+    putString(buf.data, message.data(), message.size());
+
+    if (buf.data.size() >= chunkSize)
+        submit(buf);
+}
+
+void
+BinaryLogger::logRecord(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt,
+        const RecordArg *args, size_t num_args)
+{
+    // the name has already been matched against the objects to ignore
+    ThreadBuffer &buf = threadBuffer();
+    const uint32_t name_id = addrId(buf, &name, name.data(), name.size());
+    const uint32_t flag_id = flagId(buf, flag);
+    const uint32_t fmt_id = addrId(buf, fmt, fmt, strlen(fmt));
+
+    panic_if(num_args > UINT8_MAX, "Too many arguments to trace: %d\n",
+             num_args);
+
+    put<uint8_t>(buf.data, RecordEntry);
+    put<uint64_t>(buf.data, when);
+    put<uint32_t>(buf.data, name_id);
+    put<uint32_t>(buf.data, flag_id);
+    put<uint32_t>(buf.data, fmt_id);
+    put<uint8_t>(buf.data, num_args);
+
+    for (size_t i = 0; i < num_args; ++i) {
+        const RecordArg &arg = args[i];
+
+        put<uint8_t>(buf.data, arg.type);
+        switch (arg.type) {
+          case RecordArg::Signed:
+            put<uint8_t>(buf.data, arg.size);
+            put<int64_t>(buf.data, arg.s);
+            break;
+          case RecordArg::Unsigned:
+          case RecordArg::Pointer:
+            put<uint8_t>(buf.data, arg.size);
+            put<uint64_t>(buf.data, arg.u);
+            break;
+          case RecordArg::Float:
+            put<double>(buf.data, arg.f);
+            break;
+          case RecordArg::Char:
+            put<char>(buf.data, arg.s);
+            break;
+          case RecordArg::String:
+            putString(buf.data, arg.str(), arg.strSize());
+            break;
+        }
+    }
+
+    if (buf.data.size() >= chunkSize)
+        submit(buf);
+}
+
+int
+BinaryLogger::LineBuf::sync()
+{
+    // lines written directly to the stream carry no tick or name
+    if (!str().empty()) {
+        logger.logMessage(MaxTick, std::string(), std::string(), str());
+        str(std::string());
+    }
+
+    return 0;
+}
+
+} // namespace Trace
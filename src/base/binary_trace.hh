@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/trace.hh"
+
+namespace Trace {
+
+/**
+ * Debug logger that stores the format string and the arguments of
+ * every message as a compact binary record instead of formatting it.
+ * Format strings, object names and flags are written once, and the
+ * records refer to them by id. Each simulation thread appends to a
+ * buffer of its own, and full buffers are written to the output
+ * stream by a separate thread. The text output can be reproduced
+ * with util/decode_debug_trace.py.
+ *
+ * The file starts with the magic "gem5dbg\0", a uint32_t version, and
+ * a uint8_t with the Options the text would have been formatted with.
+ * It then consists of entries in host byte order, each starting with
+ * a uint8_t EntryKind:
+ *
+ * StringEntry:  uint32_t id, uint32_t length, characters
+ * RecordEntry:  uint64_t tick, uint32_t name id, uint32_t flag id,
+ *               uint32_t format id, uint8_t argument count, and for
+ *               each argument a uint8_t RecordArg::Type followed by
+ *                 Signed, Unsigned, Pointer: uint8_t size, 64-bit
+ *                 value
+ *                 Float: double
+ *                 Char: char
+ *                 String: uint32_t length, characters
+ * MessageEntry: uint64_t tick, uint32_t name id, uint32_t flag id,
+ *               uint32_t length, characters
+ *
+ * String id 0 is the empty string. Records from different threads are
+ * not interleaved in tick order.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    enum EntryKind : uint8_t {
+        StringEntry = 1,
+        RecordEntry,
+        MessageEntry
+    };
+
+    enum Options : uint8_t {
+        ShowFlag = 0x1,
+        TicksOff = 0x2
+    };
+
+    static const uint32_t version = 1;
+
+  private:
+    /** Records of one simulation thread waiting to be written */
+    struct ThreadBuffer
+    {
+        std::vector<uint8_t> data;
+
+        /**
+         * Ids of format strings and names by address, along with the
+         * string to tell a reused address apart.
+         */
+        std::unordered_map<const void *,
+                           std::pair<std::string, uint32_t>> addrIds;
+
+        /** Ids of the flags by name */
+        std::unordered_map<std::string, uint32_t> flagIds;
+    };
+
+    /** Turns the lines written to getOstream() into messages */
+    class LineBuf : public std::stringbuf
+    {
+      private:
+        BinaryLogger &logger;
+
+      public:
+        LineBuf(BinaryLogger &_logger) : logger(_logger) {}
+
+      protected:
+        int sync() override;
+    };
+
+    /** Size at which a thread hands its buffer over to the writer */
+    static const size_t chunkSize = 64 * 1024;
+
+    std::ostream &stream;
+
+    /** Tells the thread buffer caches of different loggers apart */
+    const uint64_t instance;
+
+    /**
+     * Protects the string ids, the thread buffer map and the chunks
+     * waiting to be written.
+     */
+    std::mutex lock;
+
+    /** Ids of all strings written so far */
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    std::unordered_map<std::thread::id,
+                       std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    std::deque<std::vector<uint8_t>> chunks;
+
+    /** Set while the writer is writing a chunk without the lock */
+    bool writing;
+
+    bool stopping;
+
+    std::condition_variable chunksQueued;
+
+    std::condition_variable chunksWritten;
+
+    LineBuf lineBuf;
+
+    std::ostream lineStream;
+
+    std::thread writer;
+
+    /** Get the buffer of the calling thread */
+    ThreadBuffer &threadBuffer();
+
+    /**
+     * Get the id of a string, writing it out if it is new. Must be
+     * called with the lock held.
+     */
+    uint32_t internString(const std::string &str);
+
+    /** Get the id of a string that is likely found at the same address */
+    uint32_t addrId(ThreadBuffer &buf, const void *addr,
+                    const char *str, size_t len);
+
+    /** Get the id of a flag */
+    uint32_t flagId(ThreadBuffer &buf, const std::string &flag);
+
+    /** Hand the contents of a thread buffer over to the writer */
+    void submit(ThreadBuffer &buf);
+
+    /**
+     * Queue a chunk of entries to be written. Must be called with the
+     * lock held.
+     */
+    void queueChunk(std::vector<uint8_t> &&chunk);
+
+    /** Body of the writer thread */
+    void writeChunks();
+
+  public:
+    BinaryLogger(std::ostream &stream_);
+
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    void logRecord(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const RecordArg *args, size_t num_args) override;
+
+    std::ostream &getOstream() override { return lineStream; }
+
+    /**
+     * Write out all records logged so far. Must not be called while
+     * other threads are logging.
+     */
+    void flush();
+};
+
+} // namespace Trace
+
+#endif // __BASE_BINARY_TRACE_HH__
@@ -137,11 +137,14 @@ void dumpDebugFlags();
 /**
  * \def DTRACE(x)
  *
+ * Flags left out of the TRACING_FLAGS build option are constant false,
+ * which removes their checks and everything they guard.
+ *
  * @ingroup api_trace
  * @{
  */
 #if TRACING_ON
-#   define DTRACE(x) (Debug::x)
+#   define DTRACE(x) (Debug::Compiled::x && Debug::x)
 #else // !TRACING_ON
 #   define DTRACE(x) (false)
 #endif  // TRACING_ON
@@ -143,6 +143,14 @@ Logger::dump(Tick when, const std::string &name,
     }
 }
 
+void
+Logger::logRecord(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt,
+        const RecordArg *args, size_t num_args)
+{
+    panic("Logger does not take records\n");
+}
+
 void
 OstreamLogger::logMessage(Tick when, const std::string &name,
         const std::string &flag, const std::string &message)
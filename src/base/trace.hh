@@ -32,7 +32,10 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <array>
+#include <cstring>
 #include <string>
+#include <type_traits>
 
 #include "base/cprintf.hh"
 #include "base/debug.hh"
@@ -42,6 +45,101 @@
 
 namespace Trace {
 
+/**
+ * A typed argument of a trace record, captured without formatting it
+ * for loggers that store records rather than text. Integers, floating
+ * point values, characters, strings and pointers are kept as they are,
+ * anything else is turned into a string the way cprintf would print it.
+ * Booleans are kept as int, which is how they are printed.
+ */
+class RecordArg
+{
+  public:
+    enum Type : uint8_t {
+        Signed = 1,
+        Unsigned,
+        Float,
+        Char,
+        String,
+        Pointer
+    };
+
+    Type type;
+
+    /** Size in bytes of the original integer type */
+    uint8_t size;
+
+    union {
+        int64_t s;
+        uint64_t u;
+        double f;
+    };
+
+  private:
+    const char *strData;
+    size_t strLen;
+    std::string ownedStr;
+
+  public:
+    template <typename T,
+              typename std::enable_if<std::is_integral<T>::value,
+                                      int>::type = 0>
+    RecordArg(const T &v)
+        : type(std::is_same<T, char>::value ? Char :
+               std::is_signed<T>::value ? Signed : Unsigned),
+          size(std::is_same<T, bool>::value ? sizeof(int) : sizeof(T)),
+          u(0), strData(nullptr), strLen(0)
+    {
+        if (std::is_signed<T>::value)
+            s = (int64_t)v;
+        else
+            u = (uint64_t)v;
+    }
+
+    template <typename T,
+              typename std::enable_if<std::is_floating_point<T>::value,
+                                      int>::type = 0>
+    RecordArg(const T &v)
+        : type(Float), size(sizeof(T)), f(v), strData(nullptr), strLen(0)
+    {}
+
+    RecordArg(const char *str)
+        : type(String), size(0), u(0), strData(str),
+          strLen(str ? strlen(str) : 0)
+    {}
+
+    RecordArg(char *str) : RecordArg((const char *)str) {}
+
+    RecordArg(const std::string &str)
+        : type(String), size(0), u(0), strData(str.data()),
+          strLen(str.size())
+    {}
+
+    template <typename T>
+    RecordArg(T *ptr)
+        : type(Pointer), size(sizeof(ptr)), u((uintptr_t)ptr),
+          strData(nullptr), strLen(0)
+    {}
+
+    template <typename T,
+              typename std::enable_if<!std::is_arithmetic<T>::value &&
+                                      !std::is_pointer<T>::value,
+                                      int>::type = 0>
+    RecordArg(const T &v)
+        : type(String), size(0), u(0), strData(nullptr), strLen(0)
+    {
+        std::ostringstream str;
+        str << v;
+        ownedStr = str.str();
+    }
+
+    /** String data, valid as long as the original argument */
+    const char *str() const { return strData ? strData : ownedStr.data(); }
+
+    /** Length of the string data */
+    size_t strSize() const { return strData ? strLen : ownedStr.size(); }
+};
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -50,6 +148,12 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /**
+     * Set by loggers that take the format string and its arguments
+     * through logRecord() rather than formatted messages.
+     */
+    bool takesRecords = false;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -67,6 +171,14 @@ class Logger
     {
         if (!name.empty() && ignore.match(name))
             return;
+        if (takesRecords) {
+            const std::array<RecordArg, sizeof...(Args)> record_args{{
+                RecordArg(args)...
+            }};
+            logRecord(when, name, flag, fmt, record_args.data(),
+                      record_args.size());
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -80,6 +192,14 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /**
+     * Log a message as its format string and arguments, only called
+     * if takesRecords is set.
+     */
+    virtual void logRecord(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const RecordArg *args, size_t num_args);
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
@@ -120,6 +120,16 @@ ActivityRecorder::deactivateStage(const int idx)
     assert(activityCount >= 0);
 }
 
+bool
+ActivityRecorder::recentActivity() const
+{
+    int active_stages = 0;
+    for (int i = 0; i < numStages; ++i)
+        active_stages += stageActive[i];
+
+    return activityCount > active_stages;
+}
+
 void
 ActivityRecorder::reset()
 {
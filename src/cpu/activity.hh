@@ -87,6 +87,12 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns if activity was recorded in the time buffer, that is in
+     * the last longestLatency cycles or this cycle, leaving aside the
+     * stages that are active.
+     */
+    bool recentActivity() const;
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
@@ -58,6 +58,7 @@
 #include "cpu/exetrace.hh"
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/op_class.hh"
 #include "cpu/static_inst.hh"
 #include "cpu/translation.hh"
@@ -89,8 +90,8 @@ class BaseDynInst : public ExecContext, public RefCounted
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef RefCountingPtr<BaseDynInst<Impl> > BaseDynInstPtr;
 
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    // The position type of the list of instructions.
+    typedef typename InstRing<DynInstPtr>::Pos ListIt;
 
     enum {
         MaxInstSrcRegs = TheISA::MaxInstSrcRegs,        /// Max source regs
@@ -192,7 +193,7 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
+    /** Position of this BaseDynInst in the list of all insts. */
     ListIt instListIt;
 
     ////////////////////// Branch Data ///////////////
@@ -1021,10 +1022,10 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** Assert this instruction has generated a memory request. */
     void setRequest() { instFlags[ReqMade] = true; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
+    /** Returns the position of this instruction in the list of all insts. */
     ListIt &getInstListIt() { return instListIt; }
 
-    /** Sets iterator for this instruction in the list of all insts. */
+    /** Sets the position of this instruction in the list of all insts. */
     void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
 
   public:
@@ -56,6 +56,9 @@ class SMTQueuePolicy(ScopedEnum):
 class CommitPolicy(ScopedEnum):
     vals = [ 'Aggressive', 'RoundRobin', 'OldestReady' ]
 
+class IQSelectPolicy(ScopedEnum):
+    vals = [ 'PriorityQueue', 'AgeMatrix' ]
+
 class DerivO3CPU(BaseCPU):
     type = 'DerivO3CPU'
     cxx_header = 'cpu/o3/deriv.hh'
@@ -101,6 +104,9 @@ class DerivO3CPU(BaseCPU):
     commitToRenameDelay = Param.Cycles(1, "Commit to rename delay")
     decodeToRenameDelay = Param.Cycles(1, "Decode to rename delay")
     renameWidth = Param.Unsigned(8, "Rename width")
+    numRenameCheckpoints = Param.Unsigned(8, "Number of rename map "
+                                          "checkpoints per thread, taken at "
+                                          "conditional and indirect branches")
 
     commitToIEWDelay = Param.Cycles(1, "Commit to "
                "Issue/Execute/Writeback delay")
@@ -123,6 +129,9 @@ class DerivO3CPU(BaseCPU):
 
     backComSize = Param.Unsigned(5, "Time buffer size for backwards communication")
     forwardComSize = Param.Unsigned(5, "Time buffer size for forward communication")
+    fastIdle = Param.Bool(False, "Stop ticking while the pipeline is "
+        "stalled on memory, and account for the skipped cycles when it "
+        "wakes up")
 
     LQEntries = Param.Unsigned(32, "Number of load queue entries")
     SQEntries = Param.Unsigned(32, "Number of store queue entries")
@@ -156,6 +165,9 @@ class DerivO3CPU(BaseCPU):
     numPhysCCRegs = Param.Unsigned(_defaultNumPhysCCRegs,
                                    "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    iqSelectPolicy = Param.IQSelectPolicy('PriorityQueue',
+        "How the IQ selects the oldest ready instructions: per op class "
+        "priority queues or an age matrix")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
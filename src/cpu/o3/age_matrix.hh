@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_AGE_MATRIX_HH__
+#define __CPU_O3_AGE_MATRIX_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+
+/**
+ * Age matrix select logic for the ready instructions of the IQ. Every
+ * ready instruction occupies a slot, and each slot keeps a bit vector
+ * with the slots holding older instructions. The oldest instruction of
+ * any set of candidate slots is then the one whose row does not
+ * intersect the candidates, which is how select is implemented in
+ * hardware. With the default IQ sizes every row is a single word, so
+ * select is a handful of word operations and nothing is allocated once
+ * the matrix has reached its working size.
+ *
+ * Squashed instructions stay in the matrix until select reaches them,
+ * so the number of slots is not bounded by the IQ size. The matrix grows
+ * when all of its slots are in use.
+ *
+ * @tparam DynInstPtr Reference to an instruction; it must provide
+ * access to the sequence number of the instruction.
+ */
+template <class DynInstPtr>
+class AgeMatrix
+{
+  public:
+    /** A set of slots, one bit per slot. */
+    typedef std::vector<uint64_t> SlotSet;
+
+  private:
+    /** Number of words in a row. */
+    unsigned numWords;
+
+    /** Instruction held by each slot. */
+    std::vector<DynInstPtr> insts;
+
+    /** For each slot the set of slots holding older instructions. Only
+     * the bits of occupied slots are meaningful.
+     */
+    std::vector<uint64_t> older;
+
+    /** Set of occupied slots. */
+    SlotSet occupied;
+
+    /** Number of occupied slots. */
+    unsigned numOccupied;
+
+    uint64_t *row(int slot) { return &older[slot * numWords]; }
+    const uint64_t *
+    row(int slot) const
+    {
+        return &older[slot * numWords];
+    }
+
+    static void
+    setSlot(uint64_t *slots, int slot)
+    {
+        slots[slot / 64] |= ULL(1) << (slot % 64);
+    }
+
+    static void
+    clearSlot(uint64_t *slots, int slot)
+    {
+        slots[slot / 64] &= ~(ULL(1) << (slot % 64));
+    }
+
+    /** Resize to hold num_words words of slots per row. */
+    void
+    resize(unsigned num_words)
+    {
+        std::vector<uint64_t> new_older(num_words * 64 * num_words, 0);
+        for (int slot = 0; slot < numWords * 64; slot++) {
+            for (int w = 0; w < numWords; w++)
+                new_older[slot * num_words + w] = row(slot)[w];
+        }
+        older.swap(new_older);
+        insts.resize(num_words * 64);
+        occupied.resize(num_words, 0);
+        numWords = num_words;
+    }
+
+    int
+    freeSlot() const
+    {
+        for (int w = 0; w < numWords; w++) {
+            if (~occupied[w])
+                return w * 64 + findLsbSet(~occupied[w]);
+        }
+        return -1;
+    }
+
+  public:
+    AgeMatrix(unsigned num_entries)
+        : numWords(0), numOccupied(0)
+    {
+        resize(std::max<unsigned>(divCeil(num_entries, 64), 1));
+    }
+
+    /** Number of instructions in the matrix. */
+    unsigned size() const { return numOccupied; }
+
+    bool empty() const { return numOccupied == 0; }
+
+    /** The set of occupied slots. */
+    const SlotSet &slots() const { return occupied; }
+
+    /** The instruction held by a slot. */
+    const DynInstPtr &operator[](int slot) const { return insts[slot]; }
+
+    /** Add an instruction and order it against all others by age. */
+    int
+    insert(const DynInstPtr &inst)
+    {
+        int slot = freeSlot();
+        if (slot < 0) {
+            slot = numWords * 64;
+            resize(numWords * 2);
+        }
+
+        uint64_t *new_row = row(slot);
+        for (int w = 0; w < numWords; w++)
+            new_row[w] = 0;
+        for (int w = 0; w < numWords; w++) {
+            for (uint64_t bits = occupied[w]; bits; bits &= bits - 1) {
+                int other = w * 64 + findLsbSet(bits);
+                if (insts[other]->seqNum < inst->seqNum) {
+                    setSlot(new_row, other);
+                    clearSlot(row(other), slot);
+                } else {
+                    setSlot(row(other), slot);
+                }
+            }
+        }
+
+        insts[slot] = inst;
+        setSlot(occupied.data(), slot);
+        numOccupied++;
+        return slot;
+    }
+
+    /** Remove the instruction held by a slot. */
+    void
+    remove(int slot)
+    {
+        // Stale bits of the slot in other rows are never looked at while
+        // the slot is free, and are rewritten when it is reused.
+        insts[slot] = nullptr;
+        clearSlot(occupied.data(), slot);
+        numOccupied--;
+    }
+
+    /** Remove all instructions. */
+    void
+    clear()
+    {
+        for (int slot = 0; slot < insts.size(); slot++)
+            insts[slot] = nullptr;
+        for (auto &word : occupied)
+            word = 0;
+        numOccupied = 0;
+    }
+
+    /**
+     * Find the oldest instruction within a set of slots.
+     *
+     * @param candidates A subset of the occupied slots.
+     * @return The slot of the oldest candidate, -1 if there is none.
+     */
+    int
+    oldest(const SlotSet &candidates) const
+    {
+        for (int w = 0; w < numWords; w++) {
+            for (uint64_t bits = candidates[w]; bits; bits &= bits - 1) {
+                int slot = w * 64 + findLsbSet(bits);
+                const uint64_t *slot_row = row(slot);
+                uint64_t conflict = 0;
+                for (int v = 0; v < numWords; v++)
+                    conflict |= slot_row[v] & candidates[v];
+                if (!conflict)
+                    return slot;
+            }
+        }
+        return -1;
+    }
+
+    /** Remove a slot from a slot set. */
+    static void
+    unselect(SlotSet &slots, int slot)
+    {
+        clearSlot(slots.data(), slot);
+    }
+};
+
+#endif // __CPU_O3_AGE_MATRIX_HH__
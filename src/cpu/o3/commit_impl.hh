@@ -408,6 +408,32 @@ DefaultCommit<Impl>::isDrained() const
         interrupt == NoFault;
 }
 
+template <class Impl>
+bool
+DefaultCommit<Impl>::isStalled(ThreadID tid)
+{
+    // Commit waits for the memory access of the instruction at the head
+    // of the ROB. Listeners to stalls see each stall cycle as it happens,
+    // so the cycles can't be skipped while there are any.
+    if (ppCommitStall->hasListeners() || commitStatus[tid] != Running || _status != Inactive ||
+        trapSquash[tid] || tcSquash[tid] || changedROBNumEntries[tid] ||
+        interrupt != NoFault || rob->isEmpty(tid)) {
+        return false;
+    }
+
+    const DynInstPtr &head_inst = rob->readHeadInst(tid);
+
+    return head_inst->isMemRef() && !head_inst->readyToCommit();
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::skipStalledCycles(ThreadID tid, Cycles cycles)
+{
+    stats.numCommittedDist.sample(0, cycles);
+    rob->skipStalledCycles(cycles);
+}
+
 template <class Impl>
 void
 DefaultCommit<Impl>::takeOverFrom()
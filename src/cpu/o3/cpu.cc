@@ -127,7 +127,10 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
 
       globalSeqNum(1),
       system(params->system),
-      lastRunningCycle(curCycle())
+      lastRunningCycle(curCycle()),
+      fastIdle(params->fastIdle),
+      stalled(false),
+      stallCycle(0)
 {
     if (!params->switched_out) {
         _status = Running;
@@ -144,6 +147,20 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
         checker = NULL;
     }
 
+    // Reserve storage for all the instructions the pipeline can hold:
+    // the ROB, the IQ and LSQ, which keep squashed instructions and
+    // committed stores after they left the ROB, the fetch queues and the
+    // stage to stage time buffers including the skid buffers behind them.
+    // The instruction list gets as much room, so it rarely has to grow.
+    const size_t max_insts = params->numROBEntries + params->numIQEntries +
+                             params->LQEntries + params->SQEntries +
+                             numThreads * params->fetchQueueSize +
+                             2 * params->forwardComSize *
+                             (params->decodeWidth + params->renameWidth +
+                              params->dispatchWidth);
+    dynInstPool.reserve(max_insts);
+    instList = InstList(max_insts);
+
     if (!FullSystem) {
         thread.resize(numThreads);
         tids.resize(numThreads);
@@ -401,6 +418,12 @@ FullO3CPU<Impl>::regStats()
               "for an interrupt")
         .prereq(quiesceCycles);
 
+    stalledCycles
+        .name(name() + ".stalledCycles")
+        .desc("Number of cycles the CPU did not tick while the pipeline "
+              "was stalled on memory")
+        .prereq(stalledCycles);
+
     // Number of Instructions simulated
     // --------------------------------
     // Should probably be in Base CPU but need templated
@@ -504,6 +527,30 @@ FullO3CPU<Impl>::regStats()
         .prereq(miscRegfileWrites);
 }
 
+template <class Impl>
+void
+FullO3CPU<Impl>::resetStats()
+{
+    // Stat events run after the CPU ticks, so the current cycle has been
+    // ticked if this is a clock edge.
+    if (stalled)
+        skipStalledCycles(clockEdge() == curTick() ? curCycle() :
+                          curCycle() - Cycles(1));
+
+    BaseO3CPU::resetStats();
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::preDumpStats()
+{
+    if (stalled)
+        skipStalledCycles(clockEdge() == curTick() ? curCycle() :
+                          curCycle() - Cycles(1));
+
+    BaseO3CPU::preDumpStats();
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::tick()
@@ -512,6 +559,11 @@ FullO3CPU<Impl>::tick()
     assert(!switchedOut());
     assert(drainState() != DrainState::Drained);
 
+    if (stalled) {
+        skipStalledCycles(curCycle() - Cycles(1));
+        stalled = false;
+    }
+
     ++numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -551,6 +603,14 @@ FullO3CPU<Impl>::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             timesIdled++;
+        } else if (fastIdle && pipelineStalled()) {
+            DPRINTF(O3CPU, "Stalled on memory!\n");
+            stalled = true;
+            stallCycle = curCycle();
+
+            // The time buffers are left alone. The stalled stages write
+            // the same status to them every cycle, so they already hold
+            // what the skipped cycles would have left in them.
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -563,6 +623,56 @@ FullO3CPU<Impl>::tick()
     tryDrain();
 }
 
+template <class Impl>
+bool
+FullO3CPU<Impl>::pipelineStalled()
+{
+    // Only a single thread in SE mode, where nothing outside the memory
+    // system can change the state of a stalled pipeline without waking
+    // the CPU.
+    if (FullSystem || numThreads != 1 || activeThreads.size() != 1 ||
+        drainState() != DrainState::Running) {
+        return false;
+    }
+
+    // Wait until nothing sent between the stages is left in the time
+    // buffers, so that every stage sees the same inputs each cycle.
+    if (activityRec.recentActivity())
+        return false;
+
+    ThreadID tid = activeThreads.front();
+
+    return fetch.isStalled(tid) && decode.isStalled(tid) &&
+        rename.isStalled(tid) && iew.isStalled(tid) &&
+        commit.isStalled(tid);
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::skipStalledCycles(Cycles until)
+{
+    assert(stalled);
+
+    if (until <= stallCycle)
+        return;
+
+    Cycles cycles = until - stallCycle;
+    ThreadID tid = activeThreads.front();
+
+    DPRINTF(O3CPU, "Skipped %d stalled cycles.\n", cycles);
+
+    numCycles += cycles;
+    stalledCycles += cycles;
+
+    fetch.skipStalledCycles(tid, cycles);
+    decode.skipStalledCycles(tid, cycles);
+    rename.skipStalledCycles(tid, cycles);
+    iew.skipStalledCycles(tid, cycles);
+    commit.skipStalledCycles(tid, cycles);
+
+    stallCycle = until;
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::init()
@@ -712,6 +822,11 @@ FullO3CPU<Impl>::suspendContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Suspending Thread Context.\n", tid);
     assert(!switchedOut());
 
+    if (stalled) {
+        skipStalledCycles(curCycle() - Cycles(1));
+        stalled = false;
+    }
+
     deactivateThread(tid);
 
     // If this was the last thread then unschedule the tick event.
@@ -734,6 +849,11 @@ FullO3CPU<Impl>::haltContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Halt Context called. Deallocating\n", tid);
     assert(!switchedOut());
 
+    if (stalled) {
+        skipStalledCycles(curCycle() - Cycles(1));
+        stalled = false;
+    }
+
     deactivateThread(tid);
     removeThread(tid);
 
@@ -1500,9 +1620,7 @@ template <class Impl>
 typename FullO3CPU<Impl>::ListIt
 FullO3CPU<Impl>::addInst(const DynInstPtr &inst)
 {
-    instList.push_back(inst);
-
-    return --(instList.end());
+    return instList.push_back(inst);
 }
 
 template <class Impl>
@@ -1569,7 +1687,7 @@ FullO3CPU<Impl>::removeInstsNotInROB(ThreadID tid)
     inst_it--;
 
     // Walk through the instruction list, removing any instructions
-    // that were inserted after the given instruction iterator, end_it.
+    // that were inserted after the given instruction position, end_it.
     while (inst_it != end_it) {
         assert(!instList.empty());
 
@@ -1599,9 +1717,9 @@ FullO3CPU<Impl>::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 
     DPRINTF(O3CPU, "Deleting instructions from instruction "
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
-            tid, seq_num, (*inst_iter)->seqNum);
+            tid, seq_num, instList[inst_iter]->seqNum);
 
-    while ((*inst_iter)->seqNum > seq_num) {
+    while (!instList[inst_iter] || instList[inst_iter]->seqNum > seq_num) {
 
         bool break_loop = (inst_iter == instList.begin());
 
@@ -1616,17 +1734,20 @@ FullO3CPU<Impl>::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 
 template <class Impl>
 inline void
-FullO3CPU<Impl>::squashInstIt(const ListIt &instIt, ThreadID tid)
+FullO3CPU<Impl>::squashInstIt(ListIt instIt, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
+    const DynInstPtr &inst = instList[instIt];
+
+    // Skip the holes left by instructions removed in earlier cycles
+    if (inst && inst->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*instIt)->threadNumber,
-                (*instIt)->seqNum,
-                (*instIt)->pcState());
+                inst->threadNumber,
+                inst->seqNum,
+                inst->pcState());
 
         // Mark it as squashed.
-        (*instIt)->setSquashed();
+        inst->setSquashed();
 
         // @todo: Formulate a consistent method for deleting
         // instructions from the instruction list
@@ -1642,9 +1763,9 @@ FullO3CPU<Impl>::cleanUpRemovedInsts()
     while (!removeList.empty()) {
         DPRINTF(O3CPU, "Removing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*removeList.front())->threadNumber,
-                (*removeList.front())->seqNum,
-                (*removeList.front())->pcState());
+                instList[removeList.front()]->threadNumber,
+                instList[removeList.front()]->seqNum,
+                instList[removeList.front()]->pcState());
 
         instList.erase(removeList.front());
 
@@ -1672,12 +1793,14 @@ FullO3CPU<Impl>::dumpInsts()
     cprintf("Dumping Instruction List\n");
 
     while (inst_list_it != instList.end()) {
+        const DynInstPtr &inst = instList[inst_list_it++];
+        if (!inst)
+            continue;
         cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
                 "Squashed:%i\n\n",
-                num, (*inst_list_it)->instAddr(), (*inst_list_it)->threadNumber,
-                (*inst_list_it)->seqNum, (*inst_list_it)->isIssued(),
-                (*inst_list_it)->isSquashed());
-        inst_list_it++;
+                num, inst->instAddr(), inst->threadNumber,
+                inst->seqNum, inst->isIssued(),
+                inst->isSquashed());
         ++num;
     }
 }
@@ -1693,6 +1816,18 @@ template <class Impl>
 void
 FullO3CPU<Impl>::wakeCPU()
 {
+    if (stalled) {
+        // The next tick accounts for the cycles skipped while stalled.
+        // It cannot come earlier than the cycle after the last one
+        // accounted for.
+        if (!tickEvent.scheduled()) {
+            DPRINTF(Activity, "Waking up stalled CPU\n");
+            schedule(tickEvent, curCycle() > stallCycle ?
+                     clockEdge() : clockEdge(Cycles(1)));
+        }
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
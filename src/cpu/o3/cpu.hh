@@ -55,6 +55,8 @@
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/cpu_policy.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/o3/scoreboard.hh"
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
@@ -95,6 +97,7 @@ class FullO3CPU : public BaseO3CPU
   public:
     // Typedefs from the Impl here.
     typedef typename Impl::CPUPol CPUPolicy;
+    typedef typename Impl::DynInst DynInst;
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef typename Impl::O3CPU O3CPU;
 
@@ -106,7 +109,8 @@ class FullO3CPU : public BaseO3CPU
     typedef O3ThreadState<Impl> ImplState;
     typedef O3ThreadState<Impl> Thread;
 
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef InstRing<DynInstPtr> InstList;
+    typedef typename InstList::Pos ListIt;
 
     friend class O3ThreadContext<Impl>;
 
@@ -177,6 +181,23 @@ class FullO3CPU : public BaseO3CPU
     /** Check if a system is in a drained state. */
     bool isCpuDrained() const;
 
+    /**
+     * Check if the pipeline is stalled on memory and can stop ticking.
+     *
+     * This is the case when every stage would only count another stall
+     * cycle if it was ticked, and only a response from the memory system
+     * can change that. The fetch stage still being active would keep the
+     * CPU ticking until then otherwise.
+     */
+    bool pipelineStalled();
+
+    /**
+     * Account for the cycles the CPU did not tick while the pipeline was
+     * stalled, up to and including the given cycle, as if every stage had
+     * been ticked in its stalled state.
+     */
+    void skipStalledCycles(Cycles until);
+
   public:
     /** Constructs a CPU with the given parameters. */
     FullO3CPU(DerivO3CPUParams *params);
@@ -186,6 +207,10 @@ class FullO3CPU : public BaseO3CPU
     /** Registers statistics. */
     void regStats() override;
 
+    void resetStats() override;
+
+    void preDumpStats() override;
+
     ProbePointArg<PacketPtr> *ppInstAccessComplete;
     ProbePointArg<std::pair<DynInstPtr, PacketPtr> > *ppDataAccessComplete;
 
@@ -521,8 +546,8 @@ class FullO3CPU : public BaseO3CPU
     /** Remove all instructions younger than the given sequence number. */
     void removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid);
 
-    /** Removes the instruction pointed to by the iterator. */
-    inline void squashInstIt(const ListIt &instIt, ThreadID tid);
+    /** Removes the instruction at the given position. */
+    inline void squashInstIt(ListIt instIt, ThreadID tid);
 
     /** Cleans up all instructions on the remove list. */
     void cleanUpRemovedInsts();
@@ -531,13 +556,20 @@ class FullO3CPU : public BaseO3CPU
     void dumpInsts();
 
   public:
+    /** Storage for the dynamic instructions of this CPU. Instructions
+     * still referenced when the CPU is destroyed keep their slab alive.
+     */
+    DynInstPool<DynInst> dynInstPool;
+
 #ifndef NDEBUG
     /** Count of total number of dynamic instructions in flight. */
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** List of all the instructions in flight. Removing the instructions
+     *  of one thread from between those of others leaves holes in it.
+     */
+    InstList instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -655,7 +687,13 @@ class FullO3CPU : public BaseO3CPU
 
   public:
     /** Records that there was time buffer activity this cycle. */
-    void activityThisCycle() { activityRec.activity(); }
+    void activityThisCycle()
+    {
+        activityRec.activity();
+
+        if (stalled)
+            wakeCPU();
+    }
 
     /** Changes a stage's status to active within the activity recorder. */
     void activateStage(const StageIdx idx)
@@ -702,6 +740,15 @@ class FullO3CPU : public BaseO3CPU
     /** The cycle that the CPU was last running, used for statistics. */
     Cycles lastRunningCycle;
 
+    /** Whether to stop ticking while the pipeline is stalled on memory. */
+    const bool fastIdle;
+
+    /** Whether the CPU stopped ticking while the pipeline is stalled. */
+    bool stalled;
+
+    /** The last cycle accounted for while the pipeline is stalled. */
+    Cycles stallCycle;
+
     /** The cycle that the CPU was last activated by a new thread*/
     Tick lastActivatedCycle;
 
@@ -756,6 +803,9 @@ class FullO3CPU : public BaseO3CPU
     /** Stat for total number of cycles the CPU spends descheduled due to a
      * quiesce operation or waiting for an interrupt. */
     Stats::Scalar quiesceCycles;
+    /** Stat for the number of cycles skipped with fastIdle. These are
+     * also counted as ticked cycles by every other stat. */
+    Stats::Scalar stalledCycles;
     /** Stat for the number of committed instructions per thread. */
     Stats::Vector committedInsts;
     /** Stat for the number of committed ops (including micro ops) per thread. */
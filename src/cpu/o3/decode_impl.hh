@@ -213,6 +213,22 @@ DefaultDecode<Impl>::isDrained() const
     return true;
 }
 
+template <class Impl>
+bool
+DefaultDecode<Impl>::isStalled(ThreadID tid) const
+{
+    // Decode stays blocked for as long as rename does.
+    return decodeStatus[tid] == Blocked && checkStall(tid) &&
+        insts[tid].empty();
+}
+
+template <class Impl>
+void
+DefaultDecode<Impl>::skipStalledCycles(ThreadID tid, Cycles cycles)
+{
+    stats.blockedCycles += cycles;
+}
+
 template<class Impl>
 bool
 DefaultDecode<Impl>::checkStall(ThreadID tid) const
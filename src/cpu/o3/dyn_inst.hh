@@ -46,6 +46,7 @@
 
 #include "config/the_isa.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/isa_specific.hh"
 #include "cpu/base_dyn_inst.hh"
 #include "cpu/inst_seq.hh"
@@ -85,6 +86,27 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /** Instructions are allocated from the pool of their CPU. */
+    static void *
+    operator new(size_t size, DynInstPool<BaseO3DynInst> &pool)
+    {
+        return pool.allocate(size);
+    }
+
+    /** Only called if the constructor of a pooled instruction throws. */
+    static void
+    operator delete(void *ptr, DynInstPool<BaseO3DynInst> &pool)
+    {
+        DynInstPool<BaseO3DynInst>::release(ptr);
+    }
+
+    /** Returns the instruction to the pool it was allocated from. */
+    static void
+    operator delete(void *ptr)
+    {
+        DynInstPool<BaseO3DynInst>::release(ptr);
+    }
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * Per-CPU free list allocator for O3 dynamic instructions. Every fetched
+ * instruction, including the wrong-path ones that are squashed a few
+ * cycles later, is a DynInst, so allocating them from the host heap is a
+ * significant part of the O3 simulation cost. The pool carves
+ * instructions out of large slabs and recycles them through a LIFO free
+ * list, so the storage of a just retired or squashed instruction is
+ * reused by the next fetched one and usually still is in the host
+ * caches.
+ *
+ * The CPU reserves enough slots for all instructions that can be in
+ * flight at once. References to an instruction can outlive it in the
+ * pipeline (e.g. in probe listeners or outstanding packets), so the pool
+ * grows instead of failing when it runs out of slots.
+ *
+ * Each slot records its slab, and each slab its pool, which allows the
+ * class specific operator delete of the instruction to return it to the
+ * right CPU. Slabs count the instructions they hold. References can
+ * also outlive the CPU (e.g. in the checker), so a slab that still
+ * holds instructions when the pool is destroyed is detached from it and
+ * freed when its last instruction is released.
+ */
+template <class T>
+class DynInstPool
+{
+  private:
+    struct Slot;
+    struct Slab;
+
+    /** Number of slots allocated at once when the pool runs dry. */
+    static const size_t growSlots = 64;
+
+    /** Head of the list of unused slots. */
+    Slot *freeList;
+
+    /** All slabs of the pool. */
+    std::vector<Slab *> slabs;
+
+    /** Total number of slots. */
+    size_t numSlots;
+
+    /** Number of slots currently holding an instruction. */
+    size_t numUsed;
+
+    void grow(size_t count);
+
+  public:
+    DynInstPool() : freeList(nullptr), numSlots(0), numUsed(0) {}
+
+    ~DynInstPool();
+
+    DynInstPool(const DynInstPool &) = delete;
+    DynInstPool &operator=(const DynInstPool &) = delete;
+
+    /** Make sure at least count slots exist. */
+    void reserve(size_t count);
+
+    /** Total number of slots. */
+    size_t capacity() const { return numSlots; }
+
+    /** Number of instructions currently allocated from the pool. */
+    size_t size() const { return numUsed; }
+
+    /** Get storage for an instruction of the given size. */
+    void *allocate(size_t size);
+
+    /** Return the storage of an instruction to the pool it came from. */
+    static void release(void *ptr);
+};
+
+template <class T>
+struct DynInstPool<T>::Slot
+{
+    union
+    {
+        Slot *next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+    Slab *slab;
+};
+
+template <class T>
+struct DynInstPool<T>::Slab
+{
+    Slab(DynInstPool *_owner, size_t count)
+        : owner(_owner), used(0), slots(count)
+    {}
+
+    /** The pool of the slab, or nullptr once the pool is gone. */
+    DynInstPool *owner;
+
+    /** Number of slots of this slab holding an instruction. */
+    size_t used;
+
+    std::vector<Slot> slots;
+};
+
+template <class T>
+DynInstPool<T>::~DynInstPool()
+{
+    for (auto slab : slabs) {
+        if (slab->used == 0)
+            delete slab;
+        else
+            slab->owner = nullptr;
+    }
+}
+
+template <class T>
+void
+DynInstPool<T>::grow(size_t count)
+{
+    Slab *slab = new Slab(this, count);
+    slabs.push_back(slab);
+    numSlots += count;
+    // Thread the slab in address order so that instructions fetched back
+    // to back are adjacent in memory.
+    for (size_t i = count; i-- > 0; ) {
+        Slot &slot = slab->slots[i];
+        slot.slab = slab;
+        slot.next = freeList;
+        freeList = &slot;
+    }
+}
+
+template <class T>
+void
+DynInstPool<T>::reserve(size_t count)
+{
+    if (count > numSlots)
+        grow(count - numSlots);
+}
+
+template <class T>
+void *
+DynInstPool<T>::allocate(size_t size)
+{
+    panic_if(size != sizeof(T),
+             "DynInstPool only holds objects of %d bytes, not %d.",
+             sizeof(T), size);
+
+    if (!freeList)
+        grow(growSlots);
+    Slot *slot = freeList;
+    freeList = slot->next;
+    ++slot->slab->used;
+    ++numUsed;
+    return &slot->storage;
+}
+
+template <class T>
+void
+DynInstPool<T>::release(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    // The storage is the first member of a slot.
+    Slot *slot = reinterpret_cast<Slot *>(ptr);
+    Slab *slab = slot->slab;
+    assert(slab->used > 0);
+    --slab->used;
+
+    DynInstPool *pool = slab->owner;
+    if (pool) {
+        slot->next = pool->freeList;
+        pool->freeList = slot;
+        --pool->numUsed;
+    } else if (slab->used == 0) {
+        // Last instruction of a slab that outlived its CPU
+        delete slab;
+    }
+}
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+namespace {
+
+struct Inst
+{
+    uint64_t payload[8];
+};
+
+} // anonymous namespace
+
+TEST(DynInstPoolTest, Reserve)
+{
+    DynInstPool<Inst> pool;
+    EXPECT_EQ(pool.capacity(), 0);
+    pool.reserve(100);
+    EXPECT_EQ(pool.capacity(), 100);
+    // Reserving less than the capacity does nothing
+    pool.reserve(10);
+    EXPECT_EQ(pool.capacity(), 100);
+    EXPECT_EQ(pool.size(), 0);
+}
+
+/** A released slot is the next one handed out. */
+TEST(DynInstPoolTest, ReuseLastReleased)
+{
+    DynInstPool<Inst> pool;
+    pool.reserve(4);
+    void *a = pool.allocate(sizeof(Inst));
+    void *b = pool.allocate(sizeof(Inst));
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool.size(), 2);
+
+    DynInstPool<Inst>::release(a);
+    EXPECT_EQ(pool.size(), 1);
+    EXPECT_EQ(pool.allocate(sizeof(Inst)), a);
+
+    DynInstPool<Inst>::release(a);
+    DynInstPool<Inst>::release(b);
+    DynInstPool<Inst>::release(nullptr);
+    EXPECT_EQ(pool.size(), 0);
+}
+
+/** The pool grows when all reserved slots are in use. */
+TEST(DynInstPoolTest, Grow)
+{
+    DynInstPool<Inst> pool;
+    pool.reserve(8);
+    std::set<void *> slots;
+    for (int i = 0; i < 100; i++)
+        slots.insert(pool.allocate(sizeof(Inst)));
+    EXPECT_EQ(slots.size(), 100);
+    EXPECT_EQ(pool.size(), 100);
+    EXPECT_GE(pool.capacity(), 100);
+    for (auto slot : slots)
+        DynInstPool<Inst>::release(slot);
+    EXPECT_EQ(pool.size(), 0);
+}
+
+/** Slots are returned to the pool they were allocated from. */
+TEST(DynInstPoolTest, TwoPools)
+{
+    DynInstPool<Inst> pool1, pool2;
+    void *a = pool1.allocate(sizeof(Inst));
+    void *b = pool2.allocate(sizeof(Inst));
+    DynInstPool<Inst>::release(a);
+    EXPECT_EQ(pool1.size(), 0);
+    EXPECT_EQ(pool2.size(), 1);
+    DynInstPool<Inst>::release(b);
+    EXPECT_EQ(pool2.size(), 0);
+}
+
+TEST(DynInstPoolTest, WrongSize)
+{
+    DynInstPool<Inst> pool;
+    EXPECT_ANY_THROW(pool.allocate(sizeof(Inst) + 1));
+}
+
+/**
+ * Instructions can be released after the pool that allocated them is
+ * gone, e.g. when a probe listener outlives the CPU.
+ */
+TEST(DynInstPoolTest, ReleaseAfterPool)
+{
+    std::vector<void *> kept;
+    {
+        DynInstPool<Inst> pool;
+        pool.reserve(4);
+        for (int i = 0; i < 70; i++) {
+            void *slot = pool.allocate(sizeof(Inst));
+            static_cast<Inst *>(slot)->payload[0] = i;
+            kept.push_back(slot);
+        }
+        // Leave one slab without instructions
+        for (int i = 0; i < 4; i++) {
+            DynInstPool<Inst>::release(kept.front());
+            kept.erase(kept.begin());
+        }
+    }
+    for (size_t i = 0; i < kept.size(); i++)
+        EXPECT_EQ(static_cast<Inst *>(kept[i])->payload[0], i + 4);
+    for (auto slot : kept)
+        DynInstPool<Inst>::release(slot);
+}
@@ -256,6 +256,14 @@ class DefaultFetch
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Would ticking the stage only count another stall cycle? */
+    bool isStalled(ThreadID tid) const;
+
+    /** Counts the given number of cycles in which the stage was stalled
+     * without being ticked.
+     */
+    void skipStalledCycles(ThreadID tid, Cycles cycles);
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -368,7 +376,7 @@ class DefaultFetch
     void fetch(bool &status_change);
 
     /** Align a PC to the start of a fetch buffer block. */
-    Addr fetchBufferAlignPC(Addr addr)
+    Addr fetchBufferAlignPC(Addr addr) const
     {
         return (addr & ~(fetchBufferMask));
     }
@@ -452,6 +452,42 @@ DefaultFetch<Impl>::isDrained() const
     return !finishTranslationEvent.scheduled();
 }
 
+template <class Impl>
+bool
+DefaultFetch<Impl>::isStalled(ThreadID tid) const
+{
+    // Fetch keeps running while decode is blocked, until the fetch queue
+    // is full. It then neither fetches a new cache line nor pipelines
+    // the next access as long as the fetch buffer holds the current PC.
+    if (fetchStatus[tid] != Running || !stalls[tid].decode ||
+        stalls[tid].drain || fetchQueue[tid].size() < fetchQueueSize) {
+        return false;
+    }
+
+    if (macroop[tid])
+        return true;
+
+    Addr fetch_addr = (pc[tid].instAddr() + fetchOffset[tid]) &
+        BaseCPU::PCMask;
+
+    return fetchBufferValid[tid] &&
+        fetchBufferAlignPC(fetch_addr) == fetchBufferPC[tid];
+}
+
+template <class Impl>
+void
+DefaultFetch<Impl>::skipStalledCycles(ThreadID tid, Cycles cycles)
+{
+    fetchStats.cycles += cycles;
+    fetchStats.nisnDist.sample(0, cycles);
+
+    // Every tick picks a thread to send instructions to decode from, and
+    // that uses a random number even with a single thread. Use them up so
+    // other users of random_mt see the same sequence.
+    for (Cycles i(0); i < cycles; ++i)
+        random_mt.random<uint8_t>(0, 0);
+}
+
 template <class Impl>
 void
 DefaultFetch<Impl>::takeOverFrom()
@@ -1075,7 +1111,8 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction =
-        new DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
+        new (cpu->dynInstPool)
+            DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
     instruction->setTid(tid);
 
     instruction->setThreadState(cpu->thread[tid]);
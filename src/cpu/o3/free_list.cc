@@ -40,6 +40,14 @@ UnifiedFreeList::UnifiedFreeList(const std::string &_my_name,
 {
     DPRINTF(FreeList, "Creating new free list object.\n");
 
+    // Size the per-class bitmaps before any register is handed to them
+    intList.init(regFile->getRegIds(IntRegClass));
+    floatList.init(regFile->getRegIds(FloatRegClass));
+    vecList.init(regFile->getRegIds(VecRegClass));
+    vecElemList.init(regFile->getRegIds(VecElemClass));
+    predList.init(regFile->getRegIds(VecPredRegClass));
+    ccList.init(regFile->getRegIds(CCRegClass));
+
     // Have the register file initialize the free list since it knows
     // about its internal organization
     regFile->initFreeList(this);
@@ -42,10 +42,12 @@
 #ifndef __CPU_O3_FREE_LIST_HH__
 #define __CPU_O3_FREE_LIST_HH__
 
+#include <algorithm>
 #include <iostream>
-#include <queue>
+#include <iterator>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/o3/comm.hh"
@@ -58,44 +60,141 @@
  * determined by the rename map instance being accessed, all
  * architectural register index parameters and values in this class
  * are relative (e.g., %fp2 is just index 2).
+ *
+ * Note that registers are handed out lowest index first, not in the
+ * order they were freed.
  */
 class SimpleFreeList
 {
   private:
 
-    /** The actual free list */
-    std::queue<PhysRegIdPtr> freeRegs;
+    /** First register of the contiguous range managed by this list. */
+    PhysRegIdPtr firstReg;
+
+    /** Number of registers in the range managed by this list. */
+    unsigned numRegs;
+
+    /**
+     * The actual free list, one bit per register in the range. A set
+     * bit means the register is free. Allocation always returns the
+     * lowest free register, so a single bit-scan per word replaces the
+     * queue traversal.
+     */
+    std::vector<uint64_t> freeBits;
+
+    /** Number of set bits in freeBits. */
+    unsigned numFree;
+
+    /** Index of the lowest word that may contain a set bit. */
+    unsigned firstWord;
 
   public:
 
-    SimpleFreeList() {};
+    SimpleFreeList()
+        : firstReg(nullptr), numRegs(0), numFree(0), firstWord(0)
+    {}
+
+    /**
+     * Size the list for a contiguous range of physical registers. All
+     * registers start out allocated; use addRegs() to free them.
+     */
+    void
+    init(PhysRegFile::IdRange range)
+    {
+        numRegs = std::distance(range.first, range.second);
+        firstReg = numRegs ? &*range.first : nullptr;
+        freeBits.assign((numRegs + 63) / 64, 0);
+        numFree = 0;
+        firstWord = freeBits.size();
+    }
 
     /** Add a physical register to the free list */
-    void addReg(PhysRegIdPtr reg) { freeRegs.push(reg); }
+    void
+    addReg(PhysRegIdPtr reg)
+    {
+        assert(reg >= firstReg && reg < firstReg + numRegs);
+        const unsigned idx = reg - firstReg;
+        const uint64_t mask = 1ULL << (idx % 64);
+        uint64_t &word = freeBits[idx / 64];
+
+        // A register can only be on the list once, so freeing it
+        // twice no longer inflates the pool.
+        assert(!(word & mask));
+        if (word & mask)
+            return;
+
+        word |= mask;
+        numFree++;
+        firstWord = std::min(firstWord, idx / 64);
+    }
 
     /** Add physical registers to the free list */
     template<class InputIt>
     void
     addRegs(InputIt first, InputIt last) {
         std::for_each(first, last, [this](typename InputIt::value_type& reg) {
-            this->freeRegs.push(&reg);
+            this->addReg(&reg);
         });
     }
 
     /** Get the next available register from the free list */
     PhysRegIdPtr getReg()
     {
-        assert(!freeRegs.empty());
-        PhysRegIdPtr free_reg = freeRegs.front();
-        freeRegs.pop();
-        return free_reg;
+        assert(numFree);
+        while (!freeBits[firstWord])
+            firstWord++;
+
+        uint64_t &word = freeBits[firstWord];
+        const unsigned bit = findLsbSet(word);
+        word &= ~(1ULL << bit);
+        numFree--;
+
+        return firstReg + firstWord * 64 + bit;
+    }
+
+    /** A copy of the free bitmap, used to checkpoint the list. */
+    using Snapshot = std::vector<uint64_t>;
+
+    /** Copy the current free bitmap into a snapshot. */
+    void save(Snapshot &snap) const { snap = freeBits; }
+
+    /** Mark a register as free in a snapshot. */
+    void
+    markFree(Snapshot &snap, PhysRegIdPtr reg) const
+    {
+        assert(reg >= firstReg && reg < firstReg + numRegs);
+        const unsigned idx = reg - firstReg;
+        snap[idx / 64] |= 1ULL << (idx % 64);
+    }
+
+    /**
+     * Free every register that is free in a snapshot but not on the
+     * list, a word at a time.
+     *
+     * @return The number of registers freed.
+     */
+    unsigned
+    restore(const Snapshot &snap)
+    {
+        assert(snap.size() == freeBits.size());
+        unsigned freed = 0;
+        for (unsigned i = 0; i < freeBits.size(); i++) {
+            const uint64_t diff = snap[i] & ~freeBits[i];
+            if (diff) {
+                freeBits[i] |= diff;
+                freed += popCount(diff);
+                firstWord = std::min(firstWord, i);
+            }
+        }
+        numFree += freed;
+        return freed;
     }
 
     /** Return the number of free registers on the list. */
-    unsigned numFreeRegs() const { return freeRegs.size(); }
+    unsigned numFreeRegs() const { return numFree; }
 
     /** True iff there are free registers on the list. */
-    bool hasFreeRegs() const { return !freeRegs.empty(); }
+    bool hasFreeRegs() const { return numFree != 0; }
 };
 
 
@@ -192,6 +291,34 @@ class UnifiedFreeList
     /** Adds a register back to the free list. */
     void addReg(PhysRegIdPtr freed_reg);
 
+    /** Snapshot of all the per-class free lists. */
+    struct Checkpoint
+    {
+        SimpleFreeList::Snapshot intList;
+        SimpleFreeList::Snapshot floatList;
+        SimpleFreeList::Snapshot vecList;
+        SimpleFreeList::Snapshot vecElemList;
+        SimpleFreeList::Snapshot predList;
+        SimpleFreeList::Snapshot ccList;
+    };
+
+    /** Save the current state of all the lists into a checkpoint. */
+    void checkpoint(Checkpoint &cp) const;
+
+    /**
+     * Mark a register as free in a checkpoint, e.g. when an instruction
+     * older than the checkpoint commits and frees its previous mapping.
+     */
+    void markFree(Checkpoint &cp, PhysRegIdPtr reg) const;
+
+    /**
+     * Free all the registers that are free in a checkpoint but not on
+     * the lists, i.e. those allocated since the checkpoint was taken.
+     *
+     * @return The number of registers freed.
+     */
+    unsigned restore(const Checkpoint &cp);
+
     /** Adds a register back to the free list. */
     template<class InputIt>
     void addRegs(InputIt first, InputIt last);
@@ -297,8 +424,6 @@ UnifiedFreeList::addReg(PhysRegIdPtr freed_reg)
 {
     DPRINTF(FreeList,"Freeing register %i (%s).\n", freed_reg->index(),
             freed_reg->className());
-    //Might want to add in a check for whether or not this register is
-    //already in there.  A bit vector or something similar would be useful.
     switch (freed_reg->classValue()) {
         case IntRegClass:
             intList.addReg(freed_reg);
@@ -322,19 +447,56 @@ UnifiedFreeList::addReg(PhysRegIdPtr freed_reg)
             panic("Unexpected RegClass (%s)",
                                    freed_reg->className());
     }
+}
 
-    // These assert conditions ensure that the number of free
-    // registers are not more than the # of total Physical  Registers.
-    // If this were false, it would mean that registers
-    // have been freed twice, overflowing the free register
-    // pool and potentially crashing SMT workloads.
-    // ----
-    // Comment out for now so as to not potentially break
-    // CMP and single-threaded workloads
-    // ----
-    // assert(freeIntRegs.size() <= numPhysicalIntRegs);
-    // assert(freeFloatRegs.size() <= numPhysicalFloatRegs);
+
+inline void
+UnifiedFreeList::checkpoint(Checkpoint &cp) const
+{
+    intList.save(cp.intList);
+    floatList.save(cp.floatList);
+    vecList.save(cp.vecList);
+    vecElemList.save(cp.vecElemList);
+    predList.save(cp.predList);
+    ccList.save(cp.ccList);
 }
 
+inline void
+UnifiedFreeList::markFree(Checkpoint &cp, PhysRegIdPtr reg) const
+{
+    switch (reg->classValue()) {
+        case IntRegClass:
+            intList.markFree(cp.intList, reg);
+            break;
+        case FloatRegClass:
+            floatList.markFree(cp.floatList, reg);
+            break;
+        case VecRegClass:
+            vecList.markFree(cp.vecList, reg);
+            break;
+        case VecElemClass:
+            vecElemList.markFree(cp.vecElemList, reg);
+            break;
+        case VecPredRegClass:
+            predList.markFree(cp.predList, reg);
+            break;
+        case CCRegClass:
+            ccList.markFree(cp.ccList, reg);
+            break;
+        default:
+            panic("Unexpected RegClass (%s)", reg->className());
+    }
+}
+
+inline unsigned
+UnifiedFreeList::restore(const Checkpoint &cp)
+{
+    return intList.restore(cp.intList) +
+        floatList.restore(cp.floatList) +
+        vecList.restore(cp.vecList) +
+        vecElemList.restore(cp.vecElemList) +
+        predList.restore(cp.predList) +
+        ccList.restore(cp.ccList);
+}
 
 #endif // __CPU_O3_FREE_LIST_HH__
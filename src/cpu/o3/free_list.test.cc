@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpu/o3/free_list.hh"
+
+namespace {
+
+/** A range of physical integer registers to hand to a free list. */
+std::vector<PhysRegId>
+makeRegs(unsigned num_regs)
+{
+    std::vector<PhysRegId> regs;
+    for (unsigned i = 0; i < num_regs; i++)
+        regs.emplace_back(IntRegClass, i, i);
+    return regs;
+}
+
+} // anonymous namespace
+
+/** Registers are handed out lowest index first. */
+TEST(SimpleFreeListTest, LowestFirst)
+{
+    auto regs = makeRegs(130);
+    SimpleFreeList list;
+    list.init({regs.begin(), regs.end()});
+    EXPECT_FALSE(list.hasFreeRegs());
+
+    list.addRegs(regs.begin(), regs.end());
+    EXPECT_EQ(list.numFreeRegs(), 130);
+
+    for (unsigned i = 0; i < 130; i++)
+        EXPECT_EQ(list.getReg(), &regs[i]);
+    EXPECT_FALSE(list.hasFreeRegs());
+
+    list.addReg(&regs[129]);
+    list.addReg(&regs[70]);
+    list.addReg(&regs[3]);
+    EXPECT_EQ(list.getReg(), &regs[3]);
+    EXPECT_EQ(list.getReg(), &regs[70]);
+    EXPECT_EQ(list.getReg(), &regs[129]);
+}
+
+/** Restoring a snapshot frees the registers allocated since it was saved. */
+TEST(SimpleFreeListTest, SaveRestore)
+{
+    auto regs = makeRegs(200);
+    SimpleFreeList list;
+    list.init({regs.begin(), regs.end()});
+    list.addRegs(regs.begin() + 100, regs.end());
+
+    SimpleFreeList::Snapshot snap;
+    list.save(snap);
+
+    std::vector<PhysRegIdPtr> allocated;
+    for (unsigned i = 0; i < 80; i++)
+        allocated.push_back(list.getReg());
+    EXPECT_EQ(list.numFreeRegs(), 20);
+
+    // Registers freed after the snapshot stay free
+    list.addReg(allocated[5]);
+    EXPECT_EQ(list.restore(snap), 79);
+    EXPECT_EQ(list.numFreeRegs(), 100);
+
+    // Restoring again is a no-op
+    EXPECT_EQ(list.restore(snap), 0);
+
+    for (unsigned i = 100; i < 200; i++)
+        EXPECT_EQ(list.getReg(), &regs[i]);
+    EXPECT_FALSE(list.hasFreeRegs());
+}
+
+/**
+ * A register freed by a commit older than the snapshot is also free
+ * after the restore, and the restore does not free it a second time.
+ */
+TEST(SimpleFreeListTest, MarkFree)
+{
+    auto regs = makeRegs(64);
+    SimpleFreeList list;
+    list.init({regs.begin(), regs.end()});
+    list.addRegs(regs.begin() + 32, regs.end());
+
+    SimpleFreeList::Snapshot snap;
+    list.save(snap);
+    PhysRegIdPtr a = list.getReg();
+    EXPECT_EQ(a, &regs[32]);
+
+    // Register 0 was allocated before the snapshot, and is freed by an
+    // older instruction committing after it was taken
+    list.addReg(&regs[0]);
+    list.markFree(snap, &regs[0]);
+
+    EXPECT_EQ(list.restore(snap), 1);
+    EXPECT_EQ(list.numFreeRegs(), 33);
+    EXPECT_EQ(list.getReg(), &regs[0]);
+    EXPECT_EQ(list.getReg(), &regs[32]);
+}
@@ -169,6 +169,14 @@ class DefaultIEW
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Would ticking the stage only count another stall cycle? */
+    bool isStalled(ThreadID tid);
+
+    /** Counts the given number of cycles in which the stage was stalled
+     * without being ticked.
+     */
+    void skipStalledCycles(ThreadID tid, Cycles cycles);
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -417,6 +417,34 @@ DefaultIEW<Impl>::isDrained() const
     return drained;
 }
 
+template <class Impl>
+bool
+DefaultIEW<Impl>::isStalled(ThreadID tid)
+{
+    // Nothing to dispatch, issue, execute or write back until an access
+    // completes or the IQ frees entries.
+    if (_status != Inactive || exeStatus != Idle || updateLSQNextCycle ||
+        fromIssue->size || !insts[tid].empty()) {
+        return false;
+    }
+
+    if (dispatchStatus[tid] == Blocked)
+        return checkStall(tid);
+
+    return dispatchStatus[tid] == Running || dispatchStatus[tid] == Idle;
+}
+
+template <class Impl>
+void
+DefaultIEW<Impl>::skipStalledCycles(ThreadID tid, Cycles cycles)
+{
+    if (dispatchStatus[tid] == Blocked)
+        iewBlockCycles += cycles;
+
+    instQueue.skipStalledCycles(cycles);
+    instQueue.intInstQueueReads += cycles;
+}
+
 template <class Impl>
 void
 DefaultIEW<Impl>::drainSanityCheck() const
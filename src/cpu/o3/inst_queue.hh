@@ -49,10 +49,13 @@
 
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/o3/age_matrix.hh"
 #include "cpu/o3/dep_graph.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQSelectPolicy.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -93,6 +96,8 @@ class InstructionQueue
     // Typedef of iterator through the list of instructions.
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
+    typedef InstRing<DynInstPtr> InstList;
+
     /** FU completion event class. */
     class FUCompletion : public Event {
       private:
@@ -216,6 +221,11 @@ class InstructionQueue
      */
     void scheduleReadyInsts();
 
+    /** Counts the given number of cycles in which nothing was ready to
+     * be scheduled and the IQ was not asked to schedule anything.
+     */
+    void skipStalledCycles(Cycles cycles);
+
     /** Schedules a single specific non-speculative instruction. */
     void scheduleNonSpec(const InstSeqNum &inst);
 
@@ -307,8 +317,11 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Issued instructions stay in it until they commit, so it is sized
+     *  like the ROB and grows if more are on their way to commit.
+     */
+    InstList instList[Impl::MaxThreads];
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -393,6 +406,17 @@ class InstructionQueue
      */
     void moveToYoungerInst(ListOrderIt age_order_it);
 
+    /** How the oldest ready instructions are selected for issue. */
+    IQSelectPolicy selectPolicy;
+
+    /** Ready instructions when selecting with an age matrix instead of the
+     *  ready queues and age order list above.
+     */
+    AgeMatrix<DynInstPtr> readyMatrix;
+
+    /** Slots that may still issue in the current cycle. */
+    typename AgeMatrix<DynInstPtr>::SlotSet selectCandidates;
+
     DependencyGraph<DynInstPtr> dependGraph;
 
     //////////////////////////////////////
@@ -454,6 +478,27 @@ class InstructionQueue
     /** Moves an instruction to the ready queue if it is ready. */
     void addIfReady(const DynInstPtr &inst);
 
+    /** Adds an instruction to the ready instructions of its op class. */
+    void addToReadyList(const DynInstPtr &inst);
+
+    /** Selects from the ready queues in age order of their oldest
+     *  instructions and issues. Returns the number issued.
+     */
+    int scheduleFromReadyQueues(IssueStruct *i2e_info);
+
+    /** Selects from the age matrix and issues. Returns the number issued.
+     */
+    int scheduleFromAgeMatrix(IssueStruct *i2e_info);
+
+    /** Records an IQ read by select. */
+    void countIQRead(const DynInstPtr &inst);
+
+    /** Issues a selected instruction if there is a FU available for it.
+     *  Returns false if all FUs for its op class are busy.
+     */
+    bool issueReadyInst(const DynInstPtr &issuing_inst, OpClass op_class,
+                        IssueStruct *i2e_info);
+
     /** Debugging function to count how many entries are in the IQ.  It does
      *  a linear walk through the instructions, so do not call this function
      *  during normal execution.
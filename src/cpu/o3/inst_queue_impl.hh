@@ -87,6 +87,8 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params->fuPool),
+      selectPolicy(params->iqSelectPolicy),
+      readyMatrix(params->numIQEntries),
       iqPolicy(params->smtIQPolicy),
       numEntries(params->numIQEntries),
       totalWidth(params->issueWidth),
@@ -117,6 +119,10 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
         memDepUnit[tid].setIQ(this);
     }
 
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        instList[tid] = InstList(params->numROBEntries);
+    }
+
     resetState();
 
     //Figure out resource sharing policy
@@ -421,6 +427,7 @@ InstructionQueue<Impl>::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
+    readyMatrix.clear();
     nonSpecInsts.clear();
     listOrder.clear();
     deferredMemInsts.clear();
@@ -559,7 +566,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!listOrder.empty() || !readyMatrix.empty()) {
         return true;
     }
 
@@ -787,6 +794,38 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
+    int total_issued;
+    if (selectPolicy == IQSelectPolicy::AgeMatrix) {
+        total_issued = scheduleFromAgeMatrix(i2e_info);
+    } else {
+        total_issued = scheduleFromReadyQueues(i2e_info);
+    }
+
+    numIssuedDist.sample(total_issued);
+    iqInstsIssued+= total_issued;
+
+    // If we issued any instructions, tell the CPU we had activity.
+    // @todo If the way deferred memory instructions are handeled due to
+    // translation changes then the deferredMemInsts condition should be removed
+    // from the code below.
+    if (total_issued || !retryMemInsts.empty() || !deferredMemInsts.empty()) {
+        cpu->activityThisCycle();
+    } else {
+        DPRINTF(IQ, "Not able to schedule any instructions.\n");
+    }
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::skipStalledCycles(Cycles cycles)
+{
+    numIssuedDist.sample(0, cycles);
+}
+
+template <class Impl>
+int
+InstructionQueue<Impl>::scheduleFromReadyQueues(IssueStruct *i2e_info)
+{
     // Have iterator to head of the list
     // While I haven't exceeded bandwidth or reached the end of the list,
     // Try to get a FU that can do what this op needs.
@@ -806,13 +845,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
 
         DynInstPtr issuing_inst = readyInsts[op_class].top();
 
-        if (issuing_inst->isFloating()) {
-            fpInstQueueReads++;
-        } else if (issuing_inst->isVector()) {
-            vecInstQueueReads++;
-        } else {
-            intInstQueueReads++;
-        }
+        countIQRead(issuing_inst);
 
         assert(issuing_inst->seqNum == (*order_it).oldestInst);
 
@@ -833,60 +866,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                vecAluAccesses++;
-            } else {
-                intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%llu]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueReadyInst(issuing_inst, op_class, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -896,44 +876,167 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
+            listOrder.erase(order_it++);
+        } else {
+            ++order_it;
+        }
+    }
 
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
+    return total_issued;
+}
+
+template <class Impl>
+int
+InstructionQueue<Impl>::scheduleFromAgeMatrix(IssueStruct *i2e_info)
+{
+    // Repeatedly select the oldest candidate. When no FU is free for an
+    // instruction, none of the younger instructions of its op class can
+    // issue this cycle either, so the whole op class is dropped from the
+    // candidates. This issues the same instructions as walking the ready
+    // queues in age order of their oldest instructions.
+    int total_issued = 0;
+    selectCandidates = readyMatrix.slots();
+
+    while (total_issued < totalWidth) {
+        int slot = readyMatrix.oldest(selectCandidates);
+        if (slot < 0)
+            break;
+
+        DynInstPtr issuing_inst = readyMatrix[slot];
+        OpClass op_class = issuing_inst->opClass();
+
+        countIQRead(issuing_inst);
+
+        if (issuing_inst->isSquashed()) {
+            readyMatrix.remove(slot);
+            AgeMatrix<DynInstPtr>::unselect(selectCandidates, slot);
+
+            ++iqSquashedInstsIssued;
+
+            continue;
+        }
+
+        if (issueReadyInst(issuing_inst, op_class, i2e_info)) {
+            readyMatrix.remove(slot);
+            AgeMatrix<DynInstPtr>::unselect(selectCandidates, slot);
+
+            ++total_issued;
+        } else {
+            for (int w = 0; w < selectCandidates.size(); w++) {
+                for (uint64_t bits = selectCandidates[w]; bits;
+                     bits &= bits - 1) {
+                    int other = w * 64 + findLsbSet(bits);
+                    if (readyMatrix[other]->opClass() == op_class) {
+                        AgeMatrix<DynInstPtr>::unselect(selectCandidates,
+                                                        other);
+                    }
+                }
             }
+        }
+    }
 
-            listOrder.erase(order_it++);
-            statIssuedInstType[tid][op_class]++;
+    return total_issued;
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::countIQRead(const DynInstPtr &inst)
+{
+    if (inst->isFloating()) {
+        fpInstQueueReads++;
+    } else if (inst->isVector()) {
+        vecInstQueueReads++;
+    } else {
+        intInstQueueReads++;
+    }
+}
+
+template <class Impl>
+bool
+InstructionQueue<Impl>::issueReadyInst(const DynInstPtr &issuing_inst,
+                                       OpClass op_class,
+                                       IssueStruct *i2e_info)
+{
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            vecAluAccesses++;
         } else {
-            statFuBusy[op_class]++;
-            fuBusy[tid]++;
-            ++order_it;
+            intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
         }
     }
 
-    numIssuedDist.sample(total_issued);
-    iqInstsIssued+= total_issued;
+    // If we have an instruction that doesn't require a FU, or a
+    // valid FU, then schedule for execution.
+    if (idx == FUPool::NoFreeFU) {
+        statFuBusy[op_class]++;
+        fuBusy[tid]++;
+        return false;
+    }
 
-    // If we issued any instructions, tell the CPU we had activity.
-    // @todo If the way deferred memory instructions are handeled due to
-    // translation changes then the deferredMemInsts condition should be removed
-    // from the code below.
-    if (total_issued || !retryMemInsts.empty() || !deferredMemInsts.empty()) {
-        cpu->activityThisCycle();
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
     } else {
-        DPRINTF(IQ, "Not able to schedule any instructions.\n");
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
     }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%llu]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
+    }
+
+    statIssuedInstType[tid][op_class]++;
+
+    return true;
 }
 
 template <class Impl>
@@ -971,11 +1074,8 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
@@ -1088,17 +1188,7 @@ InstructionQueue<Impl>::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    addToReadyList(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1209,19 +1299,15 @@ template <class Impl>
 void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, starting at the tail.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = instList[tid].back();
         if (squashed_inst->isFloating()) {
             fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1230,13 +1316,10 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             intInstQueueWrites++;
         }
 
-        // Only handle the instruction if it actually is in the IQ and
-        // hasn't already been squashed in the IQ.
-        if (squashed_inst->threadNumber != tid ||
-            squashed_inst->isSquashedInIQ()) {
-            --squash_it;
-            continue;
-        }
+        // The list only holds instructions of this thread, and the ones
+        // squashed in the IQ are removed from it right below.
+        assert(squashed_inst->threadNumber == tid &&
+               !squashed_inst->isSquashedInIQ());
 
         if (!squashed_inst->isIssued() ||
             (squashed_inst->isMemRef() &&
@@ -1343,7 +1426,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
+        instList[tid].pop_back();
         ++iqSquashedInstsExamined;
     }
 }
@@ -1458,17 +1541,31 @@ InstructionQueue<Impl>::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
+        addToReadyList(inst);
+    }
+}
 
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+template <class Impl>
+void
+InstructionQueue<Impl>::addToReadyList(const DynInstPtr &inst)
+{
+    if (selectPolicy == IQSelectPolicy::AgeMatrix) {
+        readyMatrix.insert(inst);
+        return;
+    }
+
+    OpClass op_class = inst->opClass();
+
+    readyInsts[op_class].push(inst);
+
+    // Will need to reorder the list if either a queue is not on the list,
+    // or it has an older instruction than last time.
+    if (!queueOnList[op_class]) {
+        addToOrderList(op_class);
+    } else if (readyInsts[op_class].top()->seqNum  <
+               (*readyIt[op_class]).oldestInst) {
+        listOrder.erase(readyIt[op_class]);
+        addToOrderList(op_class);
     }
 }
 
@@ -1489,6 +1586,8 @@ InstructionQueue<Impl>::dumpLists()
         cprintf("\n");
     }
 
+    cprintf("Age matrix size: %i\n", readyMatrix.size());
+
     cprintf("Non speculative list size: %i\n", nonSpecInsts.size());
 
     NonSpecMapIt non_spec_it = nonSpecInsts.begin();
@@ -1529,16 +1628,18 @@ InstructionQueue<Impl>::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        typename InstList::Pos inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
+            const DynInstPtr &inst = instList[tid][inst_list_it];
+
             cprintf("Instruction:%i\n", num);
-            if (!(*inst_list_it)->isSquashed()) {
-                if (!(*inst_list_it)->isIssued()) {
+            if (!inst->isSquashed()) {
+                if (!inst->isIssued()) {
                     ++valid_num;
                     cprintf("Count:%i\n", valid_num);
-                } else if ((*inst_list_it)->isMemRef() &&
-                           !(*inst_list_it)->memOpDone()) {
+                } else if (inst->isMemRef() &&
+                           !inst->memOpDone()) {
                     // Loads that have not been marked as executed
                     // still count towards the total instructions.
                     ++valid_num;
@@ -1548,14 +1649,14 @@ InstructionQueue<Impl>::dumpInsts()
 
             cprintf("PC: %s\n[sn:%llu]\n[tid:%i]\n"
                     "Issued:%i\nSquashed:%i\n",
-                    (*inst_list_it)->pcState(),
-                    (*inst_list_it)->seqNum,
-                    (*inst_list_it)->threadNumber,
-                    (*inst_list_it)->isIssued(),
-                    (*inst_list_it)->isSquashed());
-
-            if ((*inst_list_it)->isMemRef()) {
-                cprintf("MemOpDone:%i\n", (*inst_list_it)->memOpDone());
+                    inst->pcState(),
+                    inst->seqNum,
+                    inst->threadNumber,
+                    inst->isIssued(),
+                    inst->isSquashed());
+
+            if (inst->isMemRef()) {
+                cprintf("MemOpDone:%i\n", inst->memOpDone());
             }
 
             cprintf("\n");
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_RING_HH__
+#define __CPU_O3_INST_RING_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "cpu/inst_seq.hh"
+
+/**
+ * Growable circular array holding in-flight instructions in increasing
+ * sequence number order. The CPU instruction list, the ROB and the IQ
+ * keep their instructions in one. Instructions are added at the tail and
+ * almost always leave from the head when they commit or from the tail
+ * when they are squashed, which only moves an index and reuses the
+ * storage instead of allocating a list node per instruction.
+ *
+ * Entries are addressed by position. Positions count up from the first
+ * entry ever added and never wrap, so the position of an entry stays
+ * valid until the entry is removed, also across growing the array.
+ *
+ * The CPU instruction list removes instructions of one thread from
+ * between those of others when running SMT. Such a removal leaves a
+ * hole, a null entry, behind which is dropped once it reaches the head
+ * or the tail. Code walking over the positions has to skip holes. As the
+ * entries are ordered, find() looks an instruction up by its sequence
+ * number with a binary search.
+ *
+ * @tparam Ptr Nullable pointer to an instruction with a seqNum member.
+ */
+template <class Ptr>
+class InstRing
+{
+  public:
+    typedef uint64_t Pos;
+
+  private:
+    /** Storage, its size always is a power of two. */
+    std::vector<Ptr> entries;
+
+    /** Position of the first entry. */
+    Pos first;
+
+    /** Position after the last entry. */
+    Pos last;
+
+    /** Number of entries which are not holes. */
+    size_t numEntries;
+
+    Ptr &slot(Pos pos) { return entries[pos & (entries.size() - 1)]; }
+
+    const Ptr &
+    slot(Pos pos) const
+    {
+        return entries[pos & (entries.size() - 1)];
+    }
+
+    /** Double the storage, keeping the position of every entry. */
+    void grow();
+
+    /** Drop the holes at both ends. */
+    void trim();
+
+  public:
+    /** Create a ring with room for at least capacity entries. */
+    explicit InstRing(size_t capacity = 64);
+
+    bool empty() const { return first == last; }
+
+    /** Number of entries, not counting holes. */
+    size_t size() const { return numEntries; }
+
+    /** Number of entries the storage can hold without growing. */
+    size_t capacity() const { return entries.size(); }
+
+    /** Position of the first entry, which never is a hole. */
+    Pos begin() const { return first; }
+
+    /** Position after the last entry. */
+    Pos end() const { return last; }
+
+    /** Entry at a position between begin() and end(). */
+    Ptr &
+    operator[](Pos pos)
+    {
+        assert(pos >= first && pos < last);
+        return slot(pos);
+    }
+
+    const Ptr &
+    operator[](Pos pos) const
+    {
+        assert(pos >= first && pos < last);
+        return slot(pos);
+    }
+
+    Ptr &front() { assert(!empty()); return slot(first); }
+    Ptr &back() { assert(!empty()); return slot(last - 1); }
+
+    /**
+     * Add an instruction younger than all others at the tail.
+     * @return The position of the new entry.
+     */
+    Pos push_back(const Ptr &inst);
+
+    /** Remove the entry at the head. */
+    void pop_front();
+
+    /** Remove the entry at the tail. */
+    void pop_back();
+
+    /** Remove the entry at any position, leaving a hole if needed. */
+    void erase(Pos pos);
+
+    /** Remove all entries. */
+    void clear();
+
+    /**
+     * Find an instruction by sequence number.
+     * @return Its position, or end() if it isn't in the ring.
+     */
+    Pos find(InstSeqNum seq_num) const;
+};
+
+template <class Ptr>
+InstRing<Ptr>::InstRing(size_t capacity)
+    : first(0), last(0), numEntries(0)
+{
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+    entries.resize(size);
+}
+
+template <class Ptr>
+void
+InstRing<Ptr>::grow()
+{
+    std::vector<Ptr> old(entries.size() * 2);
+    old.swap(entries);
+    for (Pos pos = first; pos != last; ++pos)
+        slot(pos) = std::move(old[pos & (old.size() - 1)]);
+}
+
+template <class Ptr>
+void
+InstRing<Ptr>::trim()
+{
+    while (first != last && !slot(first))
+        ++first;
+    while (first != last && !slot(last - 1))
+        --last;
+}
+
+template <class Ptr>
+typename InstRing<Ptr>::Pos
+InstRing<Ptr>::push_back(const Ptr &inst)
+{
+    assert(inst);
+    assert(empty() || back()->seqNum < inst->seqNum);
+    if (last - first == entries.size())
+        grow();
+    slot(last) = inst;
+    ++numEntries;
+    return last++;
+}
+
+template <class Ptr>
+void
+InstRing<Ptr>::pop_front()
+{
+    assert(!empty());
+    slot(first++) = Ptr();
+    --numEntries;
+    trim();
+}
+
+template <class Ptr>
+void
+InstRing<Ptr>::pop_back()
+{
+    assert(!empty());
+    slot(--last) = Ptr();
+    --numEntries;
+    trim();
+}
+
+template <class Ptr>
+void
+InstRing<Ptr>::erase(Pos pos)
+{
+    assert(pos >= first && pos < last && slot(pos));
+    slot(pos) = Ptr();
+    --numEntries;
+    trim();
+}
+
+template <class Ptr>
+void
+InstRing<Ptr>::clear()
+{
+    while (!empty())
+        pop_back();
+}
+
+template <class Ptr>
+typename InstRing<Ptr>::Pos
+InstRing<Ptr>::find(InstSeqNum seq_num) const
+{
+    Pos low = first;
+    Pos high = last;
+    while (low < high) {
+        Pos mid = low + (high - low) / 2;
+        // Look at the first entry from the middle on which isn't a hole
+        Pos probe = mid;
+        while (probe < high && !slot(probe))
+            ++probe;
+        if (probe == high || slot(probe)->seqNum > seq_num)
+            high = mid;
+        else if (slot(probe)->seqNum < seq_num)
+            low = probe + 1;
+        else
+            return probe;
+    }
+    return last;
+}
+
+#endif // __CPU_O3_INST_RING_HH__
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "cpu/o3/inst_ring.hh"
+
+namespace {
+
+struct Inst
+{
+    explicit Inst(InstSeqNum seq_num) : seqNum(seq_num) {}
+    InstSeqNum seqNum;
+};
+
+typedef std::shared_ptr<Inst> InstPtr;
+typedef InstRing<InstPtr> Ring;
+
+} // anonymous namespace
+
+TEST(InstRingTest, Capacity)
+{
+    EXPECT_EQ(Ring(1).capacity(), 1);
+    EXPECT_EQ(Ring(48).capacity(), 64);
+    EXPECT_EQ(Ring(64).capacity(), 64);
+}
+
+TEST(InstRingTest, Fifo)
+{
+    Ring ring(4);
+    EXPECT_TRUE(ring.empty());
+    // Go around the storage a few times without growing it
+    for (InstSeqNum sn = 1; sn <= 20; sn++) {
+        Ring::Pos pos = ring.push_back(std::make_shared<Inst>(sn));
+        EXPECT_EQ(ring[pos]->seqNum, sn);
+        if (ring.size() == 3) {
+            EXPECT_EQ(ring.front()->seqNum, sn - 2);
+            ring.pop_front();
+        }
+    }
+    EXPECT_EQ(ring.capacity(), 4);
+    EXPECT_EQ(ring.size(), 2);
+    EXPECT_EQ(ring.front()->seqNum, 19);
+    EXPECT_EQ(ring.back()->seqNum, 20);
+    ring.pop_back();
+    ring.pop_back();
+    EXPECT_TRUE(ring.empty());
+}
+
+/** Positions stay valid when the ring grows. */
+TEST(InstRingTest, Grow)
+{
+    Ring ring(2);
+    std::vector<Ring::Pos> positions;
+    for (InstSeqNum sn = 1; sn <= 3; sn++)
+        positions.push_back(ring.push_back(std::make_shared<Inst>(sn)));
+    ring.pop_front();
+    for (InstSeqNum sn = 4; sn <= 100; sn++)
+        positions.push_back(ring.push_back(std::make_shared<Inst>(sn)));
+    EXPECT_GE(ring.capacity(), 99);
+    EXPECT_EQ(ring.size(), 99);
+    for (size_t i = 1; i < positions.size(); i++)
+        EXPECT_EQ(ring[positions[i]]->seqNum, i + 1);
+}
+
+/** Popping an entry releases the reference the ring held. */
+TEST(InstRingTest, ReleaseOnPop)
+{
+    Ring ring;
+    InstPtr inst = std::make_shared<Inst>(1);
+    ring.push_back(inst);
+    EXPECT_EQ(inst.use_count(), 2);
+    ring.pop_front();
+    EXPECT_EQ(inst.use_count(), 1);
+}
+
+/** Erasing from the middle leaves holes which are dropped at the ends. */
+TEST(InstRingTest, Holes)
+{
+    Ring ring(8);
+    std::vector<Ring::Pos> positions;
+    for (InstSeqNum sn = 1; sn <= 6; sn++)
+        positions.push_back(ring.push_back(std::make_shared<Inst>(sn)));
+
+    ring.erase(positions[2]);
+    ring.erase(positions[3]);
+    EXPECT_EQ(ring.size(), 4);
+    EXPECT_EQ(ring.end() - ring.begin(), 6);
+    EXPECT_FALSE(ring[positions[2]]);
+
+    ring.erase(positions[4]);
+    ring.erase(positions[5]);
+    // The tail went back over the holes
+    EXPECT_EQ(ring.size(), 2);
+    EXPECT_EQ(ring.end(), positions[2]);
+    EXPECT_EQ(ring.back()->seqNum, 2);
+
+    ring.push_back(std::make_shared<Inst>(7));
+    ring.erase(positions[1]);
+    ring.pop_front();
+    EXPECT_EQ(ring.size(), 1);
+    EXPECT_EQ(ring.front()->seqNum, 7);
+}
+
+TEST(InstRingTest, Find)
+{
+    Ring ring(4);
+    std::vector<Ring::Pos> positions;
+    for (InstSeqNum sn = 10; sn < 200; sn += 10)
+        positions.push_back(ring.push_back(std::make_shared<Inst>(sn)));
+    for (size_t i = 0; i < positions.size(); i += 3)
+        if (i != 0 && i + 1 != positions.size())
+            ring.erase(positions[i]);
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        InstSeqNum sn = (i + 1) * 10;
+        if (i % 3 == 0 && i != 0 && i + 1 != positions.size()) {
+            EXPECT_EQ(ring.find(sn), ring.end());
+        } else {
+            EXPECT_EQ(ring.find(sn), positions[i]);
+        }
+        EXPECT_EQ(ring.find(sn + 5), ring.end());
+    }
+    EXPECT_EQ(ring.find(5), ring.end());
+    EXPECT_EQ(Ring().find(5), Ring().end());
+}
+
+TEST(InstRingTest, Clear)
+{
+    Ring ring(4);
+    for (InstSeqNum sn = 1; sn <= 10; sn++)
+        ring.push_back(std::make_shared<Inst>(sn));
+    ring.clear();
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.size(), 0);
+    ring.push_back(std::make_shared<Inst>(11));
+    EXPECT_EQ(ring.front()->seqNum, 11);
+}
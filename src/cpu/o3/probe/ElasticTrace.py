@@ -35,6 +35,14 @@
 
 from m5.objects.Probe import *
 
+class ElasticTraceSync(SimObject):
+    """Numbers the synchronization points, e.g. atomics and barriers, of
+    all the cores traced together so that their traces can be replayed on
+    Trace CPUs sharing a TraceSync. All ElasticTrace listeners of the
+    traced system must share the same instance."""
+    type = 'ElasticTraceSync'
+    cxx_header = 'cpu/o3/probe/elastic_trace.hh'
+
 class ElasticTrace(ProbeListenerObject):
     type = 'ElasticTrace'
     cxx_header = 'cpu/o3/probe/elastic_trace.hh'
@@ -58,3 +66,7 @@ class ElasticTrace(ProbeListenerObject):
     # Whether to trace virtual addresses for memory accesses
     traceVirtAddr = Param.Bool(False, "Set to true if virtual addresses are " \
                                 "to be traced.")
+    # When tracing a multi-core system, share an ElasticTraceSync between
+    # the listeners to record the order of synchronizing instructions
+    syncOrder = Param.ElasticTraceSync(NULL, "Synchronization point " \
+                                        "numbering shared by all listeners")
@@ -44,6 +44,37 @@
 #include "debug/ElasticTrace.hh"
 #include "mem/packet.hh"
 
+ElasticTraceSync::ElasticTraceSync(const ElasticTraceSyncParams *p)
+    : SimObject(p), count(0)
+{
+}
+
+int
+ElasticTraceSync::registerCore()
+{
+    cores.emplace_back(0, 0);
+    return cores.size() - 1;
+}
+
+uint64_t
+ElasticTraceSync::commit(int core, uint64_t &sync_dep)
+{
+    auto &last = cores[core];
+    // If the latest point is this core's own, no other core has committed
+    // one since and the watermark stays the same
+    if (count != last.first)
+        last.second = count;
+    last.first = ++count;
+    sync_dep = last.second;
+    return count;
+}
+
+ElasticTraceSync*
+ElasticTraceSyncParams::create()
+{
+    return new ElasticTraceSync(this);
+}
+
 ElasticTrace::ElasticTrace(const ElasticTraceParams* params)
     :  ProbeListenerObject(params),
        regEtraceListenersEvent([this]{ regEtraceListeners(); }, name()),
@@ -55,6 +86,8 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams* params)
        startTraceInst(params->startTraceInst),
        allProbesReg(false),
        traceVirtAddr(params->traceVirtAddr),
+       syncOrder(params->syncOrder),
+       syncCore(syncOrder ? syncOrder->registerCore() : -1),
        stats(this)
 {
     cpu = dynamic_cast<FullO3CPU<O3CPUImpl>*>(params->manager);
@@ -408,6 +441,16 @@ ElasticTrace::addDepTraceRecord(const DynInstConstPtr& head_inst,
     new_record->size = head_inst->effSize;
     new_record->pc = head_inst->instAddr();
 
+    // Number the synchronization points in global commit order
+    if (syncOrder && commit && isSyncPoint(head_inst)) {
+        new_record->syncSeq = syncOrder->commit(syncCore,
+                                                new_record->syncDep);
+        ++stats.numSyncPoints;
+        DPRINTF(ElasticTrace, "Inst record %lli is sync point %lli after "
+                "%lli.\n", new_record->instNum, new_record->syncSeq,
+                new_record->syncDep);
+    }
+
     // Assign the timing information stored in the execution info object
     new_record->executeTick = exec_info_ptr->executeTick;
     new_record->toCommitTick = exec_info_ptr->toCommitTick;
@@ -639,6 +682,18 @@ ElasticTrace::hasLoadBeenSent(TraceInfo* past_record,
         past_record->executeTick <= execute_tick);
 }
 
+bool
+ElasticTrace::isSyncPoint(const DynInstConstPtr& head_inst) const
+{
+    if (head_inst->isAtomic() || head_inst->isMemBarrier() ||
+        head_inst->isWriteBarrier()) {
+        return true;
+    }
+
+    return head_inst->isMemRef() &&
+        (head_inst->memReqFlags & (Request::LLSC | Request::LOCKED_RMW));
+}
+
 bool
 ElasticTrace::hasCompCompleted(TraceInfo* past_record,
                                     Tick execute_tick) const
@@ -793,8 +848,10 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
         // If no node dependends on a comp node then there is no reason to
         // track the comp node in the dependency graph. We filter out such
         // nodes but count them and add a weight field to the subsequent node
-        // that we do include in the trace.
-        if (!temp_ptr->isComp() || temp_ptr->numDepts != 0) {
+        // that we do include in the trace. Synchronization points such as
+        // barriers are always kept as they order accesses across cores.
+        if (!temp_ptr->isComp() || temp_ptr->numDepts != 0 ||
+            temp_ptr->syncSeq != 0) {
             DPRINTFR(ElasticTrace, "Instruction with seq. num %lli "
                      "is as follows:\n", temp_ptr->instNum);
             if (temp_ptr->isLoad() || temp_ptr->isStore()) {
@@ -833,6 +890,12 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_size(temp_ptr->size);
             }
             dep_pkt.set_comp_delay(temp_ptr->compDelay);
+            if (temp_ptr->syncSeq != 0) {
+                DPRINTFR(ElasticTrace, "\tis sync point %lli\n",
+                         temp_ptr->syncSeq);
+                dep_pkt.set_sync_seq(temp_ptr->syncSeq);
+                dep_pkt.set_sync_dep(temp_ptr->syncDep);
+            }
             if (temp_ptr->robDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no order (rob) dependencies\n");
             }
@@ -890,6 +953,8 @@ ElasticTrace::ElasticTraceStats::ElasticTraceStats(Stats::Group *parent)
           " dependency-free"),
       ADD_STAT(numFilteredNodes, "No. of nodes filtered out before writing"
           " the output trace"),
+      ADD_STAT(numSyncPoints, "No. of synchronization points recorded for"
+          " multi-core replay"),
       ADD_STAT(maxNumDependents, "Maximum number or dependents on any"
           " instruction"),
       ADD_STAT(maxTempStoreSize, "Maximum size of the temporary store during"
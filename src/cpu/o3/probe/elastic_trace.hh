@@ -49,16 +49,57 @@
 #include <set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/impl.hh"
 #include "mem/request.hh"
 #include "params/ElasticTrace.hh"
+#include "params/ElasticTraceSync.hh"
 #include "proto/inst_dep_record.pb.h"
 #include "proto/packet.pb.h"
 #include "proto/protoio.hh"
 #include "sim/eventq.hh"
 #include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * Numbers the synchronization points committed by all the cores traced
+ * in a simulation. The sequence numbers follow the global commit order,
+ * and each point also records the last point that another core
+ * committed before it. During replay a point only has to wait for the
+ * points up to that watermark, rather than for every earlier point.
+ */
+class ElasticTraceSync : public SimObject
+{
+  public:
+
+    ElasticTraceSync(const ElasticTraceSyncParams *p);
+
+    /**
+     * Add a traced core.
+     *
+     * @return Identifier of the core
+     */
+    int registerCore();
+
+    /**
+     * Number a synchronization point committed by a core.
+     *
+     * @param core Identifier of the core
+     * @param sync_dep Set to the last point of another core, 0 if none
+     * @return Sequence number of the point
+     */
+    uint64_t commit(int core, uint64_t &sync_dep);
+
+  private:
+
+    /** Number of synchronization points committed by all cores */
+    uint64_t count;
+
+    /** Per-core last point committed and the watermark it recorded */
+    std::vector<std::pair<uint64_t, uint64_t>> cores;
+};
 
 /**
  * The elastic trace is a type of probe listener and listens to probe points
@@ -288,9 +329,13 @@ class ElasticTrace : public ProbeListenerObject
         Addr virtAddr;
         /* Request size in case of a load/store instruction */
         unsigned size;
+        /* Global order of a synchronization instruction, 0 otherwise */
+        uint64_t syncSeq;
+        /* Last sync point of another core that precedes this one */
+        uint64_t syncDep;
         /** Default Constructor */
         TraceInfo()
-          : type(Record::INVALID)
+          : type(Record::INVALID), syncSeq(0), syncDep(0)
         { }
         /** Is the record a load */
         bool isLoad() const { return (type == Record::LOAD); }
@@ -364,6 +409,25 @@ class ElasticTrace : public ProbeListenerObject
     /** Whether to trace virtual addresses for memory requests. */
     const bool traceVirtAddr;
 
+    /**
+     * Numbering of the synchronization points shared by the listeners of
+     * all the traced cores, null if sync points are not recorded.
+     */
+    ElasticTraceSync *syncOrder;
+
+    /** Identifier of this listener's core in the sync point numbering */
+    int syncCore;
+
+    /**
+     * Check if an instruction synchronizes with other cores. Atomics,
+     * memory barriers, load-linked/store-conditional and locked
+     * read-modify-write accesses are considered synchronization points.
+     *
+     * @param head_inst pointer to the committed instruction
+     * @return true if the instruction is a synchronization point
+     */
+    bool isSyncPoint(const DynInstConstPtr& head_inst) const;
+
     /** Pointer to the O3CPU that is this listener's parent a.k.a. manager */
     FullO3CPU<O3CPUImpl>* cpu;
 
@@ -537,6 +601,9 @@ class ElasticTrace : public ProbeListenerObject
         /** Number of filtered nodes */
         Stats::Scalar numFilteredNodes;
 
+        /** Number of synchronization points recorded */
+        Stats::Scalar numSyncPoints;
+
         /** Maximum number of dependents on any instruction */
         Stats::Scalar maxNumDependents;
 
@@ -42,8 +42,10 @@
 #ifndef __CPU_O3_RENAME_HH__
 #define __CPU_O3_RENAME_HH__
 
+#include <deque>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
@@ -185,6 +187,14 @@ class DefaultRename
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Would ticking the stage only count another stall cycle? */
+    bool isStalled(ThreadID tid);
+
+    /** Counts the given number of cycles in which the stage was stalled
+     * without being ticked.
+     */
+    void skipStalledCycles(ThreadID tid, Cycles cycles);
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -249,6 +259,12 @@ class DefaultRename
     /** Removes a committed instruction's rename history. */
     void removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid);
 
+    /** Snapshots the rename map after a control instruction. */
+    void takeCheckpoint(InstSeqNum inst_seq_num, ThreadID tid);
+
+    /** Drops all the checkpoints of a thread. */
+    void clearCheckpoints(ThreadID tid);
+
     /** Renames the source registers of an instruction. */
     inline void renameSrcRegs(const DynInstPtr &inst, ThreadID tid);
 
@@ -320,6 +336,36 @@ class DefaultRename
      */
     std::list<RenameHistory> historyBuffer[Impl::MaxThreads];
 
+    /** Per-thread number of entries added to the history buffer and not
+     * squashed since. Commits do not change it, so the difference to the
+     * value saved in a checkpoint is the number of younger entries.
+     */
+    uint64_t historyPushed[Impl::MaxThreads];
+
+    /** A snapshot of the rename map and free list taken right after a
+     * control instruction renamed its destinations. Squashing back to
+     * that instruction restores the map in one step and frees the
+     * registers allocated since, instead of undoing the younger history
+     * entries one at a time.
+     */
+    struct RenameCheckpoint {
+        /** The sequence number of the control instruction. */
+        InstSeqNum instSeqNum;
+        /** The history buffer position after it was renamed. */
+        uint64_t historyPushed;
+        /** The state of the rename map after it was renamed. */
+        typename RenameMap::Checkpoint map;
+        /** The free registers, including those freed by older
+         *  instructions committing since. */
+        typename FreeList::Checkpoint freeRegs;
+    };
+
+    /** Per-thread live checkpoints, oldest first. */
+    std::deque<RenameCheckpoint> checkpoints[Impl::MaxThreads];
+
+    /** Released checkpoints kept around to reuse their storage. */
+    std::vector<RenameCheckpoint> spareCheckpoints;
+
     /** Pointer to CPU. */
     O3CPU *cpu;
 
@@ -462,6 +508,13 @@ class DefaultRename
     /** The maximum skid buffer size. */
     unsigned skidBufferMax;
 
+    /** The maximum number of live rename map checkpoints per thread. */
+    const unsigned numCheckpoints;
+
+    /** Whether checkpoints also save the free list. The free list is
+     *  shared by all threads, so it can only be restored with one. */
+    const bool checkpointFreeList;
+
     /** Enum to record the source of a structure full stall.  Can come from
      * either ROB, IQ, LSQ, and it is priortized in that order.
      */
@@ -527,6 +580,11 @@ class DefaultRename
         /** Stat for total number of mappings that were undone due to a
          *  squash. */
         Stats::Scalar undoneMaps;
+        /** Stat for total number of rename map checkpoints taken. */
+        Stats::Scalar checkpoints;
+        /** Stat for total number of squashes that restored the rename
+         *  map from a checkpoint. */
+        Stats::Scalar checkpointRestores;
         /** Number of serialize instructions handled. */
         Stats::Scalar serializing;
         /** Number of instructions marked as temporarily serializing. */
@@ -42,6 +42,7 @@
 #ifndef __CPU_O3_RENAME_IMPL_HH__
 #define __CPU_O3_RENAME_IMPL_HH__
 
+#include <iterator>
 #include <list>
 
 #include "arch/registers.hh"
@@ -64,6 +65,8 @@ DefaultRename<Impl>::DefaultRename(O3CPU *_cpu, DerivO3CPUParams *params)
       renameWidth(params->renameWidth),
       commitWidth(params->commitWidth),
       numThreads(params->numThreads),
+      numCheckpoints(params->numRenameCheckpoints),
+      checkpointFreeList(params->numThreads == 1),
       stats(_cpu)
 {
     if (renameWidth > Impl::MaxWidth)
@@ -84,6 +87,7 @@ DefaultRename<Impl>::DefaultRename(O3CPU *_cpu, DerivO3CPUParams *params)
         stalls[tid] = {false, false};
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
+        historyPushed[tid] = 0;
     }
 }
 
@@ -130,6 +134,9 @@ DefaultRename<Impl>::RenameStats::RenameStats(Stats::Group *parent)
       ADD_STAT(committedMaps, "Number of HB maps that are committed"),
       ADD_STAT(undoneMaps, "Number of HB maps that are undone due to"
           " squashing"),
+      ADD_STAT(checkpoints, "Number of rename map checkpoints taken"),
+      ADD_STAT(checkpointRestores, "Number of squashes that restored the"
+          " rename map from a checkpoint"),
       ADD_STAT(serializing, "count of serializing insts renamed" ),
       ADD_STAT(tempSerializing, "count of temporary serializing insts"
           " renamed"),
@@ -266,6 +273,8 @@ DefaultRename<Impl>::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+
+        clearCheckpoints(tid);
     }
 }
 
@@ -314,6 +323,23 @@ DefaultRename<Impl>::isDrained() const
     return true;
 }
 
+template <class Impl>
+bool
+DefaultRename<Impl>::isStalled(ThreadID tid)
+{
+    // Rename stays blocked until the back end frees entries or IEW
+    // unblocks it.
+    return renameStatus[tid] == Blocked && checkStall(tid) &&
+        insts[tid].empty();
+}
+
+template <class Impl>
+void
+DefaultRename<Impl>::skipStalledCycles(ThreadID tid, Cycles cycles)
+{
+    stats.blockCycles += cycles;
+}
+
 template <class Impl>
 void
 DefaultRename<Impl>::takeOverFrom()
@@ -719,6 +745,12 @@ DefaultRename<Impl>::renameInsts(ThreadID tid)
 
         renameDestRegs(inst, inst->threadNumber);
 
+        // Only branches resolved at execute are worth a checkpoint. Direct
+        // unconditional ones are redirected by decode, when there are
+        // only a few younger history entries to undo.
+        if (inst->isCondCtrl() || inst->isIndirectCtrl())
+            takeCheckpoint(inst->seqNum, tid);
+
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
         } else if (inst->isLoad()) {
@@ -930,6 +962,44 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
     typename std::list<RenameHistory>::iterator hb_it =
         historyBuffer[tid].begin();
 
+    // Checkpoints taken by squashed instructions are no longer valid. If
+    // the squashing instruction itself left one behind, the map can be
+    // restored from it directly.
+    std::deque<RenameCheckpoint> &cps = checkpoints[tid];
+    while (!cps.empty() && cps.back().instSeqNum > squashed_seq_num) {
+        spareCheckpoints.push_back(std::move(cps.back()));
+        cps.pop_back();
+    }
+
+    const bool restored = !cps.empty() &&
+        cps.back().instSeqNum == squashed_seq_num &&
+        renameMap[tid]->restore(cps.back().map);
+
+    if (restored) {
+        DPRINTF(Rename, "[tid:%i] Restored rename map from checkpoint "
+                "[sn:%llu].\n", tid, squashed_seq_num);
+        ++stats.checkpointRestores;
+    }
+
+    // The younger history entries are exactly those added since the
+    // checkpoint. Unless a listener needs to see them one by one, free
+    // their registers from the free list snapshot and drop them at once.
+    if (restored && checkpointFreeList && !ppSquashInRename->hasListeners()) {
+        const RenameCheckpoint &cp = cps.back();
+        const uint64_t num_squashed = historyPushed[tid] - cp.historyPushed;
+        hb_it = std::next(historyBuffer[tid].begin(), num_squashed);
+        assert(hb_it == historyBuffer[tid].end() ||
+               hb_it->instSeqNum <= squashed_seq_num);
+
+        const unsigned num_freed = freeList->restore(cp.freeRegs);
+        DPRINTF(Rename, "[tid:%i] Removing %llu history entries, freeing "
+                "%u registers.\n", tid, num_squashed, num_freed);
+
+        historyBuffer[tid].erase(historyBuffer[tid].begin(), hb_it);
+        historyPushed[tid] = cp.historyPushed;
+        stats.undoneMaps += num_squashed;
+    }
+
     // After a syscall squashes everything, the history buffer may be empty
     // but the ROB may still be squashing instructions.
     // Go through the most recent instructions, undoing the mappings
@@ -952,7 +1022,8 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         if (hb_it->newPhysReg != hb_it->prevPhysReg) {
             // Tell the rename map to set the architected register to the
             // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            if (!restored)
+                renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
 
             // Put the renamed physical register back on the free list.
             freeList->addReg(hb_it->newPhysReg);
@@ -965,12 +1036,19 @@ DefaultRename<Impl>::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
                                                 hb_it->newPhysReg));
 
         historyBuffer[tid].erase(hb_it++);
+        --historyPushed[tid];
 
         ++stats.undoneMaps;
     }
 
     // Check if we need to change vector renaming mode after squashing
+    const auto vec_mode = renameMap[tid]->getVecMode();
     cpu->switchRenameMode(tid, freeList);
+
+    // A mode switch rebuilds the vector mappings, which invalidates
+    // every checkpoint taken before it.
+    if (renameMap[tid]->getVecMode() != vec_mode)
+        clearCheckpoints(tid);
 }
 
 template<class Impl>
@@ -981,6 +1059,13 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
+    // Committed control instructions can no longer be squashed to.
+    std::deque<RenameCheckpoint> &cps = checkpoints[tid];
+    while (!cps.empty() && cps.front().instSeqNum <= inst_seq_num) {
+        spareCheckpoints.push_back(std::move(cps.front()));
+        cps.pop_front();
+    }
+
     typename std::list<RenameHistory>::iterator hb_it =
         historyBuffer[tid].end();
 
@@ -1016,6 +1101,13 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
         // the old one.
         if (hb_it->newPhysReg != hb_it->prevPhysReg) {
             freeList->addReg(hb_it->prevPhysReg);
+
+            // The register is also free in the state the younger
+            // checkpoints restore to.
+            if (checkpointFreeList) {
+                for (auto &cp : checkpoints[tid])
+                    freeList->markFree(cp.freeRegs, hb_it->prevPhysReg);
+            }
         }
 
         ++stats.committedMaps;
@@ -1024,6 +1116,41 @@ DefaultRename<Impl>::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     }
 }
 
+template <class Impl>
+void
+DefaultRename<Impl>::takeCheckpoint(InstSeqNum inst_seq_num, ThreadID tid)
+{
+    // Once the limit is reached younger branches simply fall back to
+    // walking the history buffer on a squash.
+    if (checkpoints[tid].size() >= numCheckpoints)
+        return;
+
+    if (spareCheckpoints.empty()) {
+        checkpoints[tid].emplace_back();
+    } else {
+        checkpoints[tid].push_back(std::move(spareCheckpoints.back()));
+        spareCheckpoints.pop_back();
+    }
+
+    RenameCheckpoint &cp = checkpoints[tid].back();
+    cp.instSeqNum = inst_seq_num;
+    cp.historyPushed = historyPushed[tid];
+    renameMap[tid]->checkpoint(cp.map);
+    if (checkpointFreeList)
+        freeList->checkpoint(cp.freeRegs);
+
+    ++stats.checkpoints;
+}
+
+template <class Impl>
+void
+DefaultRename<Impl>::clearCheckpoints(ThreadID tid)
+{
+    for (auto &cp : checkpoints[tid])
+        spareCheckpoints.push_back(std::move(cp));
+    checkpoints[tid].clear();
+}
+
 template <class Impl>
 inline void
 DefaultRename<Impl>::renameSrcRegs(const DynInstPtr &inst, ThreadID tid)
@@ -1126,6 +1253,7 @@ DefaultRename<Impl>::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
                                rename_result.second);
 
         historyBuffer[tid].push_front(hb_entry);
+        ++historyPushed[tid];
 
         DPRINTF(Rename, "[tid:%i] [sn:%llu] "
                 "Adding instruction to history buffer (size=%i).\n",
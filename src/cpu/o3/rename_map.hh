@@ -141,6 +141,20 @@ class SimpleRenameMap
         map[arch_reg.flatIndex()] = phys_reg;
     }
 
+    /** A copy of the whole map, used to checkpoint it in one step. */
+    using Snapshot = Arch2PhysMap;
+
+    /** Copy the current mappings into a snapshot. */
+    void save(Snapshot &snap) const { snap = map; }
+
+    /** Replace the current mappings with a previously saved snapshot. */
+    void
+    restore(const Snapshot &snap)
+    {
+        assert(snap.size() == map.size());
+        map = snap;
+    }
+
     /** Return the number of free entries on the associated free list. */
     unsigned numFreeEntries() const { return freeList->numFreeRegs(); }
 
@@ -210,6 +224,21 @@ class UnifiedRenameMap
     /** Destructor. */
     ~UnifiedRenameMap() {};
 
+    /**
+     * Snapshot of every class-specific map. Only the map matching the
+     * vector renaming mode in effect when it was taken is saved, so a
+     * checkpoint cannot be restored across a mode switch.
+     */
+    struct Checkpoint
+    {
+        VecMode vecMode;
+        SimpleRenameMap::Snapshot intMap;
+        SimpleRenameMap::Snapshot floatMap;
+        SimpleRenameMap::Snapshot vecMap;
+        SimpleRenameMap::Snapshot predMap;
+        SimpleRenameMap::Snapshot ccMap;
+    };
+
     /** Initializes rename map with given parameters. */
     void init(PhysRegFile *_regFile,
               RegIndex _intZeroReg,
@@ -394,6 +423,46 @@ class UnifiedRenameMap
             vecPredRegs <= predMap.numFreeEntries() &&
             ccRegs <= ccMap.numFreeEntries();
     }
+    /** Save the current state of all the maps into a checkpoint. */
+    void
+    checkpoint(Checkpoint &cp) const
+    {
+        cp.vecMode = vecMode;
+        intMap.save(cp.intMap);
+        floatMap.save(cp.floatMap);
+        if (vecMode == Enums::Full)
+            vecMap.save(cp.vecMap);
+        else
+            vecElemMap.save(cp.vecMap);
+        predMap.save(cp.predMap);
+        ccMap.save(cp.ccMap);
+    }
+
+    /**
+     * Restore all the maps from a checkpoint.
+     * @return false, leaving the maps untouched, if the checkpoint was
+     * taken under a different vector renaming mode.
+     */
+    bool
+    restore(const Checkpoint &cp)
+    {
+        if (cp.vecMode != vecMode)
+            return false;
+
+        intMap.restore(cp.intMap);
+        floatMap.restore(cp.floatMap);
+        if (vecMode == Enums::Full)
+            vecMap.restore(cp.vecMap);
+        else
+            vecElemMap.restore(cp.vecMap);
+        predMap.restore(cp.predMap);
+        ccMap.restore(cp.ccMap);
+        return true;
+    }
+
+    /** Return the current vector renaming mode. */
+    VecMode getVecMode() const { return vecMode; }
+
     /**
      * Set vector mode to Full or Elem.
      * Ignore 'silent' modifications.
@@ -48,6 +48,7 @@
 #include "arch/registers.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "enums/SMTQueuePolicy.hh"
 
 struct DerivO3CPUParams;
@@ -64,7 +65,8 @@ class ROB
     typedef typename Impl::DynInstPtr DynInstPtr;
 
     typedef std::pair<RegIndex, PhysRegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef InstRing<DynInstPtr> InstList;
+    typedef typename InstList::Pos InstIt;
 
     /** Possible ROB statuses. */
     enum Status {
@@ -150,6 +152,11 @@ class ROB
     /** Is the oldest instruction across a particular thread ready. */
     bool isHeadReady(ThreadID tid);
 
+    /** Counts the checks of the head instruction made in the given number
+     * of cycles in which commit was stalled without being ticked.
+     */
+    void skipStalledCycles(Cycles cycles) { stats.reads += cycles; }
+
     /** Is there any commitable head instruction across all threads ready. */
     bool canCommit();
 
@@ -276,30 +283,27 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[Impl::MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** ROB List of Instructions, a ring with room for the whole ROB. */
+    InstList instList[Impl::MaxThreads];
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
 
   public:
-    /** Iterator pointing to the instruction which is the last instruction
-     *  in the ROB.  This may at times be invalid (ie when the ROB is empty),
-     *  however it should never be incorrect.
-     */
-    InstIt tail;
+    /** The last instruction in the ROB, or null if the ROB is empty. */
+    DynInstPtr tail;
 
-    /** Iterator pointing to the instruction which is the first instruction in
-     *  in the ROB*/
-    InstIt head;
+    /** The first instruction in the ROB, or null if the ROB is empty. */
+    DynInstPtr head;
 
   private:
-    /** Iterator used for walking through the list of instructions when
+    /** Position used for walking through the list of instructions when
      *  squashing.  Used so that there is persistent state between cycles;
      *  when squashing, the instructions are marked as squashed but not
-     *  immediately removed, meaning the tail iterator remains the same before
+     *  immediately removed, meaning the tail remains the same before
      *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  This is only valid while the thread is squashing, i.e. while
+     *  doneSquashing is false.
      */
     InstIt squashIt[Impl::MaxThreads];
 
@@ -94,6 +94,11 @@ ROB<Impl>::ROB(O3CPU *_cpu, DerivO3CPUParams *params)
         maxEntries[tid] = 0;
     }
 
+    // A thread can use up to the whole ROB, so its ring never has to grow.
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        instList[tid] = InstList(numEntries);
+    }
+
     resetState();
 }
 
@@ -103,16 +108,14 @@ ROB<Impl>::resetState()
 {
     for (ThreadID tid = 0; tid  < Impl::MaxThreads; tid++) {
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
         squashedSeqNum[tid] = 0;
         doneSquashing[tid] = true;
     }
     numInstsInROB = 0;
 
-    // Initialize the "universal" ROB head & tail point to invalid
-    // pointers
-    head = instList[0].end();
-    tail = instList[0].end();
+    // Initialize the "universal" ROB head & tail to no instruction
+    head = nullptr;
+    tail = nullptr;
 }
 
 template <class Impl>
@@ -215,24 +218,18 @@ ROB<Impl>::insertInst(const DynInstPtr &inst)
 
     instList[tid].push_back(inst);
 
-    //Set Up head iterator if this is the 1st instruction in the ROB
+    //Set Up head if this is the 1st instruction in the ROB
     if (numInstsInROB == 0) {
-        head = instList[tid].begin();
-        assert((*head) == inst);
+        head = inst;
     }
 
-    //Must Decrement for iterator to actually be valid  since __.end()
-    //actually points to 1 after the last inst
-    tail = instList[tid].end();
-    tail--;
+    tail = inst;
 
     inst->setInROB();
 
     ++numInstsInROB;
     ++threadEntries[tid];
 
-    assert((*tail) == inst);
-
     DPRINTF(ROB, "[tid:%i] Now has %d instructions.\n", tid, threadEntries[tid]);
 }
 
@@ -245,10 +242,8 @@ ROB<Impl>::retireHead(ThreadID tid)
     assert(numInstsInROB > 0);
 
     // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -265,9 +260,10 @@ ROB<Impl>::retireHead(ThreadID tid)
     //Update "Global" Head of ROB
     updateHead();
 
-    // @todo: A special case is needed if the instruction being
-    // retired is the only instruction in the ROB; otherwise the tail
-    // iterator will become invalidated.
+    if (numInstsInROB == 0) {
+        tail = nullptr;
+    }
+
     cpu->removeFrontInst(head_inst);
 }
 
@@ -324,14 +320,14 @@ ROB<Impl>::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%i] Squashing instructions until [sn:%llu].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
+    assert(!doneSquashing[tid]);
 
-    if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
+    InstList &insts = instList[tid];
+
+    if (insts[squashIt[tid]]->seqNum < squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
-
         doneSquashing[tid] = true;
         return;
     }
@@ -340,37 +336,33 @@ ROB<Impl>::doSquash(ThreadID tid)
 
     for (int numSquashed = 0;
          numSquashed < squashWidth &&
-         squashIt[tid] != instList[tid].end() &&
-         (*squashIt[tid])->seqNum > squashedSeqNum[tid];
+         insts[squashIt[tid]]->seqNum > squashedSeqNum[tid];
          ++numSquashed)
     {
+        const DynInstPtr &inst = insts[squashIt[tid]];
+
         DPRINTF(ROB, "[tid:%i] Squashing instruction PC %s, seq num %i.\n",
-                (*squashIt[tid])->threadNumber,
-                (*squashIt[tid])->pcState(),
-                (*squashIt[tid])->seqNum);
+                inst->threadNumber,
+                inst->pcState(),
+                inst->seqNum);
 
         // Mark the instruction as squashed, and ready to commit so that
         // it can drain out of the pipeline.
-        (*squashIt[tid])->setSquashed();
+        inst->setSquashed();
 
-        (*squashIt[tid])->setCanCommit();
+        inst->setCanCommit();
 
 
-        if (squashIt[tid] == instList[tid].begin()) {
+        if (squashIt[tid] == insts.begin()) {
             DPRINTF(ROB, "Reached head of instruction list while "
                     "squashing.\n");
 
-            squashIt[tid] = instList[tid].end();
-
             doneSquashing[tid] = true;
 
             return;
         }
 
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*squashIt[tid]) == (*tail_thread))
+        if (inst == insts.back())
             robTailUpdate = true;
 
         squashIt[tid]--;
@@ -378,12 +370,10 @@ ROB<Impl>::doSquash(ThreadID tid)
 
 
     // Check if ROB is done squashing.
-    if ((*squashIt[tid])->seqNum <= squashedSeqNum[tid]) {
+    if (insts[squashIt[tid]]->seqNum <= squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
-
         doneSquashing[tid] = true;
     }
 
@@ -411,26 +401,24 @@ ROB<Impl>::updateHead()
             continue;
 
         if (first_valid) {
-            head = instList[tid].begin();
-            lowest_num = (*head)->seqNum;
+            head = instList[tid].front();
+            lowest_num = head->seqNum;
             first_valid = false;
             continue;
         }
 
-        InstIt head_thread = instList[tid].begin();
-
-        DynInstPtr head_inst = (*head_thread);
+        const DynInstPtr &head_inst = instList[tid].front();
 
         assert(head_inst != 0);
 
         if (head_inst->seqNum < lowest_num) {
-            head = head_thread;
+            head = head_inst;
             lowest_num = head_inst->seqNum;
         }
     }
 
     if (first_valid) {
-        head = instList[0].end();
+        head = nullptr;
     }
 
 }
@@ -439,7 +427,7 @@ template <class Impl>
 void
 ROB<Impl>::updateTail()
 {
-    tail = instList[0].end();
+    tail = nullptr;
     bool first_valid = true;
 
     list<ThreadID>::iterator threads = activeThreads->begin();
@@ -455,18 +443,16 @@ ROB<Impl>::updateTail()
         // If this is the first valid then assign w/out
         // comparison
         if (first_valid) {
-            tail = instList[tid].end();
-            tail--;
+            tail = instList[tid].back();
             first_valid = false;
             continue;
         }
 
         // Assign new tail if this thread's tail is younger
         // than our current "tail high"
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
+        const DynInstPtr &tail_thread = instList[tid].back();
 
-        if ((*tail_thread)->seqNum > (*tail)->seqNum) {
+        if (tail_thread->seqNum > tail->seqNum) {
             tail = tail_thread;
         }
     }
@@ -494,10 +480,7 @@ ROB<Impl>::squash(InstSeqNum squash_num, ThreadID tid)
     squashedSeqNum[tid] = squash_num;
 
     if (!instList[tid].empty()) {
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        squashIt[tid] = tail_thread;
+        squashIt[tid] = instList[tid].end() - 1;
 
         doSquash(tid);
     }
@@ -508,11 +491,11 @@ const typename Impl::DynInstPtr&
 ROB<Impl>::readHeadInst(ThreadID tid)
 {
     if (threadEntries[tid] != 0) {
-        InstIt head_thread = instList[tid].begin();
+        const DynInstPtr &head_thread = instList[tid].front();
 
-        assert((*head_thread)->isInROB());
+        assert(head_thread->isInROB());
 
-        return *head_thread;
+        return head_thread;
     } else {
         return dummyInst;
     }
@@ -522,10 +505,7 @@ template <class Impl>
 typename Impl::DynInstPtr
 ROB<Impl>::readTailInst(ThreadID tid)
 {
-    InstIt tail_thread = instList[tid].end();
-    tail_thread--;
-
-    return *tail_thread;
+    return instList[tid].back();
 }
 
 template <class Impl>
@@ -540,12 +520,11 @@ template <class Impl>
 typename Impl::DynInstPtr
 ROB<Impl>::findInst(ThreadID tid, InstSeqNum squash_inst)
 {
-    for (InstIt it = instList[tid].begin(); it != instList[tid].end(); it++) {
-        if ((*it)->seqNum == squash_inst) {
-            return *it;
-        }
+    InstIt it = instList[tid].find(squash_inst);
+    if (it == instList[tid].end()) {
+        return NULL;
     }
-    return NULL;
+    return instList[tid][it];
 }
 
 #endif//__CPU_O3_ROB_IMPL_HH__
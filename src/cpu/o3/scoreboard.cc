@@ -35,7 +35,7 @@
 Scoreboard::Scoreboard(const std::string &_my_name,
                        unsigned _numPhysicalRegs)
     : _name(_my_name),
-      regScoreBoard(_numPhysicalRegs, true),
+      regScoreBoard((_numPhysicalRegs + 63) / 64, ~0ULL),
       numPhysRegs(_numPhysicalRegs)
 {
 }
@@ -52,9 +52,21 @@ class Scoreboard
      *  explicitly because Scoreboard is not a SimObject. */
     const std::string _name;
 
-    /** Scoreboard of physical integer registers, saying whether or not they
-     *  are ready. */
-    std::vector<bool> regScoreBoard;
+    /** Scoreboard of physical registers, saying whether or not they
+     *  are ready. One bit per register, packed into 64-bit words and
+     *  indexed by the register's flat index. */
+    std::vector<uint64_t> regScoreBoard;
+
+    /** Word holding the ready bit of a register. */
+    uint64_t &word(PhysRegIdPtr phys_reg)
+    { return regScoreBoard[phys_reg->flatIndex() / 64]; }
+
+    const uint64_t &word(PhysRegIdPtr phys_reg) const
+    { return regScoreBoard[phys_reg->flatIndex() / 64]; }
+
+    /** Mask selecting the ready bit of a register within its word. */
+    static uint64_t mask(PhysRegIdPtr phys_reg)
+    { return 1ULL << (phys_reg->flatIndex() % 64); }
 
     /** The number of actual physical registers */
     unsigned M5_CLASS_VAR_USED numPhysRegs;
@@ -83,7 +95,7 @@ class Scoreboard
             return true;
         }
 
-        bool ready = regScoreBoard[phys_reg->flatIndex()];
+        bool ready = word(phys_reg) & mask(phys_reg);
 
         if (phys_reg->isZeroReg())
             assert(ready);
@@ -105,7 +117,7 @@ class Scoreboard
         DPRINTF(Scoreboard, "Setting reg %i (%s) as ready\n",
                 phys_reg->index(), phys_reg->className());
 
-        regScoreBoard[phys_reg->flatIndex()] = true;
+        word(phys_reg) |= mask(phys_reg);
     }
 
     /** Sets the register as not ready. */
@@ -123,7 +135,7 @@ class Scoreboard
         if (phys_reg->isZeroReg())
             return;
 
-        regScoreBoard[phys_reg->flatIndex()] = false;
+        word(phys_reg) &= ~mask(phys_reg);
     }
 
 };
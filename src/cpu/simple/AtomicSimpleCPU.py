@@ -59,6 +59,8 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    decode_block_cache = Param.Bool(False, "Replay decoded basic blocks "
+        "without fetching and decoding them again (skips icache accesses)")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -90,6 +90,12 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
     data_read_req = std::make_shared<Request>();
     data_write_req = std::make_shared<Request>();
     data_amo_req = std::make_shared<Request>();
+
+    if (p->decode_block_cache) {
+        blockCaches.reserve(numThreads);
+        for (ThreadID tid = 0; tid < numThreads; tid++)
+            blockCaches.emplace_back(TheISA::PageBytes);
+    }
 }
 
 
@@ -150,6 +156,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed while the CPU was drained
+    flushDecodedBlocks();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -208,6 +217,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *oldCPU)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    flushDecodedBlocks();
 }
 
 void
@@ -302,6 +313,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
         for (auto &t_info : cpu->threadInfo) {
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
+        cpu->invalidateDecodedBlocks(pkt->getAddr());
     }
 
     return 0;
@@ -329,6 +341,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
     }
+
+    if (pkt->isWrite())
+        cpu->invalidateDecodedBlocks(pkt->getAddr());
 }
 
 bool
@@ -518,6 +533,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    invalidateDecodedBlocks(req->getPaddr());
                 }
                 dcache_access = true;
                 assert(!pkt.isError());
@@ -610,6 +626,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            invalidateDecodedBlocks(req->getPaddr());
         }
 
         dcache_access = true;
@@ -670,11 +687,33 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
-        if (needToFetch) {
+
+        // Instructions following the first one of a decoded block are
+        // neither translated nor fetched. Only a block's first instruction
+        // is translated to check that the block is still mapped.
+        const DecodedBlockCache::Inst *decoded = nullptr;
+        bool recordInst = false;
+        if (needToFetch && !blockCaches.empty())
+            decoded = blockCaches[curThread].replayNext(pcState);
+
+        if (needToFetch && !decoded) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->itb->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseTLB::Execute);
+
+            if (fault == NoFault && !blockCaches.empty() &&
+                t_info.fetchOffset == 0) {
+                decoded = blockCaches[curThread].enter(
+                        pcState, ifetch_req->getPaddr());
+                recordInst = !decoded;
+            }
+        }
+
+        if (decoded) {
+            predecodedInst = decoded->staticInst;
+            predecodedPC = decoded->decodedPC;
+            needToFetch = false;
         }
 
         if (fault == NoFault) {
@@ -705,9 +744,21 @@ AtomicSimpleCPU::tick()
 
             preExecute();
 
+            // Keep instructions that were decoded from a single fetch
+            if (recordInst && !t_info.stayAtPC) {
+                blockCaches[curThread].record(pcState, thread->pcState(),
+                        curMacroStaticInst ? curMacroStaticInst :
+                                             curStaticInst,
+                        ifetch_req->getPaddr());
+            }
+
             Tick stall_ticks = 0;
             if (curStaticInst) {
+#if ISA_DIRECT_EXECUTE
+                fault = curStaticInst->executeDirect(&t_info, traceData);
+#else
                 fault = curStaticInst->execute(&t_info, traceData);
+#endif
 
                 // keep an instruction count
                 if (fault == NoFault) {
@@ -728,6 +779,9 @@ AtomicSimpleCPU::tick()
                 postExecute();
             }
 
+            if (!blockCaches.empty())
+                updateBlockCache(fault);
+
             // @todo remove me after debugging with legion done
             if (curStaticInst && (!curStaticInst->isMicroop() ||
                         curStaticInst->isFirstMicroop()))
@@ -763,6 +817,24 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+void
+AtomicSimpleCPU::updateBlockCache(const Fault &fault)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    const StaticInstPtr &si = curStaticInst;
+
+    // Instructions that may change the translation or decoding context
+    // (mode switches, TLB maintenance, system calls that write memory
+    // behind the CPU's back) make every block suspect.
+    if (si && (si->isSerializing() || si->isNonSpeculative() ||
+               si->isSyscall() || si->isSquashAfter())) {
+        flushDecodedBlocks();
+    } else if (fault != NoFault || t_info.stayAtPC || !si ||
+               si->isControl()) {
+        blockCaches[curThread].endBlock();
+    }
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
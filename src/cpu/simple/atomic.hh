@@ -42,6 +42,7 @@
 #define __CPU_SIMPLE_ATOMIC_HH__
 
 #include "cpu/simple/base.hh"
+#include "cpu/simple/decoded_block_cache.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
@@ -65,9 +66,38 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Decoded basic blocks of each thread, empty if the block cache is
+     * disabled.
+     */
+    std::vector<DecodedBlockCache> blockCaches;
+
     // main simulation loop (one cycle)
     void tick();
 
+    /**
+     * End the decoded block of the current thread after executing an
+     * instruction, or flush all blocks if the instruction may have
+     * changed how the following instructions are decoded.
+     */
+    void updateBlockCache(const Fault &fault);
+
+    /** Flush the decoded blocks if a write to paddr may modify them. */
+    void
+    invalidateDecodedBlocks(Addr paddr)
+    {
+        for (auto &cache : blockCaches)
+            cache.invalidate(paddr);
+    }
+
+    /** Flush the decoded blocks of all threads. */
+    void
+    flushDecodedBlocks()
+    {
+        for (auto &cache : blockCaches)
+            cache.flush();
+    }
+
     /**
      * Check if a system is in a drained state.
      *
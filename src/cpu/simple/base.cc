@@ -520,17 +520,35 @@ BaseSimpleCPU::preExecute()
 
         TheISA::Decoder *decoder = &(thread->decoder);
 
-        //Predecode, ie bundle up an ExtMachInst
-        //If more fetch data is needed, pass it in.
-        Addr fetchPC = (pcState.instAddr() & PCMask) + t_info.fetchOffset;
-        //if (decoder->needMoreBytes())
-            decoder->moreBytes(pcState, fetchPC, inst);
-        //else
-        //    decoder->process();
-
-        //Decode an instruction if one is ready. Otherwise, we'll have to
-        //fetch beyond the MachInst at the current pc.
-        instPtr = decoder->decode(pcState);
+        if (predecodedInst) {
+            //The CPU already has this instruction decoded, so the decoder
+            //isn't used until fetching resumes.
+            instPtr = predecodedInst;
+            pcState = predecodedPC;
+            predecodedInst = NULL;
+            t_info.decoderBypassed = true;
+        } else {
+            //Fetching resumes after instructions that were decoded
+            //earlier. Make sure the decoder doesn't hold on to bytes it
+            //got before them.
+            if (t_info.decoderBypassed) {
+                decoder->reset();
+                t_info.decoderBypassed = false;
+            }
+
+            //Predecode, ie bundle up an ExtMachInst
+            //If more fetch data is needed, pass it in.
+            Addr fetchPC = (pcState.instAddr() & PCMask) +
+                t_info.fetchOffset;
+            //if (decoder->needMoreBytes())
+                decoder->moreBytes(pcState, fetchPC, inst);
+            //else
+            //    decoder->process();
+
+            //Decode an instruction if one is ready. Otherwise, we'll have
+            //to fetch beyond the MachInst at the current pc.
+            instPtr = decoder->decode(pcState);
+        }
         if (instPtr) {
             t_info.stayAtPC = false;
             thread->pcState(pcState);
@@ -104,6 +104,14 @@ class BaseSimpleCPU : public BaseCPU
     StaticInstPtr curMacroStaticInst;
 
   protected:
+    /**
+     * Instruction at the current PC that was decoded earlier. If set,
+     * preExecute() uses it and the PC state it was decoded to instead of
+     * decoding the fetched bytes.
+     */
+    StaticInstPtr predecodedInst;
+    TheISA::PCState predecodedPC;
+
     enum Status {
         Idle,
         Running,
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_DECODED_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_DECODED_BLOCK_CACHE_HH__
+
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "arch/types.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+/**
+ * Cache of decoded basic blocks for a single thread of the atomic CPU.
+ *
+ * While the CPU fetches and decodes instructions as usual, the decoded
+ * instructions are recorded as straight-line blocks ending at the first
+ * control, serializing or non-speculative instruction. When execution
+ * reaches the start of a recorded block again, the CPU translates the
+ * fetch address once, checks that it still maps to the physical page the
+ * block was recorded from and then takes the following instructions from
+ * the block without translating, fetching or decoding them.
+ *
+ * Each instruction is only used if the PC state of the thread is exactly
+ * the one it was decoded at, so interrupts, faults and PC events that
+ * redirect execution simply end the replay of a block. Each block keeps
+ * links to the blocks that followed it, which avoids the hash lookup on
+ * the common paths.
+ *
+ * Writes to a physical page holding decoded instructions flush the whole
+ * cache.
+ */
+class DecodedBlockCache
+{
+  public:
+    /** A decoded instruction. */
+    struct Inst
+    {
+        /** PC state the instruction was decoded at. */
+        TheISA::PCState pc;
+        /** PC state after decoding, as set by the decoder. */
+        TheISA::PCState decodedPC;
+        /** The instruction, or the macroop it belongs to. */
+        StaticInstPtr staticInst;
+    };
+
+  private:
+    struct Block
+    {
+        /** Physical page the instructions were fetched from. */
+        Addr physPage;
+        std::vector<Inst> insts;
+        /** Blocks that were entered after this one. */
+        std::array<Block *, 2> successors;
+    };
+
+    /** Longest block that is recorded. */
+    static const size_t maxBlockInsts = 64;
+
+    Addr pageMask;
+
+    /** Blocks by the address of their first instruction. */
+    std::unordered_map<Addr, Block> blocks;
+
+    /** Physical pages with instructions in blocks. */
+    std::unordered_set<Addr> codePages;
+
+    /** Block being replayed and the next instruction in it. */
+    Block *replaying;
+    size_t replayIdx;
+
+    /** Block being recorded, if any. */
+    Block *recording;
+
+    /** Block that was replayed or recorded last. */
+    Block *previous;
+
+    void
+    link(Block *block)
+    {
+        if (previous && previous != block &&
+            previous->successors[0] != block) {
+            previous->successors[1] = previous->successors[0];
+            previous->successors[0] = block;
+        }
+        previous = block;
+    }
+
+    Block *
+    find(const TheISA::PCState &pc)
+    {
+        Addr addr = pc.instAddr();
+        if (previous) {
+            for (auto block : previous->successors) {
+                if (block && block->insts[0].pc.instAddr() == addr)
+                    return block;
+            }
+        }
+        auto it = blocks.find(addr);
+        return it == blocks.end() ? nullptr : &it->second;
+    }
+
+  public:
+    DecodedBlockCache(Addr page_bytes)
+        : pageMask(~(page_bytes - 1)), replaying(nullptr), replayIdx(0),
+          recording(nullptr), previous(nullptr)
+    {}
+
+    /**
+     * Get the next instruction of the block being replayed, if the thread
+     * is at the PC it was decoded at.
+     */
+    const Inst *
+    replayNext(const TheISA::PCState &pc)
+    {
+        if (replaying) {
+            if (replayIdx < replaying->insts.size() &&
+                replaying->insts[replayIdx].pc == pc) {
+                return &replaying->insts[replayIdx++];
+            }
+            replaying = nullptr;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Start replaying a block at a PC whose fetch address was translated
+     * to phys_addr.
+     *
+     * @return The first instruction of the block, nullptr if there is no
+     * usable block.
+     */
+    const Inst *
+    enter(const TheISA::PCState &pc, Addr phys_addr)
+    {
+        Block *block = find(pc);
+        if (!block || block->insts.empty() || block->insts[0].pc != pc ||
+            block->physPage != (phys_addr & pageMask)) {
+            return nullptr;
+        }
+
+        recording = nullptr;
+        link(block);
+        replaying = block;
+        replayIdx = 1;
+        return &block->insts[0];
+    }
+
+    /**
+     * Record an instruction that was fetched from phys_addr and decoded.
+     * It starts a new block unless it directly follows the last
+     * instruction of the block being recorded.
+     */
+    void
+    record(const TheISA::PCState &pc, const TheISA::PCState &decoded_pc,
+           const StaticInstPtr &inst, Addr phys_addr)
+    {
+        Addr page = phys_addr & pageMask;
+        if (recording && (recording->physPage != page ||
+                          recording->insts.size() == maxBlockInsts ||
+                          recording->insts.back().decodedPC.npc() !=
+                              pc.instAddr())) {
+            recording = nullptr;
+        }
+
+        if (!recording) {
+            recording = &blocks[pc.instAddr()];
+            recording->physPage = page;
+            recording->insts.clear();
+            recording->successors.fill(nullptr);
+            codePages.insert(page);
+            link(recording);
+        }
+        recording->insts.push_back({pc, decoded_pc, inst});
+    }
+
+    /**
+     * End the block being recorded or replayed. The next instruction
+     * starts a new block.
+     */
+    void
+    endBlock()
+    {
+        recording = nullptr;
+        replaying = nullptr;
+    }
+
+    /** Flush everything if a write to phys_addr may modify a block. */
+    bool
+    invalidate(Addr phys_addr)
+    {
+        if (!codePages.count(phys_addr & pageMask))
+            return false;
+        flush();
+        return true;
+    }
+
+    void
+    flush()
+    {
+        blocks.clear();
+        codePages.clear();
+        replaying = nullptr;
+        recording = nullptr;
+        previous = nullptr;
+    }
+};
+
+#endif // __CPU_SIMPLE_DECODED_BLOCK_CACHE_HH__
@@ -54,7 +54,7 @@
 
 class BaseSimpleCPU;
 
-class SimpleExecContext : public ExecContext {
+class SimpleExecContext final : public ExecContext {
   protected:
     using VecRegContainer = TheISA::VecRegContainer;
     using VecElem = TheISA::VecElem;
@@ -68,6 +68,9 @@ class SimpleExecContext : public ExecContext {
     // This flag says to stay at the current pc. This is useful for
     // instructions which go beyond MachInst boundaries.
     bool stayAtPC;
+    // This flag says that instructions decoded earlier ran since the
+    // decoder last saw fetched bytes, so what it still holds is stale.
+    bool decoderBypassed;
 
     // Branch prediction
     TheISA::PCState predPC;
@@ -166,6 +169,7 @@ class SimpleExecContext : public ExecContext {
     /** Constructor */
     SimpleExecContext(BaseSimpleCPU* _cpu, SimpleThread* _thread)
         : cpu(_cpu), thread(_thread), fetchOffset(0), stayAtPC(false),
+        decoderBypassed(false),
         numInst(0), numOp(0), numLoad(0), lastIcacheStall(0), lastDcacheStall(0)
     { }
 
@@ -32,6 +32,10 @@
 
 #include "sim/core.hh"
 
+#if ISA_DIRECT_EXECUTE
+#include "cpu/simple/exec_context.hh"
+#endif
+
 namespace {
 
 static TheISA::ExtMachInst nopMachInst;
@@ -94,6 +98,15 @@ StaticInst::hasBranchTarget(const TheISA::PCState &pc, ThreadContext *tc,
     return false;
 }
 
+#if ISA_DIRECT_EXECUTE
+Fault
+StaticInst::executeDirect(SimpleExecContext *xc,
+                          Trace::InstRecord *traceData) const
+{
+    return execute(xc, traceData);
+}
+#endif
+
 StaticInstPtr
 StaticInst::fetchMicroop(MicroPC upc) const
 {
@@ -51,6 +51,7 @@
 #include "base/logging.hh"
 #include "base/refcnt.hh"
 #include "base/types.hh"
+#include "config/isa_direct_execute.hh"
 #include "config/the_isa.hh"
 #include "cpu/op_class.hh"
 #include "cpu/reg_class.hh"
@@ -63,6 +64,7 @@
 class Packet;
 
 class ExecContext;
+class SimpleExecContext;
 
 namespace Loader
 {
@@ -287,6 +289,17 @@ class StaticInst : public RefCounted, public StaticInstFlags
     virtual Fault execute(ExecContext *xc,
                           Trace::InstRecord *traceData) const = 0;
 
+#if ISA_DIRECT_EXECUTE
+    /**
+     * Execute the instruction in the context of a simple CPU. The ISA
+     * parser generates this as a copy of execute() specialized for
+     * SimpleExecContext, so operand accesses aren't virtual calls. The
+     * default calls execute().
+     */
+    virtual Fault executeDirect(SimpleExecContext *xc,
+                                Trace::InstRecord *traceData) const;
+#endif
+
     virtual Fault initiateAcc(ExecContext *xc,
                               Trace::InstRecord *traceData) const
     {
@@ -33,7 +33,6 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-from m5.defines import buildEnv
 from m5.SimObject import *
 
 from m5.objects.BaseTrafficGen import *
@@ -63,10 +62,8 @@ class PyTrafficGen(BaseTrafficGen):
     ]
 
     @cxxMethod(override=True)
-    def createTrace(self, duration, trace_file, addr_offset=0):
-        if buildEnv['HAVE_PROTOBUF']:
-            return self.getCCObject().createTrace(duration, trace_file,
-                                                  addr_offset=addr_offset)
-        else:
-            raise NotImplementedError("Trace playback requires that gem5 "
-                                      "was built with protobuf support.")
+    def createTrace(self, duration, trace_file, addr_offset=0,
+                    start_record=0):
+        return self.getCCObject().createTrace(duration, trace_file,
+                                              addr_offset=addr_offset,
+                                              start_record=start_record)
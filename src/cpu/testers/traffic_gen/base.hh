@@ -316,7 +316,8 @@ class BaseTrafficGen : public ClockedObject
 
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
-        const std::string& trace_file, Addr addr_offset);
+        const std::string& trace_file, Addr addr_offset,
+        uint64_t start_record);
 
   protected:
     void start();
@@ -42,39 +42,100 @@
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
+
+#if HAVE_PROTOBUF
 #include "proto/packet.pb.h"
+#endif
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   uint64_t start_record)
+    : startRecord(start_record)
 {
+    if (BinaryTrace::isBinaryTrace(filename)) {
+        binaryTrace.reset(new BinaryTrace::PacketReader(
+                              filename, BinaryTrace::PacketTrace));
+    } else {
+#if HAVE_PROTOBUF
+        protoTrace.reset(new ProtoInputStream(filename));
+#else
+        fatal("%s is not a binary trace, and protobuf traces require "
+              "gem5 to be built with protobuf support\n", filename);
+#endif
+    }
     init();
+    seek(startRecord);
 }
 
 void
 TraceGen::InputStream::init()
 {
+    if (binaryTrace) {
+        if (binaryTrace->mappedFile().tickFreq() != SimClock::Frequency) {
+            panic("Trace was recorded with a different tick frequency %d\n",
+                  binaryTrace->mappedFile().tickFreq());
+        }
+        return;
+    }
+
+#if HAVE_PROTOBUF
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!protoTrace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
     } else if (header_msg.tick_freq() != SimClock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
               header_msg.tick_freq());
     }
+#endif
 }
 
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    seek(startRecord);
+}
+
+void
+TraceGen::InputStream::seek(uint64_t record)
+{
+    if (binaryTrace) {
+        binaryTrace->seek(record);
+        return;
+    }
+
+#if HAVE_PROTOBUF
+    // Protobuf traces can only be played back from the start
+    protoTrace->reset();
     init();
+
+    ProtoMessage::Packet pkt_msg;
+    for (uint64_t i = 0; i < record; i++) {
+        fatal_if(!protoTrace->read(pkt_msg),
+                 "Cannot seek to record %d, the trace only holds %d\n",
+                 record, i);
+    }
+#endif
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (binaryTrace) {
+        BinaryTrace::PacketRecord rec;
+        if (!binaryTrace->read(rec))
+            return false;
+
+        element.cmd = rec.cmd;
+        element.addr = rec.addr;
+        element.blocksize = rec.size;
+        element.tick = rec.tick;
+        element.flags = rec.flags;
+        return true;
+    }
+
+#if HAVE_PROTOBUF
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (protoTrace->read(pkt_msg)) {
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
@@ -82,6 +143,7 @@ TraceGen::InputStream::read(TraceElement& element)
         element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         return true;
     }
+#endif
 
     // We have reached the end of the file
     return false;
@@ -44,11 +44,18 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
+#include "config/have_protobuf.hh"
+#include "cpu/trace/binary_trace.hh"
 #include "mem/packet.hh"
+
+#if HAVE_PROTOBUF
 #include "proto/protoio.hh"
+#endif
 
 /**
  * The trace replay generator reads a trace file and plays
@@ -107,21 +114,33 @@ class TraceGen : public BaseGen
 
       private:
 
-        /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+#if HAVE_PROTOBUF
+        /// Input file stream for a protobuf trace
+        std::unique_ptr<ProtoInputStream> protoTrace;
+#endif
+
+        /// Memory-mapped reader for a binary trace
+        std::unique_ptr<BinaryTrace::PacketReader> binaryTrace;
+
+        /// Index of the first record to play
+        const uint64_t startRecord;
 
       public:
 
         /**
-         * Create a trace input stream for a given file name.
+         * Create a trace input stream for a given file name. The
+         * format, protobuf or binary, is detected from the file
+         * contents. Protobuf traces need gem5 to be built with
+         * protobuf support.
          *
          * @param filename Path to the file to read from
+         * @param start_record Index of the first record to play
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, uint64_t start_record);
 
         /**
          * Reset the stream such that it can be played once
-         * again.
+         * again, starting from the start record.
          */
         void reset();
 
@@ -131,6 +150,15 @@ class TraceGen : public BaseGen
          */
         void init();
 
+        /**
+         * Move to a record index. This is constant time for binary
+         * traces, while protobuf traces have to be parsed from the
+         * start up to the record.
+         *
+         * @param record Index of the next record to read
+         */
+        void seek(uint64_t record);
+
         /**
          * Attempt to read a trace element from the stream,
          * and also notify the caller if the end of the file
@@ -152,11 +180,13 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param start_record Index of the first trace record to play
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             uint64_t start_record = 0)
         : BaseGen(obj, requestor_id, _duration),
-          trace(trace_file),
+          trace(trace_file, start_record),
           tickOffset(0),
           addrOffset(addr_offset),
           traceComplete(false)
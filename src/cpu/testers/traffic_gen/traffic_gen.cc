@@ -169,11 +169,25 @@ TrafficGen::parseConfig()
                 if (mode == "TRACE") {
                     string traceFile;
                     Addr addrOffset;
+                    // The index of the first record to play is optional
+                    uint64_t startRecord = 0;
 
                     is >> traceFile >> addrOffset;
+
+                    string rest;
+                    getline(is, rest);
+                    istringstream start_is(rest);
+                    if (!(start_is >> ws).eof() &&
+                        (!(start_is >> startRecord) ||
+                         !(start_is >> ws).eof())) {
+                        fatal("%s: Invalid start record for state %d: %s\n",
+                              name(), id, rest);
+                    }
+
                     traceFile = resolveFile(traceFile);
 
-                    states[id] = createTrace(duration, traceFile, addrOffset);
+                    states[id] = createTrace(duration, traceFile, addrOffset,
+                                             startRecord);
                     DPRINTF(TrafficGen, "State: %d TraceGen\n", id);
                 } else if (mode == "IDLE") {
                     states[id] = createIdle(duration);
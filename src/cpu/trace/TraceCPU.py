@@ -34,8 +34,16 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.params import *
+from m5.SimObject import SimObject
 from m5.objects.BaseCPU import BaseCPU
 
+class TraceSync(SimObject):
+    """Orders the synchronization points recorded in multi-core elastic
+    traces across the Trace CPUs replaying them. All Trace CPUs of the
+    replayed system must share the same instance."""
+    type = 'TraceSync'
+    cxx_header = "cpu/trace/trace_sync.hh"
+
 class TraceCPU(BaseCPU):
     """Trace CPU model which replays traces generated in a prior simulation
      using DerivO3CPU or its derived classes. It interfaces with L1 caches.
@@ -60,6 +68,17 @@ class TraceCPU(BaseCPU):
 
     instTraceFile = Param.String("", "Instruction trace file")
     dataTraceFile = Param.String("", "Data dependency trace file")
+    # Index of the first record to play from each trace. Seeking is
+    # constant time for binary traces, while protobuf traces are parsed
+    # up to the start record.
+    instTraceStart = Param.UInt64(0, "First record of the instruction trace")
+    dataTraceStart = Param.UInt64(0, "First record of the data dependency "\
+                                  "trace")
+    # When replaying traces recorded on a multi-core system, share a
+    # TraceSync between the Trace CPUs to honor the recorded order of
+    # atomics, barriers and other synchronizing instructions.
+    traceSync = Param.TraceSync(NULL, "Synchronization point ordering "\
+                                "shared by all Trace CPUs")
     sizeStoreBuffer = Param.Unsigned(16, "Number of entries in the store "\
         "buffer")
     sizeLoadBuffer = Param.Unsigned(16, "Number of entries in the load buffer")
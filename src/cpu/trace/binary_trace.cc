@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/trace/binary_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include "sim/byteswap.hh"
+
+namespace BinaryTrace
+{
+
+bool
+isBinaryTrace(const std::string &filename)
+{
+    std::ifstream is(filename, std::ios::in | std::ios::binary);
+    char buf[sizeof(magic)];
+    if (!is.read(buf, sizeof(buf)))
+        return false;
+    return std::memcmp(buf, magic, sizeof(magic)) == 0;
+}
+
+MappedFile::MappedFile(const std::string &_filename, RecordType type,
+                       uint32_t record_size)
+    : filename(_filename), data(nullptr), length(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Failed to open binary trace %s: %s\n", filename,
+             std::strerror(errno));
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) < 0, "Failed to stat binary trace %s: %s\n",
+             filename, std::strerror(errno));
+    length = st.st_size;
+    fatal_if(length < sizeof(Header), "Binary trace %s is truncated\n",
+             filename);
+
+    void *addr = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    fatal_if(addr == MAP_FAILED, "Failed to mmap binary trace %s: %s\n",
+             filename, std::strerror(errno));
+    // The mapping keeps its own reference to the file
+    close(fd);
+    data = static_cast<uint8_t *>(addr);
+
+    // Records are normally consumed front to back
+    madvise(addr, length, MADV_SEQUENTIAL);
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    fatal_if(std::memcmp(header.magic, magic, sizeof(magic)) != 0,
+             "%s is not a binary trace\n", filename);
+    fatal_if(letoh(header.version) != version,
+             "Binary trace %s has format version %d but only version %d "
+             "is supported, regenerate it with "
+             "util/convert_binary_trace.py\n", filename,
+             letoh(header.version), version);
+    fatal_if(letoh(header.recordType) != type,
+             "Binary trace %s holds records of type %d, expected %d\n",
+             filename, letoh(header.recordType), type);
+
+    _tickFreq = letoh(header.tickFreq);
+    _windowSize = letoh(header.windowSize);
+    recordSize = letoh(header.recordSize);
+    numRecords = letoh(header.numRecords);
+
+    fatal_if(recordSize != record_size,
+             "Binary trace %s has %d byte records, expected %d\n",
+             filename, recordSize, record_size);
+    fatal_if((length - sizeof(Header)) / recordSize < numRecords,
+             "Binary trace %s is truncated, expected %d records\n",
+             filename, numRecords);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data)
+        munmap(data, length);
+}
+
+template <>
+bool
+Reader<PacketRecord>::read(PacketRecord &record)
+{
+    if (pos >= file.size())
+        return false;
+
+    std::memcpy(&record, file.record(pos++), sizeof(record));
+    record.tick = letoh(record.tick);
+    record.addr = letoh(record.addr);
+    record.pc = letoh(record.pc);
+    record.size = letoh(record.size);
+    record.flags = letoh(record.flags);
+    record.cmd = letoh(record.cmd);
+    return true;
+}
+
+template <>
+bool
+Reader<InstDepRecord>::read(InstDepRecord &record)
+{
+    if (pos >= file.size())
+        return false;
+
+    std::memcpy(&record, file.record(pos++), sizeof(record));
+    record.seqNum = letoh(record.seqNum);
+    record.compDelay = letoh(record.compDelay);
+    record.physAddr = letoh(record.physAddr);
+    record.virtAddr = letoh(record.virtAddr);
+    record.pc = letoh(record.pc);
+    record.syncSeq = letoh(record.syncSeq);
+    record.syncDep = letoh(record.syncDep);
+    record.size = letoh(record.size);
+    record.flags = letoh(record.flags);
+    record.weight = letoh(record.weight);
+
+    fatal_if(record.numRobDep > InstDepRecord::maxRobDep ||
+             record.numRegDep > InstDepRecord::maxRegDep,
+             "Corrupt dependency record %d in %s\n", record.seqNum,
+             file.name());
+    for (int i = 0; i < record.numRobDep; i++)
+        record.robDep[i] = letoh(record.robDep[i]);
+    for (int i = 0; i < record.numRegDep; i++)
+        record.regDep[i] = letoh(record.regDep[i]);
+    return true;
+}
+
+} // namespace BinaryTrace
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A compact, fixed-size record trace format that can be memory mapped
+ * and randomly accessed. It is used as an alternative to the protobuf
+ * packet and instruction dependency traces, which have to be parsed
+ * message by message and can only be played back from the start.
+ *
+ * A binary trace consists of a single Header followed by numRecords
+ * records of recordSize bytes each. All fields are stored in little
+ * endian byte order. Traces are produced from the protobuf format by
+ * util/convert_binary_trace.py.
+ */
+
+#ifndef __CPU_TRACE_BINARY_TRACE_HH__
+#define __CPU_TRACE_BINARY_TRACE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+#include "base/logging.hh"
+
+namespace BinaryTrace
+{
+
+/** The magic number at the start of every binary trace. */
+static const char magic[8] = {'g', 'e', 'm', '5', 'b', 't', 'r', '\0'};
+
+/** Current version of the format. */
+static const uint32_t version = 2;
+
+/** The kind of record stored in a trace. */
+enum RecordType : uint32_t
+{
+    PacketTrace = 1,
+    InstDepTrace = 2
+};
+
+/** File header, padded to 64 bytes. */
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordType;
+    uint64_t tickFreq;
+    /** ROB window size, only used by instruction dependency traces. */
+    uint32_t windowSize;
+    uint32_t recordSize;
+    uint64_t numRecords;
+    uint8_t pad[24];
+};
+
+static_assert(sizeof(Header) == 64, "Unexpected binary trace header size");
+
+/** A memory request, as recorded by the communication monitor. */
+struct PacketRecord
+{
+    uint64_t tick;
+    uint64_t addr;
+    uint64_t pc;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t cmd;
+    uint32_t pad;
+};
+
+static_assert(sizeof(PacketRecord) == 40,
+              "Unexpected binary trace packet record size");
+
+/**
+ * An instruction dependency record, as produced by the elastic trace
+ * probe. Dependencies are stored as distances to seqNum rather than
+ * as absolute sequence numbers to keep them within 32 bits.
+ */
+struct InstDepRecord
+{
+    static const unsigned maxRobDep = 2;
+    static const unsigned maxRegDep = 8;
+
+    uint64_t seqNum;
+    uint64_t compDelay;
+    uint64_t physAddr;
+    uint64_t virtAddr;
+    uint64_t pc;
+    /** Global order of a synchronization point, 0 otherwise. */
+    uint64_t syncSeq;
+    /** Last sync point of another core preceding this one. */
+    uint64_t syncDep;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t weight;
+    uint8_t type;
+    uint8_t numRobDep;
+    uint8_t numRegDep;
+    uint8_t pad;
+    uint32_t robDep[maxRobDep];
+    uint32_t regDep[maxRegDep];
+};
+
+static_assert(sizeof(InstDepRecord) == 112,
+              "Unexpected binary trace instruction record size");
+
+/**
+ * Check if a file starts with the binary trace magic number. This is
+ * used by the trace readers to pick between the binary and the
+ * protobuf format.
+ *
+ * @param filename Path to the trace
+ * @return True if the file is a binary trace
+ */
+bool isBinaryTrace(const std::string &filename);
+
+/**
+ * A read-only memory mapping of a binary trace. The header is
+ * validated when the file is opened.
+ */
+class MappedFile
+{
+  public:
+
+    /**
+     * Map a trace and check that it holds records of the given type.
+     *
+     * @param filename Path to the trace
+     * @param type Expected record type
+     * @param record_size Expected size of each record in bytes
+     */
+    MappedFile(const std::string &filename, RecordType type,
+               uint32_t record_size);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /** Name of the mapped file. */
+    const std::string &name() const { return filename; }
+
+    /** Tick frequency the trace was recorded with. */
+    uint64_t tickFreq() const { return _tickFreq; }
+
+    /** ROB window size stored in the header. */
+    uint32_t windowSize() const { return _windowSize; }
+
+    /** Number of records in the trace. */
+    uint64_t size() const { return numRecords; }
+
+    /** Pointer to the first byte of record i. */
+    const uint8_t *
+    record(uint64_t i) const
+    {
+        assert(i < numRecords);
+        return data + sizeof(Header) + i * recordSize;
+    }
+
+  private:
+
+    const std::string filename;
+
+    /** Start of the mapping. */
+    uint8_t *data;
+
+    /** Length of the mapping in bytes. */
+    size_t length;
+
+    uint64_t _tickFreq;
+    uint32_t _windowSize;
+    uint32_t recordSize;
+    uint64_t numRecords;
+};
+
+/**
+ * Sequential reader over a mapped trace that supports seeking to an
+ * arbitrary record.
+ */
+template <class Record>
+class Reader
+{
+  public:
+
+    Reader(const std::string &filename, RecordType type)
+        : file(filename, type, sizeof(Record)), pos(0)
+    {}
+
+    const MappedFile &mappedFile() const { return file; }
+
+    /**
+     * Copy the next record out of the trace and convert it to host
+     * byte order.
+     *
+     * @return True if a record was read, false at the end of the trace
+     */
+    bool read(Record &record);
+
+    /** Rewind to the first record. */
+    void reset() { pos = 0; }
+
+    /**
+     * Move to a record index. Seeking to the end of the trace is
+     * allowed, and makes the next read fail.
+     */
+    void
+    seek(uint64_t index)
+    {
+        fatal_if(index > file.size(), "Cannot seek to record %d of %s, "
+                 "it only holds %d records\n", index, file.name(),
+                 file.size());
+        pos = index;
+    }
+
+    /** Index of the next record to be read. */
+    uint64_t tell() const { return pos; }
+
+  private:
+
+    MappedFile file;
+
+    uint64_t pos;
+};
+
+template <>
+bool Reader<PacketRecord>::read(PacketRecord &record);
+
+template <>
+bool Reader<InstDepRecord>::read(InstDepRecord &record);
+
+typedef Reader<PacketRecord> PacketReader;
+typedef Reader<InstDepRecord> InstDepReader;
+
+} // namespace BinaryTrace
+
+#endif // __CPU_TRACE_BINARY_TRACE_HH__
@@ -50,7 +50,8 @@ TraceCPU::TraceCPU(TraceCPUParams *params)
         dataRequestorID(params->system->getRequestorId(this, "data")),
         instTraceFile(params->instTraceFile),
         dataTraceFile(params->dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params->instTraceStart),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -128,9 +129,11 @@ TraceCPU::init()
     inform("%s: Time offset (tick) found as min of both traces is %lli.\n",
             name(), traceOffset);
 
-    // Schedule next icache and dcache event by subtracting the offset
+    // Schedule next icache and dcache event by subtracting the offset. The
+    // dcache event may already have been scheduled by a wakeup from a
+    // Trace CPU sharing sync points with this one.
     schedule(icacheNextEvent, first_icache_tick - traceOffset);
-    schedule(dcacheNextEvent, first_dcache_tick - traceOffset);
+    schedDcacheNextEvent(first_dcache_tick - traceOffset);
 
     // Adjust the trace offset for the dcache generator's ready nodes
     // We don't need to do this for the icache generator as it will
@@ -234,6 +237,8 @@ ElasticDataGenStatGroup::ElasticDataGenStatGroup(Stats::Group *parent,
     ADD_STAT(numSplitReqs, "Number of split requests"),
     ADD_STAT(numSOLoads, "Number of strictly ordered loads"),
     ADD_STAT(numSOStores, "Number of strictly ordered stores"),
+    ADD_STAT(numSyncStalls, "Number of attempts to issue a sync point that "
+             "waited for other Trace CPUs"),
     ADD_STAT(dataLastTick, "Last tick simulated from the elastic data trace")
 {
 }
@@ -309,9 +314,17 @@ TraceCPU::ElasticDataGen::readNextWindow()
         if (!trace.read(new_node)) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
+            delete new_node;
+            if (traceSync)
+                traceSync->traceComplete(syncCore);
             return false;
         }
 
+        // Make sync points known to the other Trace CPUs before this one
+        // attempts to issue them
+        if (traceSync && new_node->syncSeq != 0)
+            traceSync->read(syncCore, new_node->syncSeq);
+
         // Annotate the ROB dependencies of the new node onto the parent nodes.
         addDepsOnParent(new_node, new_node->robDep, new_node->numRobDep);
         // Annotate the register dependencies of the new node onto the parent
@@ -497,6 +510,7 @@ TraceCPU::ElasticDataGen::execute()
         if (!node_ptr->isLoad() || node_ptr->isStrictlyOrdered()) {
             // Release all resources occupied by the completed node
             hwResource.release(node_ptr);
+            completeSync(node_ptr);
             // clear the dynamically allocated set of dependents
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
@@ -543,7 +557,7 @@ TraceCPU::ElasticDataGen::execute()
                 next_event_tick);
         owner.schedDcacheNextEvent(next_event_tick);
     } else if (readyList.empty() && !depFreeQueue.empty() &&
-                hwResource.isAvailable(depFreeQueue.front())) {
+                mayIssue(depFreeQueue.front())) {
         DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
                 owner.clockEdge(Cycles(1)));
         owner.schedDcacheNextEvent(owner.clockEdge(Cycles(1)));
@@ -596,8 +610,10 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
-    // If this is not done it triggers assert in L1 cache for invalid contextId
-    req->setContext(ContextID(0));
+    // If this is not done it triggers assert in L1 cache for invalid
+    // contextId. Use the CPU id so that the caches can tell apart the
+    // LL/SC and locked accesses of Trace CPUs replaying a multi-core trace.
+    req->setContext(ContextID(owner.cpuId()));
 
     req->setPC(node_ptr->pc);
     // If virtual address is valid, set the virtual address field
@@ -649,8 +665,9 @@ TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
             node_ptr->robNum);
     }
 
-    // Check if resources are available to issue the specific node
-    if (hwResource.isAvailable(node_ptr)) {
+    // Check if resources are available to issue the specific node, and
+    // that it does not overtake a sync point of another Trace CPU
+    if (mayIssue(node_ptr)) {
         // If resources are free only then add to readyList
         DPRINTFR(TraceCPUData, "\t\tResources available for seq. num %lli. Adding"
             " to readyList, occupying resources.\n", node_ptr->seqNum);
@@ -663,6 +680,9 @@ TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
         return true;
 
     } else {
+        // Count every attempt held back by a sync point of another core
+        if (hwResource.isAvailable(node_ptr))
+            ++elasticStats.numSyncStalls;
         if (first) {
             // Although dependencies are complete, resources are not available.
             DPRINTFR(TraceCPUData, "\t\tResources unavailable for seq. num %lli."
@@ -676,6 +696,34 @@ TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
     }
 }
 
+bool
+TraceCPU::ElasticDataGen::mayIssue(const GraphNode* node_ptr) const
+{
+    if (!hwResource.isAvailable(node_ptr))
+        return false;
+
+    return !traceSync || node_ptr->syncSeq == 0 ||
+        traceSync->mayIssue(syncCore, node_ptr->syncSeq, node_ptr->syncDep);
+}
+
+void
+TraceCPU::ElasticDataGen::completeSync(const GraphNode* node_ptr)
+{
+    if (traceSync && node_ptr->syncSeq != 0)
+        traceSync->complete(syncCore, node_ptr->syncSeq);
+}
+
+void
+TraceCPU::ElasticDataGen::syncWakeup()
+{
+    // Nothing can be waiting once the trace has been replayed, and a
+    // pending retry brings control back to execute() on its own
+    if (execComplete || retryPkt || depFreeQueue.empty())
+        return;
+
+    owner.schedDcacheNextEvent(owner.clockEdge(Cycles(1)));
+}
+
 void
 TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
 {
@@ -696,6 +744,7 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
 
         // Release resources occupied by the load
         hwResource.release(node_ptr);
+        completeSync(node_ptr);
 
         DPRINTF(TraceCPUData, "Load seq. num %lli response received. Waking up"
                 " dependents..\n", node_ptr->seqNum);
@@ -1179,38 +1228,125 @@ TraceCPU::DcachePort::recvReqRetry()
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
     const std::string& filename,
-    const double time_multiplier)
-    : trace(filename),
+    const double time_multiplier,
+    uint64_t start_record)
+    : startRecord(start_record),
       timeMultiplier(time_multiplier),
       microOpCount(0)
 {
-    // Create a protobuf message for the header and read it from the stream
-    ProtoMessage::InstDepRecordHeader header_msg;
-    if (!trace.read(header_msg)) {
-        panic("Failed to read packet header from %s\n", filename);
+    if (BinaryTrace::isBinaryTrace(filename)) {
+        binaryTrace.reset(new BinaryTrace::InstDepReader(
+                              filename, BinaryTrace::InstDepTrace));
+        const auto &file = binaryTrace->mappedFile();
+        fatal_if(file.tickFreq() != SimClock::Frequency,
+                 "Trace %s was recorded with a different tick frequency %d\n",
+                 filename, file.tickFreq());
+        windowSize = file.windowSize();
+    } else {
+        protoTrace.reset(new ProtoInputStream(filename));
 
-        if (header_msg.tick_freq() != SimClock::Frequency) {
-            panic("Trace %s was recorded with a different tick frequency %d\n",
-                  header_msg.tick_freq());
+        // Create a protobuf message for the header and read it from the
+        // stream
+        ProtoMessage::InstDepRecordHeader header_msg;
+        if (!protoTrace->read(header_msg)) {
+            panic("Failed to read packet header from %s\n", filename);
+
+            if (header_msg.tick_freq() != SimClock::Frequency) {
+                panic("Trace %s was recorded with a different tick "
+                      "frequency %d\n", header_msg.tick_freq());
+            }
+        } else {
+            // Assign window size equal to the field in the trace that was
+            // recorded when the data dependency trace was captured in the
+            // o3cpu model
+            windowSize = header_msg.window_size();
         }
-    } else {
-        // Assign window size equal to the field in the trace that was recorded
-        // when the data dependency trace was captured in the o3cpu model
-        windowSize = header_msg.window_size();
     }
+
+    seek(startRecord);
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    seek(startRecord);
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::seek(uint64_t record)
+{
+    if (binaryTrace) {
+        binaryTrace->seek(record);
+        return;
+    }
+
+    // Protobuf traces can only be played back from the start
+    protoTrace->reset();
+    ProtoMessage::InstDepRecordHeader header_msg;
+    protoTrace->read(header_msg);
+
+    ProtoMessage::InstDepRecord pkt_msg;
+    for (uint64_t i = 0; i < record; i++) {
+        fatal_if(!protoTrace->read(pkt_msg),
+                 "Cannot seek to record %d, the trace only holds %d\n",
+                 record, i);
+    }
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
 {
+    if (binaryTrace) {
+        BinaryTrace::InstDepRecord rec;
+        if (!binaryTrace->read(rec))
+            return false;
+
+        element->seqNum = rec.seqNum;
+        element->type = static_cast<Record::RecordType>(rec.type);
+        // Scale the compute delay to effectively scale the Trace CPU
+        // frequency
+        element->compDelay = rec.compDelay * timeMultiplier;
+
+        // Dependencies are stored as distances to the sequence number
+        element->clearRobDep();
+        assert(rec.numRobDep <= element->maxRobDep);
+        for (int i = 0; i < rec.numRobDep; i++) {
+            element->robDep[element->numRobDep] = rec.seqNum - rec.robDep[i];
+            element->numRobDep += 1;
+        }
+
+        element->clearRegDep();
+        assert(rec.numRegDep <= TheISA::MaxInstSrcRegs);
+        for (int i = 0; i < rec.numRegDep; i++) {
+            // As for protobuf traces, drop register dependencies that
+            // duplicate an order dependency
+            NodeSeqNum reg_dep = rec.seqNum - rec.regDep[i];
+            bool duplicate = false;
+            for (int j = 0; j < element->numRobDep; j++) {
+                duplicate |= (reg_dep == element->robDep[j]);
+            }
+            if (!duplicate) {
+                element->regDep[element->numRegDep] = reg_dep;
+                element->numRegDep += 1;
+            }
+        }
+
+        element->physAddr = rec.physAddr;
+        element->virtAddr = rec.virtAddr;
+        element->size = rec.size;
+        element->flags = rec.flags;
+        element->pc = rec.pc;
+        element->syncSeq = rec.syncSeq;
+        element->syncDep = rec.syncDep;
+
+        // ROB occupancy number
+        microOpCount += 1 + rec.weight;
+        element->robNum = microOpCount;
+        return true;
+    }
+
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (protoTrace->read(pkt_msg)) {
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -1268,6 +1404,16 @@ TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
         else
             element->pc = 0;
 
+        if (pkt_msg.has_sync_seq())
+            element->syncSeq = pkt_msg.sync_seq();
+        else
+            element->syncSeq = 0;
+
+        if (pkt_msg.has_sync_dep())
+            element->syncDep = pkt_msg.sync_dep();
+        else
+            element->syncDep = 0;
+
         // ROB occupancy number
         ++microOpCount;
         if (pkt_msg.has_weight()) {
@@ -1387,32 +1533,81 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(
+    const std::string& filename, uint64_t start_record)
+    : startRecord(start_record)
 {
-    // Create a protobuf message for the header and read it from the stream
-    ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
-        panic("Failed to read packet header from %s\n", filename);
+    if (BinaryTrace::isBinaryTrace(filename)) {
+        binaryTrace.reset(new BinaryTrace::PacketReader(
+                              filename, BinaryTrace::PacketTrace));
+        fatal_if(binaryTrace->mappedFile().tickFreq() != SimClock::Frequency,
+                 "Trace %s was recorded with a different tick frequency %d\n",
+                 filename, binaryTrace->mappedFile().tickFreq());
+    } else {
+        protoTrace.reset(new ProtoInputStream(filename));
+
+        // Create a protobuf message for the header and read it from the
+        // stream
+        ProtoMessage::PacketHeader header_msg;
+        if (!protoTrace->read(header_msg)) {
+            panic("Failed to read packet header from %s\n", filename);
 
-        if (header_msg.tick_freq() != SimClock::Frequency) {
-            panic("Trace %s was recorded with a different tick frequency %d\n",
-                  header_msg.tick_freq());
+            if (header_msg.tick_freq() != SimClock::Frequency) {
+                panic("Trace %s was recorded with a different tick "
+                      "frequency %d\n", header_msg.tick_freq());
+            }
         }
     }
+
+    seek(startRecord);
 }
 
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
-    trace.reset();
+    seek(startRecord);
+}
+
+void
+TraceCPU::FixedRetryGen::InputStream::seek(uint64_t record)
+{
+    if (binaryTrace) {
+        binaryTrace->seek(record);
+        return;
+    }
+
+    // Protobuf traces can only be played back from the start
+    protoTrace->reset();
+    ProtoMessage::PacketHeader header_msg;
+    protoTrace->read(header_msg);
+
+    ProtoMessage::Packet pkt_msg;
+    for (uint64_t i = 0; i < record; i++) {
+        fatal_if(!protoTrace->read(pkt_msg),
+                 "Cannot seek to record %d, the trace only holds %d\n",
+                 record, i);
+    }
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
 {
+    if (binaryTrace) {
+        BinaryTrace::PacketRecord rec;
+        if (!binaryTrace->read(rec))
+            return false;
+
+        element->cmd = rec.cmd;
+        element->addr = rec.addr;
+        element->blocksize = rec.size;
+        element->tick = rec.tick;
+        element->flags = rec.flags;
+        element->pc = rec.pc;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (protoTrace->read(pkt_msg)) {
         element->cmd = pkt_msg.cmd();
         element->addr = pkt_msg.addr();
         element->blocksize = pkt_msg.size();
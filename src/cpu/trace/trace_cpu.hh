@@ -40,6 +40,7 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <queue>
 #include <set>
 #include <unordered_map>
@@ -47,6 +48,8 @@
 #include "arch/registers.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/trace/binary_trace.hh"
+#include "cpu/trace/trace_sync.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
 #include "params/TraceCPU.hh"
@@ -391,24 +394,43 @@ class TraceCPU : public BaseCPU
 
           private:
 
-            // Input file stream for the protobuf trace
-            ProtoInputStream trace;
+            // Input file stream for a protobuf trace
+            std::unique_ptr<ProtoInputStream> protoTrace;
+
+            // Memory-mapped reader for a binary trace
+            std::unique_ptr<BinaryTrace::PacketReader> binaryTrace;
+
+            // Index of the first record to play
+            const uint64_t startRecord;
 
           public:
 
             /**
-             * Create a trace input stream for a given file name.
+             * Create a trace input stream for a given file name. The
+             * format, protobuf or binary, is detected from the file
+             * contents.
              *
              * @param filename Path to the file to read from
+             * @param start_record Index of the first record to play
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename,
+                        uint64_t start_record);
 
             /**
              * Reset the stream such that it can be played once
-             * again.
+             * again, starting from the start record.
              */
             void reset();
 
+            /**
+             * Move to a record index. This is constant time for binary
+             * traces, while protobuf traces have to be parsed from the
+             * start up to the record.
+             *
+             * @param record Index of the next record to read
+             */
+            void seek(uint64_t record);
+
             /**
              * Attempt to read a trace element from the stream,
              * and also notify the caller if the end of the file
@@ -424,11 +446,11 @@ class TraceCPU : public BaseCPU
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file)
+                   const std::string& trace_file, uint64_t trace_start)
             : owner(_owner),
               port(_port),
               requestorId(requestor_id),
-              trace(trace_file),
+              trace(trace_file, trace_start),
               genName(owner.name() + ".fixedretry." + _name),
               retryPkt(nullptr),
               delta(0),
@@ -634,6 +656,18 @@ class TraceCPU : public BaseCPU
             /** Number of register dependencies */
             uint8_t numRegDep;
 
+            /**
+             * Global order of the node if it is a synchronization point
+             * of a multi-core trace, 0 otherwise
+             */
+            uint64_t syncSeq;
+
+            /**
+             * Last synchronization point of another core that has to
+             * complete before this one may issue
+             */
+            uint64_t syncDep;
+
             /**
              * A vector of nodes dependent (outgoing) on this node. A
              * sequential container is chosen because when dependents become
@@ -795,8 +829,14 @@ class TraceCPU : public BaseCPU
 
           private:
 
-            /** Input file stream for the protobuf trace */
-            ProtoInputStream trace;
+            /** Input file stream for a protobuf trace */
+            std::unique_ptr<ProtoInputStream> protoTrace;
+
+            /** Memory-mapped reader for a binary trace */
+            std::unique_ptr<BinaryTrace::InstDepReader> binaryTrace;
+
+            /** Index of the first record to play */
+            const uint64_t startRecord;
 
             /**
              * A multiplier for the compute delays in the trace to modulate
@@ -817,20 +857,33 @@ class TraceCPU : public BaseCPU
           public:
 
             /**
-             * Create a trace input stream for a given file name.
+             * Create a trace input stream for a given file name. The
+             * format, protobuf or binary, is detected from the file
+             * contents.
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param start_record Index of the first record to play
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        uint64_t start_record);
 
             /**
              * Reset the stream such that it can be played once
-             * again.
+             * again, starting from the start record.
              */
             void reset();
 
+            /**
+             * Move to a record index. This is constant time for binary
+             * traces, while protobuf traces have to be parsed from the
+             * start up to the record.
+             *
+             * @param record Index of the next record to read
+             */
+            void seek(uint64_t record);
+
             /**
              * Attempt to read a trace element from the stream,
              * and also notify the caller if the end of the file
@@ -857,7 +910,8 @@ class TraceCPU : public BaseCPU
             : owner(_owner),
               port(_port),
               requestorId(requestor_id),
-              trace(trace_file, 1.0 / params->freqMultiplier),
+              trace(trace_file, 1.0 / params->freqMultiplier,
+                    params->dataTraceStart),
               genName(owner.name() + ".elastic." + _name),
               retryPkt(nullptr),
               traceComplete(false),
@@ -865,10 +919,17 @@ class TraceCPU : public BaseCPU
               execComplete(false),
               windowSize(trace.getWindowSize()),
               hwResource(params->sizeROB, params->sizeStoreBuffer,
-                         params->sizeLoadBuffer), elasticStats(&_owner, _name)
+                         params->sizeLoadBuffer),
+              traceSync(params->traceSync),
+              syncCore(-1),
+              elasticStats(&_owner, _name)
         {
             DPRINTF(TraceCPUData, "Window size in the trace is %d.\n",
                     windowSize);
+            // Register before any trace is read, so that no core issues
+            // a sync point while another one has yet to read its trace
+            if (traceSync)
+                syncCore = traceSync->registerCore([this]{ syncWakeup(); });
         }
 
         /**
@@ -978,6 +1039,31 @@ class TraceCPU : public BaseCPU
          */
         bool checkAndIssue(const GraphNode* node_ptr, bool first = true);
 
+        /**
+         * Check if a dependency-free node may issue. Besides hardware
+         * resources, a synchronization point has to wait for the points
+         * of the other Trace CPUs that it was recorded after.
+         *
+         * @param node_ptr pointer to node to be issued
+         * @return true if the node may be added to the readyList
+         */
+        bool mayIssue(const GraphNode* node_ptr) const;
+
+        /**
+         * Notify the shared TraceSync that a synchronization point has
+         * completed. Does nothing for other nodes.
+         *
+         * @param node_ptr pointer to the completed node
+         */
+        void completeSync(const GraphNode* node_ptr);
+
+        /**
+         * Called by the shared TraceSync when another Trace CPU has made
+         * progress on its synchronization points, to retry issuing a node
+         * that was waiting for them.
+         */
+        void syncWakeup();
+
         /** Get number of micro-ops modelled in the TraceCPU replay */
         uint64_t getMicroOpCount() const { return trace.getMicroOpCount(); }
 
@@ -1043,6 +1129,12 @@ class TraceCPU : public BaseCPU
         /** List of nodes that are ready to execute */
         std::list<ReadyNode> readyList;
 
+        /** Synchronization point ordering shared with other Trace CPUs */
+        TraceSync *traceSync;
+
+        /** Identifier of this Trace CPU in the TraceSync */
+        int syncCore;
+
       protected:
         // Defining the a stat group
         struct ElasticDataGenStatGroup : public Stats::Group
@@ -1060,6 +1152,8 @@ class TraceCPU : public BaseCPU
             Stats::Scalar numSplitReqs;
             Stats::Scalar numSOLoads;
             Stats::Scalar numSOStores;
+            /** Attempts to issue a sync point held back by other CPUs */
+            Stats::Scalar numSyncStalls;
             /** Tick when ElasticDataGen completes execution */
             Stats::Scalar dataLastTick;
         } elasticStats;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/trace/trace_sync.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/TraceCPUData.hh"
+
+TraceSync::TraceSync(const TraceSyncParams *p)
+    : SimObject(p), completedPrefix(0)
+{
+}
+
+int
+TraceSync::registerCore(WakeupFunc wakeup)
+{
+    cores.emplace_back();
+    cores.back().wakeup = wakeup;
+    return cores.size() - 1;
+}
+
+void
+TraceSync::read(int core, uint64_t sync_seq)
+{
+    Core &c = cores[core];
+    panic_if(sync_seq <= c.lastRead, "Sync point %d of core %d read out "
+             "of order, last read was %d\n", sync_seq, core, c.lastRead);
+    c.pending.insert(sync_seq);
+    c.lastRead = sync_seq;
+
+    // Cores waiting for this one to read past their points may proceed
+    wakeupOthers(core);
+}
+
+void
+TraceSync::traceComplete(int core)
+{
+    cores[core].traceComplete = true;
+    wakeupOthers(core);
+}
+
+bool
+TraceSync::mayIssue(int core, uint64_t sync_seq, uint64_t sync_dep) const
+{
+    // Points of the same core issue in order
+    assert(!cores[core].pending.empty());
+    if (*cores[core].pending.begin() != sync_seq)
+        return false;
+
+    if (sync_dep <= completedPrefix)
+        return true;
+
+    // Points may be missing from the replay, check that none of the
+    // other cores holds or may still read one up to the watermark
+    for (int i = 0; i < cores.size(); i++) {
+        if (i == core)
+            continue;
+
+        const Core &c = cores[i];
+        if (!c.pending.empty() && *c.pending.begin() <= sync_dep)
+            return false;
+        if (!c.traceComplete && c.lastRead < sync_dep)
+            return false;
+    }
+    return true;
+}
+
+void
+TraceSync::complete(int core, uint64_t sync_seq)
+{
+    auto it = cores[core].pending.find(sync_seq);
+    assert(it != cores[core].pending.end());
+    cores[core].pending.erase(it);
+
+    completed.insert(sync_seq);
+    while (!completed.empty() && *completed.begin() == completedPrefix + 1) {
+        ++completedPrefix;
+        completed.erase(completed.begin());
+    }
+
+    DPRINTF(TraceCPUData, "Sync point %lli of core %d complete.\n",
+            sync_seq, core);
+
+    wakeupOthers(core);
+}
+
+void
+TraceSync::wakeupOthers(int core)
+{
+    for (int i = 0; i < cores.size(); i++) {
+        if (i != core)
+            cores[i].wakeup();
+    }
+}
+
+TraceSync *
+TraceSyncParams::create()
+{
+    return new TraceSync(this);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the object that orders synchronization points across
+ * the Trace CPUs replaying a multi-core elastic trace.
+ */
+
+#ifndef __CPU_TRACE_TRACE_SYNC_HH__
+#define __CPU_TRACE_TRACE_SYNC_HH__
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "params/TraceSync.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * The elastic trace probe numbers the synchronization points (atomics,
+ * barriers, LL/SC and locked accesses) of all the cores it traces in a
+ * single global commit order, and records with each point the last
+ * point another core committed before it. During replay, every Trace
+ * CPU of the multi-core system shares a TraceSync, which only lets a
+ * core issue a synchronization point once all the points up to that
+ * watermark have completed. The points of a core issue in order, and
+ * all other nodes are still replayed elastically, so the memory system
+ * sees the recorded interleaving of synchronizing accesses without the
+ * cores running in lock step.
+ *
+ * Points are numbered densely, so the completed points are tracked as
+ * a prefix of the global order. If points are missing from the replay,
+ * e.g. as a trace is played from a start record, the prefix stops at
+ * the gap. A point past the gap may then still issue if no core has a
+ * point up to its watermark outstanding, and every other core has
+ * either read past the watermark or reached the end of its trace.
+ */
+class TraceSync : public SimObject
+{
+  public:
+
+    /** Called when a blocked core should re-check its sync points. */
+    typedef std::function<void()> WakeupFunc;
+
+    TraceSync(const TraceSyncParams *p);
+
+    /**
+     * Add a core to the replay.
+     *
+     * @param wakeup Function called when the core may be able to issue
+     * @return Identifier of the core
+     */
+    int registerCore(WakeupFunc wakeup);
+
+    /**
+     * Note that a core has read a synchronization point from its trace.
+     * Sync points must be read in increasing order.
+     *
+     * @param core Identifier of the core
+     * @param sync_seq Sequence number of the sync point
+     */
+    void read(int core, uint64_t sync_seq);
+
+    /**
+     * Note that a core has read all of its trace, so none of its
+     * outstanding points can be earlier than the last one read.
+     *
+     * @param core Identifier of the core
+     */
+    void traceComplete(int core);
+
+    /**
+     * Check if a core may issue a synchronization point.
+     *
+     * @param core Identifier of the core
+     * @param sync_seq Sequence number of the sync point
+     * @param sync_dep Last point of another core recorded before it
+     * @return True if all points up to sync_dep have completed
+     */
+    bool mayIssue(int core, uint64_t sync_seq, uint64_t sync_dep) const;
+
+    /**
+     * Note that a synchronization point has completed, and wake up the
+     * cores that may be waiting for it.
+     *
+     * @param core Identifier of the core
+     * @param sync_seq Sequence number of the sync point
+     */
+    void complete(int core, uint64_t sync_seq);
+
+  private:
+
+    /** Per-core view of the sync points */
+    struct Core
+    {
+        /** Points read from the trace that have not completed yet */
+        std::set<uint64_t> pending;
+
+        /** Last point read from the trace */
+        uint64_t lastRead = 0;
+
+        /** Whether the whole trace has been read */
+        bool traceComplete = false;
+
+        WakeupFunc wakeup;
+    };
+
+    /** Wake up all cores but the one that made progress */
+    void wakeupOthers(int core);
+
+    std::vector<Core> cores;
+
+    /** All points up to this one have completed */
+    uint64_t completedPrefix;
+
+    /** Completed points past the prefix */
+    std::set<uint64_t> completed;
+};
+
+#endif // __CPU_TRACE_TRACE_SYNC_HH__
@@ -37,6 +37,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.params import *
+from m5.proxy import *
 from m5.objects.ClockedObject import ClockedObject
 
 class Bridge(ClockedObject):
@@ -57,3 +58,10 @@ class Bridge(ClockedObject):
     delay = Param.Latency('0ns', "The latency of this bridge")
     ranges = VectorParam.AddrRange([AllMemory],
                                    "Address ranges to pass through the bridge")
+
+    # Placing the memory side on a different event queue lets the
+    # objects behind the bridge be simulated by another thread. The
+    # delay of the bridge is then the lookahead between the two
+    # threads, and must be at least one simulation quantum.
+    mem_side_eventq_index = Param.UInt32(Self.eventq_index,
+        "Event queue of the memory side of the bridge")
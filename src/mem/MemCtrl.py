@@ -90,3 +90,8 @@ class MemCtrl(QoSMemCtrl):
     static_backend_latency = Param.Latency("10ns", "Static backend latency")
 
     command_window = Param.Latency("10ns", "Static backend latency")
+
+    # stop the DRAM refresh events while the controller is idle, and
+    # account for the refreshes, power state residency and energy when
+    # the controller is next used or its stats are dumped
+    lazy_refresh = Param.Bool(True, "Defer DRAM refreshes while idle")
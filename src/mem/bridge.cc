@@ -46,6 +46,7 @@
 
 #include "mem/bridge.hh"
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/Bridge.hh"
 #include "params/Bridge.hh"
@@ -69,7 +70,7 @@ Bridge::BridgeRequestPort::BridgeRequestPort(const std::string& _name,
                                            Cycles _delay, int _req_limit)
     : RequestPort(_name, &_bridge), bridge(_bridge),
       cpuSidePort(_cpuSidePort),
-      delay(_delay), reqQueueLimit(_req_limit),
+      delay(_delay), reqQueueLimit(_req_limit), outstandingRequests(0),
       sendEvent([this]{ trySendTiming(); }, _name)
 {
 }
@@ -79,7 +80,9 @@ Bridge::Bridge(Params *p)
       cpuSidePort(p->name + ".cpu_side_port", *this, memSidePort,
                 ticksToCycles(p->delay), p->resp_size, p->ranges),
       memSidePort(p->name + ".mem_side_port", *this, cpuSidePort,
-                 ticksToCycles(p->delay), p->req_size)
+                 ticksToCycles(p->delay), p->req_size),
+      memSideQueue(getEventQueue(p->mem_side_eventq_index)),
+      delay(p->delay)
 {
 }
 
@@ -104,6 +107,22 @@ Bridge::init()
 
     // notify the request side  of our address ranges
     cpuSidePort.sendRangeChange();
+
+    // packets crossing between event queues are scheduled as
+    // asynchronous events, which only take effect at the end of the
+    // current quantum
+    fatal_if(crossQueue() && delay < simQuantum,
+             "%s: delay %d must be at least the simulation quantum %d to "
+             "cross event queues\n", name(), delay, simQuantum);
+}
+
+Tick
+Bridge::memSideClockEdge(Cycles cycles) const
+{
+    if (!crossQueue())
+        return clockEdge(cycles);
+
+    return roundUp(curTick(), clockPeriod()) + cycles * clockPeriod();
 }
 
 bool
@@ -115,6 +134,11 @@ Bridge::BridgeResponsePort::respQueueFull() const
 bool
 Bridge::BridgeRequestPort::reqQueueFull() const
 {
+    // on different event queues, the response port side keeps track of
+    // the space on its own
+    if (bridge.crossQueue())
+        return outstandingRequests == reqQueueLimit;
+
     return transmitList.size() == reqQueueLimit;
 }
 
@@ -134,8 +158,17 @@ Bridge::BridgeRequestPort::recvTimingResp(PacketPtr pkt)
     Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
     pkt->headerDelay = pkt->payloadDelay = 0;
 
-    cpuSidePort.schedTimingResp(pkt, bridge.clockEdge(delay) +
-                              receive_delay);
+    Tick when = bridge.memSideClockEdge(delay) + receive_delay;
+
+    if (bridge.crossQueue()) {
+        // hand the response over to the response port thread
+        bridge.schedule(new EventFunctionWrapper(
+                            [this, pkt, when]{
+                                cpuSidePort.schedTimingResp(pkt, when);
+                            }, name() + ".transitEvent", true), when);
+    } else {
+        cpuSidePort.schedTimingResp(pkt, when);
+    }
 
     return true;
 }
@@ -213,6 +246,20 @@ Bridge::BridgeResponsePort::retryStalledReq()
 void
 Bridge::BridgeRequestPort::schedTimingReq(PacketPtr pkt, Tick when)
 {
+    if (bridge.crossQueue()) {
+        // reserve the space until the request has been sent on, and
+        // hand the request over to the request port thread
+        ++outstandingRequests;
+        auto transit = transitList.emplace(transitList.end(), pkt);
+
+        bridge.memSideQueue->schedule(new EventFunctionWrapper(
+                                          [this, transit, when]{
+                                              recvTransitReq(transit, when);
+                                          }, name() + ".transitEvent", true),
+                                      when);
+        return;
+    }
+
     // If we're about to put this packet at the head of the queue, we
     // need to schedule an event to do the transmit.  Otherwise there
     // should already be an event scheduled for sending the head
@@ -226,6 +273,47 @@ Bridge::BridgeRequestPort::schedTimingReq(PacketPtr pkt, Tick when)
     transmitList.emplace_back(pkt, when);
 }
 
+void
+Bridge::BridgeRequestPort::recvTransitReq(
+    std::list<TransitPacket>::iterator transit, Tick when)
+{
+    transit->delivered = true;
+
+    if (transmitList.empty()) {
+        bridge.memSideQueue->schedule(&sendEvent, when);
+    }
+
+    assert(transmitList.size() != reqQueueLimit);
+
+    transmitList.emplace_back(transit->pkt, when);
+
+    // the request is now in our queue, and the response port side can
+    // forget about it
+    bridge.schedule(new EventFunctionWrapper(
+                        [this, transit]{ transitList.erase(transit); },
+                        name() + ".transitEvent", true),
+                    bridge.memSideClockEdge(delay));
+}
+
+void
+Bridge::BridgeRequestPort::releaseReq()
+{
+    if (!bridge.crossQueue()) {
+        cpuSidePort.retryStalledReq();
+        return;
+    }
+
+    // return the space to the response port side, and retry any
+    // request it stalled
+    bridge.schedule(new EventFunctionWrapper(
+                        [this]{
+                            assert(outstandingRequests != 0);
+                            --outstandingRequests;
+                            cpuSidePort.retryStalledReq();
+                        }, name() + ".transitEvent", true),
+                    bridge.memSideClockEdge(delay));
+}
+
 
 void
 Bridge::BridgeResponsePort::schedTimingResp(PacketPtr pkt, Tick when)
@@ -264,15 +352,16 @@ Bridge::BridgeRequestPort::trySendTiming()
         if (!transmitList.empty()) {
             DeferredPacket next_req = transmitList.front();
             DPRINTF(Bridge, "Scheduling next send\n");
-            bridge.schedule(sendEvent, std::max(next_req.tick,
-                                                bridge.clockEdge()));
+            bridge.memSideQueue->schedule(&sendEvent,
+                                          std::max(next_req.tick,
+                                              bridge.memSideClockEdge()));
         }
 
         // if we have stalled a request due to a full request queue,
         // then send a retry at this point, also note that if the
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
-        cpuSidePort.retryStalledReq();
+        releaseReq();
     }
 
     // if the send failed, then we try again once we receive a retry,
@@ -341,6 +430,10 @@ Bridge::BridgeResponsePort::recvAtomic(PacketPtr pkt)
     panic_if(pkt->cacheResponding(), "Should not see packets where cache "
              "is responding");
 
+    // atomic accesses are not deterministic when crossing event queues
+    EventQueue::ScopedMigration migrate(bridge.memSideQueue,
+                                        inParallelMode);
+
     return delay * bridge.clockPeriod() + memSidePort.sendAtomic(pkt);
 }
 
@@ -357,6 +450,12 @@ Bridge::BridgeResponsePort::recvFunctional(PacketPtr pkt)
         }
     }
 
+    // the request port side is not ours to look at unless we hold its
+    // event queue, which makes the access timing dependent, much like
+    // any functional access during parallel simulation
+    EventQueue::ScopedMigration migrate(bridge.memSideQueue,
+                                        inParallelMode);
+
     // also check the request port's request queue
     if (memSidePort.trySatisfyFunctional(pkt)) {
         return;
@@ -372,6 +471,17 @@ bool
 Bridge::BridgeRequestPort::trySatisfyFunctional(PacketPtr pkt)
 {
     bool found = false;
+
+    // requests still crossing over are younger than the ones in the
+    // queue, so check them first
+    for (auto t = transitList.rbegin(); t != transitList.rend() && !found;
+         ++t) {
+        if (!t->delivered && pkt->trySatisfyFunctional(t->pkt)) {
+            pkt->makeResponse();
+            found = true;
+        }
+    }
+
     auto i = transmitList.begin();
 
     while (i != transmitList.end() && !found) {
@@ -48,6 +48,7 @@
 #define __MEM_BRIDGE_HH__
 
 #include <deque>
+#include <list>
 
 #include "base/types.hh"
 #include "mem/port.hh"
@@ -66,6 +67,13 @@
  * before forwarding the request. If there is no space present, then
  * the bridge will delay accepting the packet until space becomes
  * available.
+ *
+ * The two sides of the bridge can be placed on different event
+ * queues, and thus simulation threads. Packets then cross over as
+ * asynchronous events scheduled one bridge delay into the future,
+ * and request buffer space is returned to the response port the same
+ * way, which keeps the simulation deterministic as long as the delay
+ * is no shorter than the simulation quantum.
  */
 class Bridge : public ClockedObject
 {
@@ -87,6 +95,23 @@ class Bridge : public ClockedObject
         { }
     };
 
+    /**
+     * A request on its way from the response port to the request port
+     * when the two are on different event queues. The delivered flag
+     * is only accessed with the memory side event queue locked.
+     */
+    class TransitPacket
+    {
+
+      public:
+
+        const PacketPtr pkt;
+        bool delivered;
+
+        TransitPacket(PacketPtr _pkt) : pkt(_pkt), delivered(false)
+        { }
+    };
+
     // Forward declaration to allow the response port to have a pointer
     class BridgeRequestPort;
 
@@ -244,6 +269,36 @@ class Bridge : public ClockedObject
         /** Max queue size for request packets */
         const unsigned int reqQueueLimit;
 
+        /**
+         * Requests accepted by the response port that have not yet
+         * been sent on, when the two sides are on different event
+         * queues. Owned by the response port side.
+         */
+        unsigned int outstandingRequests;
+
+        /**
+         * Requests handed over to this side but not yet known to have
+         * arrived, when the two sides are on different event queues,
+         * kept for functional accesses. Owned by the response port
+         * side.
+         */
+        std::list<TransitPacket> transitList;
+
+        /**
+         * Move a request that has crossed over from the response port
+         * into the request queue.
+         *
+         * @param transit the request in the transit list
+         * @param when tick when the request packet should be sent
+         */
+        void recvTransitReq(std::list<TransitPacket>::iterator transit,
+                            Tick when);
+
+        /**
+         * Let the response port know a request has left the queue.
+         */
+        void releaseReq();
+
         /**
          * Handle send event, scheduled when the packet at the head of
          * the outbound queue is ready to transmit (for timing
@@ -288,7 +343,8 @@ class Bridge : public ClockedObject
 
         /**
          * Check a functional request against the packets in our
-         * request queue.
+         * request queue. With the two sides on different event queues
+         * this has to be called with the memory side queue locked.
          *
          * @param pkt packet to check against
          *
@@ -313,6 +369,31 @@ class Bridge : public ClockedObject
     /** Request port of the bridge. */
     BridgeRequestPort memSidePort;
 
+    /**
+     * Event queue of the request port side, which is our own queue
+     * unless the bridge connects two simulation threads.
+     */
+    EventQueue *const memSideQueue;
+
+    /** Delay through the bridge in ticks. */
+    const Tick delay;
+
+    /**
+     * Do the two sides of the bridge run on different event queues?
+     */
+    bool crossQueue() const { return memSideQueue != eventQueue(); }
+
+    /**
+     * Clock edge as seen from the request port side. The clocked
+     * object caches the last edge it computed, which cannot be shared
+     * between threads, so with the two sides on different event
+     * queues the request port side works it out from the period.
+     *
+     * @param cycles number of cycles into the future
+     * @return tick of the clock edge
+     */
+    Tick memSideClockEdge(Cycles cycles = Cycles(0)) const;
+
   public:
 
     Port &getPort(const std::string &if_name,
@@ -70,8 +70,9 @@ MemCtrl::MemCtrl(const MemCtrlParams* p) :
     frontendLatency(p->static_frontend_latency),
     backendLatency(p->static_backend_latency),
     commandWindow(p->command_window),
+    lazyRefresh(p->lazy_refresh),
     nextBurstAt(0), prevArrival(0),
-    nextReqTime(0),
+    nextReqTime(0), refreshDeferred(false),
     stats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
@@ -86,6 +87,9 @@ MemCtrl::MemCtrl(const MemCtrlParams* p) :
 
     fatal_if(!dram && !nvm, "Memory controller must have an interface");
 
+    // bring any deferred refreshes up to date before the stats are read
+    Stats::registerDumpCallback([this]() { resumeRefresh(); });
+
     // perform a basic check of the write thresholds
     if (p->write_low_thresh_perc >= p->write_high_thresh_perc)
         fatal("Write buffer low threshold %d must be smaller than the "
@@ -415,6 +419,9 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     panic_if(!(pkt->isRead() || pkt->isWrite()),
              "Should only see read and writes at memory controller\n");
 
+    // catch up on the refreshes that happened while we were idle
+    resumeRefresh();
+
     // Calc avg gap between requests
     if (prevArrival != 0) {
         stats.totGap += curTick() - prevArrival;
@@ -953,7 +960,9 @@ MemCtrl::processNextReqEvent()
                 }
 
                 // nothing to do, not even any point in scheduling an
-                // event for the next request
+                // event for the next request, and the refreshes can
+                // wait until there is
+                deferRefresh();
                 return;
             }
         } else {
@@ -1374,9 +1383,53 @@ MemCtrl::allIntfDrained() const
    return (dram_drained && nvm_drained);
 }
 
+void
+MemCtrl::deferRefresh()
+{
+    // only a DRAM-only controller that is completely idle, and that
+    // will stay in the read state until the next request arrives, can
+    // leave its refreshes to be computed later
+    if (!lazyRefresh || !dram || nvm || turnPolicy || refreshDeferred ||
+        nextReqEvent.scheduled() || respondEvent.scheduled() ||
+        !respQueue.empty() || totalReadQueueSize || totalWriteQueueSize ||
+        busState != READ || busStateNext != READ ||
+        drainState() != DrainState::Running)
+        return;
+
+    refreshDeferred = dram->deferRefresh();
+}
+
+void
+MemCtrl::resumeRefresh()
+{
+    if (!refreshDeferred)
+        return;
+
+    refreshDeferred = false;
+
+    // each refresh that completed in the meantime would have woken up
+    // the request scheduler, only to find nothing to do
+    unsigned restarts = dram->resumeRefresh();
+    for (unsigned i = 0; i < restarts; ++i)
+        recordTurnaroundStats();
+
+    DPRINTF(MemCtrl, "Resumed refresh after %d scheduler wakeups\n",
+            restarts);
+}
+
+void
+MemCtrl::resetStats()
+{
+    resumeRefresh();
+
+    QoS::MemCtrl::resetStats();
+}
+
 DrainState
 MemCtrl::drain()
 {
+    resumeRefresh();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
@@ -1404,6 +1457,8 @@ MemCtrl::drain()
 void
 MemCtrl::drainResume()
 {
+    resumeRefresh();
+
     if (!isTimingMode && system()->isTimingMode()) {
         // if we switched to timing mode, kick things into action,
         // and behave as if we restored from a checkpoint
@@ -47,6 +47,7 @@
 #define __MEM_CTRL_HH__
 
 #include <deque>
+#include <map>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -141,6 +142,12 @@ class MemPacket
      */
     BurstHelper* burstHelper;
 
+    /**
+     * Arrival order of the packet in the MemPacketQueue it is
+     * currently queued in, assigned by MemPacketQueue::push_back()
+     */
+    uint64_t queueSeq;
+
     /**
      * QoS value of the encapsulated packet read at queuing time
      */
@@ -195,19 +202,116 @@ class MemPacket
 
     MemPacket(PacketPtr _pkt, bool is_read, bool is_dram, uint8_t _rank,
                uint8_t _bank, uint32_t _row, uint16_t bank_id, Addr _addr,
-               unsigned int _size)
-        : entryTime(curTick()), readyTime(curTick()), pkt(_pkt),
+               unsigned int _size, Tick entry_time)
+        : entryTime(entry_time), readyTime(entry_time), pkt(_pkt),
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), rank(_rank), bank(_bank), row(_row),
           bankId(bank_id), addr(_addr), size(_size), burstHelper(NULL),
-          _qosValue(_pkt->qosValue())
+          queueSeq(0), _qosValue(_pkt->qosValue())
     { }
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * A queue of memory packets in arrival order. Besides the plain FIFO,
+ * the DRAM packets are indexed per bank, both by arrival and by row,
+ * so that the FR-FCFS scheduler can find the oldest row hit or the
+ * oldest row miss of a bank without walking the whole queue. The
+ * memory packets are stored in one such queue per QoS priority.
+ */
+class MemPacketQueue
+{
+  private:
+    typedef std::deque<MemPacket*> Container;
+
+  public:
+    typedef Container::iterator iterator;
+    typedef Container::const_iterator const_iterator;
+
+    /**
+     * The DRAM packets of the queue that target one bank.
+     */
+    class BankQueue
+    {
+      private:
+        friend class MemPacketQueue;
+
+        /** Packets keyed by arrival order */
+        std::map<uint64_t, MemPacket*> packets;
+
+        /** The same packets keyed by row, then arrival order */
+        std::map<std::pair<uint32_t, uint64_t>, MemPacket*> rows;
+
+      public:
+        /** Are there any packets waiting for this bank? */
+        bool empty() const { return packets.empty(); }
+
+        /** @return the oldest packet to the given row, if any */
+        MemPacket*
+        oldestHit(uint32_t row) const
+        {
+            auto it = rows.lower_bound(std::make_pair(row, uint64_t(0)));
+            return it != rows.end() && it->first.first == row ?
+                it->second : nullptr;
+        }
+
+        /** @return the oldest packet to any other row, if any */
+        MemPacket* oldestMiss(uint32_t row) const;
+
+        /** Is there a packet to the given row, other than pkt? */
+        bool hasOtherHit(const MemPacket* pkt) const;
+
+        /** Is there a packet to any row but the given one? */
+        bool
+        hasMiss(uint32_t row) const
+        {
+            return !rows.empty() && (rows.begin()->first.first != row ||
+                                     rows.rbegin()->first.first != row);
+        }
+    };
+
+    MemPacketQueue() : nextSeq(0) {}
+
+    /** Append a packet to the queue */
+    void push_back(MemPacket* pkt);
+
+    /**
+     * Remove a packet from the queue
+     * @return iterator to the packet following the erased one
+     */
+    iterator erase(iterator it);
+
+    /** Locate a queued packet, using the queue's arrival order */
+    iterator find(const MemPacket* pkt);
+
+    /** @return the DRAM packets waiting for a bank */
+    const BankQueue&
+    bankQueue(uint16_t bank_id) const
+    {
+        return bank_id < banks.size() ? banks[bank_id] : emptyBank;
+    }
+
+    iterator begin() { return queue.begin(); }
+    iterator end() { return queue.end(); }
+    const_iterator begin() const { return queue.begin(); }
+    const_iterator end() const { return queue.end(); }
+
+    size_t size() const { return queue.size(); }
+    bool empty() const { return queue.empty(); }
+
+  private:
+    /** All the packets, in arrival order */
+    Container queue;
+
+    /** Per-bank index of the DRAM packets, by bank id */
+    std::vector<BankQueue> banks;
+
+    /** Arrival order of the next packet */
+    uint64_t nextSeq;
+
+    /** Returned for banks that never had a packet queued */
+    static const BankQueue emptyBank;
+};
 
 
 /**
@@ -508,6 +612,12 @@ class MemCtrl : public QoS::MemCtrl
      */
     const Tick commandWindow;
 
+    /**
+     * Stop the refresh events while the controller is idle and
+     * account for the refreshes when it is next used.
+     */
+    const bool lazyRefresh;
+
     /**
      * Till when must we wait before issuing next RD/WR burst?
      */
@@ -523,6 +633,12 @@ class MemCtrl : public QoS::MemCtrl
      */
     Tick nextReqTime;
 
+    /**
+     * Set while the refresh events of the DRAM ranks are stopped
+     * because the controller is idle.
+     */
+    bool refreshDeferred;
+
     struct CtrlStats : public Stats::Group
     {
         CtrlStats(MemCtrl &ctrl);
@@ -607,6 +723,22 @@ class MemCtrl : public QoS::MemCtrl
      */
     void pruneBurstTick();
 
+    /**
+     * Stop the DRAM refresh events if the controller has nothing to
+     * do and will not change bus direction before the next request.
+     * The refreshes and power state transitions that would have taken
+     * place in the meantime are then accounted for by resumeRefresh().
+     */
+    void deferRefresh();
+
+    /**
+     * Replay any deferred refreshes up to the current tick, including
+     * the controller wakeups they would have caused, and restart the
+     * refresh events. Called whenever the controller state is observed
+     * or changed from the outside.
+     */
+    void resumeRefresh();
+
   public:
 
     MemCtrl(const MemCtrlParams* p);
@@ -698,6 +830,8 @@ class MemCtrl : public QoS::MemCtrl
     virtual void startup() override;
     virtual void drainResume() override;
 
+    void resetStats() override;
+
   protected:
 
     Tick recvAtomic(PacketPtr pkt);
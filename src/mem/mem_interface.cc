@@ -162,122 +162,124 @@ MemInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
     uint16_t bank_id = banksPerRank * rank + bank;
 
     return new MemPacket(pkt, is_read, is_dram, rank, bank, row, bank_id,
-                   pkt_addr, size);
+                   pkt_addr, size, curTick());
 }
 
 pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    vector<uint32_t> earliest_banks(ranksPerChannel, 0);
+    // The packets are considered per bank rather than one by one in
+    // queue order. Within each bank the oldest row hit and the oldest
+    // row miss are the only candidates, and the queue sequence numbers
+    // give the FCFS order across banks. This picks the same packet as
+    // a walk through the queue would:
+    // 1) the first seamless row hit, else
+    // 2) the first packet to one of the earliest banks, if that bank
+    //    can be prepared without impacting utilization, else
+    // 3) the first row hit that is prepped but not seamless, else
+    // 4) the first packet to one of the earliest banks
+    auto older = [](const MemPacket* pkt, const MemPacket* than)
+    { return !than || pkt->queueSeq < than->queueSeq; };
+
+    // oldest row hit that can issue seamlessly
+    MemPacket* seamless_pkt = nullptr;
+    // oldest row hit, not seamless, but bank prepped and ready
+    MemPacket* prepped_pkt = nullptr;
+    // is there any row miss to an available rank?
+    bool got_miss = false;
 
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
+    for (int i = 0; i < ranksPerChannel; i++) {
+        // check if rank is not doing a refresh and thus is available,
+        // if not, skip all its banks
+        if (!ranks[i]->inRefIdleState()) {
+            DPRINTF(DRAM, "%s Rank %d not available\n", __func__, i);
+            continue;
+        }
 
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
+        for (int j = 0; j < banksPerRank; j++) {
+            const auto& bank_queue = queue.bankQueue(i * banksPerRank + j);
+            if (bank_queue.empty())
+                continue;
 
-        // select optimal DRAM packet in Q
-        if (pkt->isDram()) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
+            const Bank& bank = ranks[i]->banks[j];
 
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
+            MemPacket* hit = bank_queue.oldestHit(bank.openRow);
+            if (hit) {
+                const Tick col_allowed_at = hit->isRead() ?
+                    bank.rdAllowedAt : bank.wrAllowedAt;
 
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
+                // no additional rank-to-rank or same bank-group
+                // delays, or we switched read/write and might as well
+                // go for the row hit
+                if (col_allowed_at <= min_col_at) {
+                    if (older(hit, seamless_pkt))
+                        seamless_pkt = hit;
+                } else if (older(hit, prepped_pkt)) {
+                    prepped_pkt = hit;
+                }
+            }
 
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
+            got_miss |= bank_queue.hasMiss(bank.openRow);
+        }
+    }
 
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+    MemPacket* selected_pkt = nullptr;
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
+    if (seamless_pkt) {
+        // FCFS within the hits, giving priority to commands that can
+        // issue seamlessly, without additional delay, such as same
+        // rank accesses and/or different bank-group accesses
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+        selected_pkt = seamless_pkt;
+    } else {
+        // oldest row miss to a bank amongst the first available
+        MemPacket* earliest_pkt = nullptr;
+        bool hidden_bank_prep = false;
+
+        if (got_miss) {
+            // minBankPrep will give priority to packets that can
+            // issue seamlessly
+            vector<uint32_t> earliest_banks;
+            std::tie(earliest_banks, hidden_bank_prep) =
+                minBankPrep(queue, min_col_at);
+
+            for (int i = 0; i < ranksPerChannel; i++) {
+                for (int j = 0; j < banksPerRank; j++) {
+                    if (!bits(earliest_banks[i], j, j))
+                        continue;
+
+                    MemPacket* miss = queue.bankQueue(i * banksPerRank + j).
+                        oldestMiss(ranks[i]->banks[j].openRow);
+                    if (miss && older(miss, earliest_pkt))
+                        earliest_pkt = miss;
                 }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
             }
         }
+
+        // give priority to packets that can issue bank commands
+        // 'behind the scenes', any additional delay if any will be
+        // due to col-to-col command requirements
+        if (earliest_pkt && (hidden_bank_prep || !prepped_pkt)) {
+            selected_pkt = earliest_pkt;
+        } else if (prepped_pkt) {
+            DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
+            selected_pkt = prepped_pkt;
+        }
     }
 
-    if (selected_pkt_it == queue.end()) {
+    if (!selected_pkt) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return make_pair(queue.end(), MaxTick);
     }
 
-    return make_pair(selected_pkt_it, selected_col_at);
+    DPRINTF(DRAM, "%s selected DRAM packet in bank %d, row %d\n",
+            __func__, selected_pkt->bank, selected_pkt->row);
+
+    const Bank& bank = ranks[selected_pkt->rank]->banks[selected_pkt->bank];
+    const Tick selected_col_at = selected_pkt->isRead() ? bank.rdAllowedAt :
+                                                          bank.wrAllowedAt;
+
+    return make_pair(queue.find(selected_pkt), selected_col_at);
 }
 
 void
@@ -612,26 +614,15 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_bank_conflict = false;
 
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
             // 1) if a hit is found, then both open and close adaptive
             //    policies keep the page open
             // 2) if no hit is found, got_bank_conflict is set to true if a
             //    bank conflict request is waiting in the queue
             // 3) make sure we are not considering the packet that we are
             //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
-            }
+            const auto& bank_queue = queue[i].bankQueue(mem_pkt->bankId);
+            got_more_hits |= bank_queue.hasOtherHit(mem_pkt);
+            got_bank_conflict |= bank_queue.hasMiss(mem_pkt->row);
 
             if (got_more_hits)
                 break;
@@ -1033,6 +1024,53 @@ DRAMInterface::suspend()
     }
 }
 
+bool
+DRAMInterface::deferRefresh()
+{
+    // the ranks share the controller, so only stop the refreshes if
+    // none of them needs the event loop
+    for (auto r : ranks) {
+        if (!r->canDeferRefresh())
+            return false;
+    }
+
+    for (auto r : ranks) {
+        r->deferRefresh();
+    }
+    return true;
+}
+
+unsigned
+DRAMInterface::resumeRefresh()
+{
+    unsigned restarts = 0;
+    Tick last_restart = MaxTick;
+
+    while (true) {
+        // replay the refreshes across ranks in the order they happened
+        Rank *next = nullptr;
+        for (auto r : ranks) {
+            if (r->refreshDeferred && (!next ||
+                r->deferredRefreshAt < next->deferredRefreshAt)) {
+                next = r;
+            }
+        }
+
+        if (!next)
+            break;
+
+        // every completed refresh kicks the request scheduler, and
+        // refreshes ending on the same tick only do so once
+        Tick ref_done_at = next->replayRefresh();
+        if (ref_done_at != MaxTick && ref_done_at != last_restart) {
+            ++restarts;
+            last_restart = ref_done_at;
+        }
+    }
+
+    return restarts;
+}
+
 pair<vector<uint32_t>, bool>
 DRAMInterface::minBankPrep(const MemPacketQueue& queue,
                       Tick min_col_at) const
@@ -1051,14 +1089,6 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // delay on the data bus
     bool hidden_bank_prep = false;
 
-    // determine if we have queued transactions targetting the
-    // bank in question
-    vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
@@ -1067,7 +1097,8 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
 
             // if we have waiting requests for the bank, and it is
             // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
+            if (ranks[i]->inRefIdleState() &&
+                !queue.bankQueue(bank_id).empty()) {
                 // make sure this rank is not currently refreshing.
                 assert(ranks[i]->inRefIdleState());
                 // simplistic approximation of when the bank can issue
@@ -1129,7 +1160,8 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams* _p,
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
       pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
-      refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
+      refreshState(REF_IDLE), inLowPowerState(false),
+      refreshDeferred(false), deferredRefreshAt(0), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p->banks_per_rank),
       numBanksActive(0), actTicks(_p->activation_limit, 0), lastBurstTick(0),
@@ -1180,7 +1212,7 @@ DRAMInterface::Rank::suspend()
     deschedule(refreshEvent);
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // don't automatically transition back to LP state after next REF
     pwrStatePostRefresh = PWR_IDLE;
@@ -1213,7 +1245,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick now)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1223,19 +1255,19 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= now) {
+             // Move all commands at or before now to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before now
+             // next_iter references the 1st command after now
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after now
+    // if there are no commands after now, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
@@ -1414,34 +1446,9 @@ DRAMInterface::Rank::processRefreshEvent()
         assert(numBanksActive == 0);
         assert(pwrState == PWR_REF);
 
-        Tick ref_done_at = curTick() + dram.tRFC;
-
-        for (auto &b : banks) {
-            b.actAllowedAt = ref_done_at;
-        }
-
-        // at the moment this affects all ranks
-        cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
-
-        // Update the stats
-        updatePowerStats();
-
-        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
-                dram.timeStampOffset, rank);
-
-        // Update for next refresh
-        refreshDueAt += dram.tREFI;
-
-        // make sure we did not wait so long that we cannot make up
-        // for it
-        if (refreshDueAt < ref_done_at) {
-            fatal("Refresh was delayed so long we cannot catch up\n");
-        }
-
         // Run the refresh and schedule event to transition power states
         // when refresh completes
-        refreshState = REF_RUN;
-        schedule(refreshEvent, ref_done_at);
+        schedule(refreshEvent, issueRefresh(curTick()));
         return;
     }
 
@@ -1498,6 +1505,117 @@ DRAMInterface::Rank::processRefreshEvent()
     }
 }
 
+Tick
+DRAMInterface::Rank::issueRefresh(Tick ref_tick)
+{
+    Tick ref_done_at = ref_tick + dram.tRFC;
+
+    for (auto &b : banks) {
+        b.actAllowedAt = ref_done_at;
+    }
+
+    // at the moment this affects all ranks
+    cmdList.push_back(Command(MemCommand::REF, 0, ref_tick));
+
+    // Update the stats
+    updatePowerStats(ref_tick);
+
+    DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_tick, dram.tCK) -
+            dram.timeStampOffset, rank);
+
+    // Update for next refresh
+    refreshDueAt += dram.tREFI;
+
+    // make sure we did not wait so long that we cannot make up
+    // for it
+    if (refreshDueAt < ref_done_at) {
+        fatal("Refresh was delayed so long we cannot catch up\n");
+    }
+
+    refreshState = REF_RUN;
+
+    return ref_done_at;
+}
+
+bool
+DRAMInterface::Rank::canDeferRefresh() const
+{
+    // the only thing going on is the refresh event counting down to
+    // the next refresh, and the power state machine will move
+    // straight from idle to refresh and back once it fires
+    return refreshState == REF_IDLE && pwrState == PWR_IDLE &&
+           pwrStatePostRefresh == PWR_IDLE && !inLowPowerState &&
+           !dram.enableDRAMPowerdown && numBanksActive == 0 &&
+           outstandingEvents == 0 && readEntries == 0 && writeEntries == 0 &&
+           refreshEvent.scheduled() && refreshEvent.when() > curTick() &&
+           !powerEvent.scheduled() && !wakeUpEvent.scheduled() &&
+           !activateEvent.scheduled() && !prechargeEvent.scheduled() &&
+           !writeDoneEvent.scheduled();
+}
+
+void
+DRAMInterface::Rank::deferRefresh()
+{
+    assert(canDeferRefresh());
+
+    deferredRefreshAt = refreshEvent.when();
+    deschedule(refreshEvent);
+    refreshDeferred = true;
+
+    DPRINTF(DRAMState, "Rank %d deferring refresh due at %llu\n",
+            rank, deferredRefreshAt);
+}
+
+Tick
+DRAMInterface::Rank::replayRefresh()
+{
+    assert(refreshDeferred);
+
+    // the refresh is not due yet, simply hand it back to the event loop
+    if (deferredRefreshAt >= curTick()) {
+        refreshDeferred = false;
+        schedule(refreshEvent, deferredRefreshAt);
+        return MaxTick;
+    }
+
+    // with all banks closed and nothing else going on, the refresh event
+    // loop moves through drain and precharge without delay, and the
+    // power state machine goes straight to refresh
+    Tick ref_tick = deferredRefreshAt;
+    refreshDueAt = ref_tick;
+    ++outstandingEvents;
+
+    stats.pwrStateTime[pwrState] += ref_tick - pwrStateTick;
+    pwrState = PWR_REF;
+    pwrStateTick = ref_tick;
+
+    Tick ref_done_at = issueRefresh(ref_tick);
+
+    // the refresh is still running, let the event loop finish it
+    if (ref_done_at >= curTick()) {
+        refreshDeferred = false;
+        schedule(refreshEvent, ref_done_at);
+        return MaxTick;
+    }
+
+    // the refresh completed, and the rank went back to idle
+    stats.pwrStateTime[PWR_REF] += ref_done_at - pwrStateTick;
+    pwrState = PWR_IDLE;
+    pwrStateTick = ref_done_at;
+
+    assert(outstandingEvents == 1);
+    --outstandingEvents;
+    refreshState = REF_IDLE;
+
+    // compensate for the precharge time, as the event loop does
+    deferredRefreshAt = refreshDueAt - dram.tRP;
+
+    DPRINTF(DRAMState, "Replayed refresh of rank %d at %llu, next refresh "
+            "at %llu\n", rank, ref_tick, refreshDueAt);
+
+    return ref_done_at;
+}
+
 void
 DRAMInterface::Rank::schedulePowerEvent(PowerState pwr_state, Tick tick)
 {
@@ -1774,17 +1892,17 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick now)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(now);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
     // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    power.powerlib.calcWindowEnergy(divCeil(now, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1812,7 +1930,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (now - dram.lastStatsResetTick)) *
                     (SimClock::Frequency / 1000000000.0);
 }
 
@@ -1822,7 +1940,7 @@ DRAMInterface::Rank::computeStats()
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
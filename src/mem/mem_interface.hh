@@ -494,8 +494,19 @@ class DRAMInterface : public MemInterface
 
         /**
          * Function to update Power Stats
+         *
+         * @param now Tick up to which the stats are updated
+         */
+        void updatePowerStats(Tick now);
+
+        /**
+         * Issue a refresh to a rank that has all banks precharged, and
+         * move the refresh state machine to REF_RUN.
+         *
+         * @param ref_tick Tick at which the REF command is issued
+         * @return Tick at which the refresh completes
          */
-        void updatePowerStats();
+        Tick issueRefresh(Tick ref_tick);
 
         /**
          * Schedule a power state transition in the future, and
@@ -523,6 +534,18 @@ class DRAMInterface : public MemInterface
          */
         bool inLowPowerState;
 
+        /**
+         * Set while the refresh event is descheduled and the refreshes
+         * of this idle rank are modelled lazily, see deferRefresh().
+         */
+        bool refreshDeferred;
+
+        /**
+         * When the refresh event would have fired, valid while
+         * refreshDeferred is set.
+         */
+        Tick deferredRefreshAt;
+
         /**
          * Current Rank index
          */
@@ -646,11 +669,40 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
-         * All commands before curTick are guaranteed to be complete
+         * or before now to DRAMPower library
+         * All commands before now are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param now Tick up to which commands are flushed
+         */
+        void flushCmdList(Tick now);
+
+        /**
+         * Check if the rank is idle in a way that lets its refreshes be
+         * computed rather than simulated: all banks closed, no low-power
+         * state, nothing queued and no event pending but the refresh.
+         *
+         * @return true if deferRefresh() may be called
          */
-        void flushCmdList();
+        bool canDeferRefresh() const;
+
+        /**
+         * Stop the refresh event. The refreshes that fall due from now on
+         * are replayed by replayRefresh() when the rank is needed again.
+         */
+        void deferRefresh();
+
+        /**
+         * Catch up on the next deferred refresh. A refresh that completes
+         * before curTick() is applied in full, including its power state
+         * and energy accounting, and the rank stays deferred. Otherwise
+         * the refresh state machine is handed back to the event loop at
+         * the point the refresh has reached.
+         *
+         * @return Tick at which the replayed refresh completed, or MaxTick
+         *         if the rank is no longer deferred
+         */
+        Tick replayRefresh();
 
         /**
          * Computes stats just prior to dump event
@@ -905,6 +957,24 @@ class DRAMInterface : public MemInterface
      */
     void drainRanks();
 
+    /**
+     * Stop the refresh events of all ranks while the channel is idle,
+     * provided every rank is in a state where its refreshes can be
+     * computed lazily.
+     *
+     * @return true if the refreshes were deferred
+     */
+    bool deferRefresh();
+
+    /**
+     * Replay the refreshes deferred up to curTick() and restart the
+     * refresh events.
+     *
+     * @return number of times the controller scheduler would have been
+     *         restarted at the end of a refresh in the meantime
+     */
+    unsigned resumeRefresh();
+
     /**
      * Return true once refresh is complete for all ranks and there are no
      * additional commands enqueued.  (only evaluated when draining)
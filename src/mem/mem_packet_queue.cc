@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+
+#include "mem/mem_ctrl.hh"
+
+using namespace std;
+
+const MemPacketQueue::BankQueue MemPacketQueue::emptyBank;
+
+MemPacket*
+MemPacketQueue::BankQueue::oldestMiss(uint32_t row) const
+{
+    // only the hits older than the first miss have to be skipped
+    for (const auto& p : packets) {
+        if (p.second->row != row)
+            return p.second;
+    }
+    return nullptr;
+}
+
+bool
+MemPacketQueue::BankQueue::hasOtherHit(const MemPacket* pkt) const
+{
+    // pkt itself is at most one of the entries for its row
+    auto it = rows.lower_bound(make_pair(pkt->row, uint64_t(0)));
+    for (int i = 0; i < 2 && it != rows.end() &&
+             it->first.first == pkt->row; ++i, ++it) {
+        if (it->second != pkt)
+            return true;
+    }
+    return false;
+}
+
+void
+MemPacketQueue::push_back(MemPacket* pkt)
+{
+    pkt->queueSeq = nextSeq++;
+    queue.push_back(pkt);
+
+    if (pkt->isDram()) {
+        if (pkt->bankId >= banks.size())
+            banks.resize(pkt->bankId + 1);
+        BankQueue& bank_queue = banks[pkt->bankId];
+        bank_queue.packets.emplace(pkt->queueSeq, pkt);
+        bank_queue.rows.emplace(make_pair(pkt->row, pkt->queueSeq), pkt);
+    }
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    MemPacket* pkt = *it;
+
+    if (pkt->isDram()) {
+        BankQueue& bank_queue = banks[pkt->bankId];
+        M5_VAR_USED size_t erased = bank_queue.packets.erase(pkt->queueSeq);
+        erased += bank_queue.rows.erase(make_pair(pkt->row, pkt->queueSeq));
+        assert(erased == 2);
+    }
+
+    return queue.erase(it);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const MemPacket* pkt)
+{
+    // packets are only ever appended, so the queue is sorted by
+    // arrival order
+    auto it = lower_bound(queue.begin(), queue.end(), pkt->queueSeq,
+                          [](const MemPacket* p, uint64_t seq)
+                          { return p->queueSeq < seq; });
+    assert(it != queue.end() && *it == pkt);
+    return it;
+}
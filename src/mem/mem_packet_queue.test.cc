@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "mem/mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+namespace {
+
+class MemPacketQueueTest : public testing::Test
+{
+  protected:
+    std::vector<std::unique_ptr<Packet>> pkts;
+    std::vector<std::unique_ptr<MemPacket>> memPkts;
+
+    /** Create a packet to a bank and row, DRAM unless told otherwise */
+    MemPacket*
+    makePacket(uint16_t bank_id, uint32_t row, bool is_dram = true)
+    {
+        // The queue only looks at the decoded fields of the MemPacket
+        pkts.emplace_back(new Packet(std::make_shared<Request>(),
+                                     MemCmd::ReadReq));
+        const Addr addr = 0x1000 * pkts.size();
+        memPkts.emplace_back(new MemPacket(pkts.back().get(), true, is_dram,
+                                           0, bank_id, row, bank_id, addr,
+                                           64, 0));
+        return memPkts.back().get();
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(MemPacketQueueTest, ArrivalOrder)
+{
+    MemPacketQueue queue;
+    EXPECT_TRUE(queue.empty());
+
+    MemPacket *a = makePacket(0, 1);
+    MemPacket *b = makePacket(1, 2);
+    MemPacket *c = makePacket(0, 3, false);
+    queue.push_back(a);
+    queue.push_back(b);
+    queue.push_back(c);
+
+    ASSERT_EQ(queue.size(), 3);
+    EXPECT_LT(a->queueSeq, b->queueSeq);
+    EXPECT_LT(b->queueSeq, c->queueSeq);
+
+    std::vector<MemPacket*> order(queue.begin(), queue.end());
+    EXPECT_EQ(order, std::vector<MemPacket*>({a, b, c}));
+
+    EXPECT_EQ(*queue.find(a), a);
+    EXPECT_EQ(*queue.find(b), b);
+    EXPECT_EQ(*queue.find(c), c);
+}
+
+TEST_F(MemPacketQueueTest, OldestHitAndMiss)
+{
+    MemPacketQueue queue;
+    MemPacket *miss_old = makePacket(3, 5);
+    MemPacket *hit_old = makePacket(3, 7);
+    MemPacket *hit_new = makePacket(3, 7);
+    MemPacket *miss_new = makePacket(3, 9);
+    queue.push_back(miss_old);
+    queue.push_back(hit_old);
+    queue.push_back(hit_new);
+    queue.push_back(miss_new);
+
+    const MemPacketQueue::BankQueue &bank = queue.bankQueue(3);
+    EXPECT_FALSE(bank.empty());
+
+    EXPECT_EQ(bank.oldestHit(7), hit_old);
+    EXPECT_EQ(bank.oldestHit(5), miss_old);
+    EXPECT_EQ(bank.oldestHit(8), nullptr);
+
+    // The oldest packet to any other row, regardless of which row
+    EXPECT_EQ(bank.oldestMiss(7), miss_old);
+    EXPECT_EQ(bank.oldestMiss(5), hit_old);
+
+    EXPECT_TRUE(bank.hasMiss(7));
+    EXPECT_TRUE(bank.hasOtherHit(hit_old));
+    EXPECT_FALSE(bank.hasOtherHit(miss_old));
+}
+
+TEST_F(MemPacketQueueTest, SingleRow)
+{
+    MemPacketQueue queue;
+    MemPacket *a = makePacket(0, 4);
+    MemPacket *b = makePacket(0, 4);
+    queue.push_back(a);
+    queue.push_back(b);
+
+    const MemPacketQueue::BankQueue &bank = queue.bankQueue(0);
+    EXPECT_FALSE(bank.hasMiss(4));
+    EXPECT_TRUE(bank.hasMiss(5));
+    EXPECT_EQ(bank.oldestMiss(4), nullptr);
+    EXPECT_EQ(bank.oldestMiss(5), a);
+}
+
+TEST_F(MemPacketQueueTest, BanksAreSeparate)
+{
+    MemPacketQueue queue;
+    MemPacket *a = makePacket(0, 1);
+    MemPacket *b = makePacket(2, 1);
+    queue.push_back(a);
+    queue.push_back(b);
+
+    EXPECT_EQ(queue.bankQueue(0).oldestHit(1), a);
+    EXPECT_EQ(queue.bankQueue(2).oldestHit(1), b);
+    EXPECT_TRUE(queue.bankQueue(1).empty());
+
+    // Banks beyond the highest one seen so far are empty as well
+    EXPECT_TRUE(queue.bankQueue(100).empty());
+    EXPECT_EQ(queue.bankQueue(100).oldestHit(1), nullptr);
+}
+
+TEST_F(MemPacketQueueTest, NvmIsNotIndexed)
+{
+    MemPacketQueue queue;
+    MemPacket *nvm = makePacket(1, 6, false);
+    queue.push_back(nvm);
+
+    EXPECT_EQ(queue.size(), 1);
+    EXPECT_TRUE(queue.bankQueue(1).empty());
+
+    queue.erase(queue.find(nvm));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(MemPacketQueueTest, Erase)
+{
+    MemPacketQueue queue;
+    MemPacket *a = makePacket(0, 1);
+    MemPacket *b = makePacket(0, 1);
+    MemPacket *c = makePacket(0, 2);
+    queue.push_back(a);
+    queue.push_back(b);
+    queue.push_back(c);
+
+    // Erasing from the middle returns the following packet
+    auto it = queue.erase(queue.find(b));
+    ASSERT_NE(it, queue.end());
+    EXPECT_EQ(*it, c);
+
+    const MemPacketQueue::BankQueue &bank = queue.bankQueue(0);
+    EXPECT_EQ(bank.oldestHit(1), a);
+    EXPECT_FALSE(bank.hasOtherHit(a));
+
+    queue.erase(queue.find(a));
+    EXPECT_EQ(bank.oldestHit(1), nullptr);
+    EXPECT_EQ(bank.oldestMiss(1), c);
+    EXPECT_EQ(*queue.find(c), c);
+
+    queue.erase(queue.find(c));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(bank.empty());
+}
+
+TEST_F(MemPacketQueueTest, RequeueGetsNewSequence)
+{
+    // A packet moved to another queue, e.g. by QoS escalation, is
+    // indexed by its arrival in the new queue
+    MemPacketQueue low, high;
+    MemPacket *a = makePacket(0, 1);
+    MemPacket *b = makePacket(0, 1);
+    low.push_back(a);
+    high.push_back(b);
+
+    low.erase(low.find(a));
+    high.push_back(a);
+
+    EXPECT_GT(a->queueSeq, b->queueSeq);
+    EXPECT_EQ(high.bankQueue(0).oldestHit(1), b);
+    EXPECT_TRUE(high.bankQueue(0).hasOtherHit(b));
+    EXPECT_EQ(*high.find(a), a);
+    EXPECT_TRUE(low.bankQueue(0).empty());
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PAGE_BLOCKS_HH__
+#define __MEM_PAGE_BLOCKS_HH__
+
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+
+#include "base/types.hh"
+
+/**
+ * A sparse map from virtual pages to entries, which holds the entries in
+ * blocks of consecutive pages found through a hash of the block number.
+ * Processes map runs of pages, so most blocks are dense. The blocks used
+ * recently are kept in a small direct mapped cache, so walking through a
+ * run of pages, or looking up pages in the few regions a program is
+ * working in, rarely hashes. Blocks are freed once their last page is
+ * erased.
+ *
+ * @tparam Entry The type of the entry of each page.
+ */
+template <class Entry>
+class PageBlocks
+{
+  public:
+    static const unsigned BlockBits = 9;
+    static const Addr BlockPages = ULL(1) << BlockBits;
+
+  protected:
+    struct Block
+    {
+        std::array<Entry, BlockPages> entries;
+        std::bitset<BlockPages> valid;
+    };
+
+    typedef std::unordered_map<Addr, std::unique_ptr<Block>> BlockMap;
+    BlockMap blocks;
+
+    static const unsigned CacheSize = 8;
+
+    struct CachedBlock
+    {
+        Addr num = 0;
+        Block *block = nullptr;
+    };
+
+    std::array<CachedBlock, CacheSize> cache;
+
+    const unsigned pageShift;
+    // The number of pages mapped.
+    uint64_t numPages;
+
+    Addr
+    blockNum(Addr vaddr) const
+    {
+        return vaddr >> (pageShift + BlockBits);
+    }
+
+    unsigned
+    blockIndex(Addr vaddr) const
+    {
+        return (vaddr >> pageShift) & (BlockPages - 1);
+    }
+
+    Block *
+    findBlock(Addr vaddr, bool allocate)
+    {
+        const Addr num = blockNum(vaddr);
+        CachedBlock &cached = cache[num % CacheSize];
+        if (cached.block && cached.num == num)
+            return cached.block;
+
+        auto it = blocks.find(num);
+        if (it == blocks.end()) {
+            if (!allocate)
+                return nullptr;
+            it = blocks.emplace(num,
+                                std::unique_ptr<Block>(new Block)).first;
+        }
+        cached.num = num;
+        cached.block = it->second.get();
+        return cached.block;
+    }
+
+  public:
+    explicit PageBlocks(unsigned page_shift)
+        : pageShift(page_shift), numPages(0)
+    {}
+
+    /** The entry of the page holding vaddr, or nullptr if unmapped. */
+    Entry *
+    find(Addr vaddr)
+    {
+        Block *block = findBlock(vaddr, false);
+        if (!block)
+            return nullptr;
+        const unsigned index = blockIndex(vaddr);
+        return block->valid[index] ? &block->entries[index] : nullptr;
+    }
+
+    /**
+     * Map the page holding vaddr.
+     * @return True if an existing mapping of the page was replaced.
+     */
+    bool
+    insert(Addr vaddr, const Entry &entry)
+    {
+        Block *block = findBlock(vaddr, true);
+        const unsigned index = blockIndex(vaddr);
+        const bool replaced = block->valid[index];
+        if (!replaced) {
+            block->valid[index] = true;
+            numPages++;
+        }
+        block->entries[index] = entry;
+        return replaced;
+    }
+
+    /** Unmap the page holding vaddr, which must be mapped. */
+    void
+    erase(Addr vaddr)
+    {
+        const Addr num = blockNum(vaddr);
+        Block *block = findBlock(vaddr, false);
+        const unsigned index = blockIndex(vaddr);
+        assert(block && block->valid[index]);
+        block->valid[index] = false;
+        numPages--;
+
+        if (block->valid.none()) {
+            cache[num % CacheSize].block = nullptr;
+            blocks.erase(num);
+        }
+    }
+
+    /** The number of pages mapped. */
+    uint64_t size() const { return numPages; }
+
+    /** The number of blocks allocated. */
+    size_t numBlocks() const { return blocks.size(); }
+
+    /** Call f(vaddr, entry) for every page mapped, in no particular order. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &block : blocks) {
+            for (Addr index = 0; index < BlockPages; index++) {
+                if (block.second->valid[index]) {
+                    f(((block.first << BlockBits) | index) << pageShift,
+                      block.second->entries[index]);
+                }
+            }
+        }
+    }
+};
+
+#endif // __MEM_PAGE_BLOCKS_HH__
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include "mem/page_blocks.hh"
+
+namespace {
+
+struct Entry
+{
+    Addr paddr = 0;
+};
+
+typedef PageBlocks<Entry> Blocks;
+
+const unsigned PageShift = 12;
+const Addr PageBytes = ULL(1) << PageShift;
+const Addr BlockBytes = Blocks::BlockPages << PageShift;
+
+Entry
+makeEntry(Addr paddr)
+{
+    Entry entry;
+    entry.paddr = paddr;
+    return entry;
+}
+
+/** All the mappings, from virtual page to physical address */
+std::map<Addr, Addr>
+mappings(const Blocks &blocks)
+{
+    std::map<Addr, Addr> pages;
+    blocks.forEach([&pages](Addr vaddr, const Entry &entry) {
+        EXPECT_TRUE(pages.emplace(vaddr, entry.paddr).second);
+    });
+    return pages;
+}
+
+} // anonymous namespace
+
+TEST(PageBlocksTest, Empty)
+{
+    Blocks blocks(PageShift);
+    EXPECT_EQ(blocks.find(0x0), nullptr);
+    EXPECT_EQ(blocks.find(0x7fffffff0000), nullptr);
+    EXPECT_EQ(blocks.size(), 0);
+    EXPECT_EQ(blocks.numBlocks(), 0);
+}
+
+TEST(PageBlocksTest, RunAcrossBlocks)
+{
+    // A run of pages which starts part way through a block and ends part
+    // way through the third
+    Blocks blocks(PageShift);
+    const Addr start = 3 * BlockBytes - 16 * PageBytes;
+    const Addr pages = Blocks::BlockPages + 32;
+    for (Addr page = 0; page < pages; page++) {
+        EXPECT_FALSE(blocks.insert(start + page * PageBytes,
+                                   makeEntry(0x100000 + page * PageBytes)));
+    }
+    EXPECT_EQ(blocks.size(), pages);
+    EXPECT_EQ(blocks.numBlocks(), 3);
+
+    for (Addr page = 0; page < pages; page++) {
+        const Entry *entry = blocks.find(start + page * PageBytes + 0x123);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->paddr, 0x100000 + page * PageBytes);
+    }
+    EXPECT_EQ(blocks.find(start - PageBytes), nullptr);
+    EXPECT_EQ(blocks.find(start + pages * PageBytes), nullptr);
+}
+
+TEST(PageBlocksTest, Replace)
+{
+    Blocks blocks(PageShift);
+    EXPECT_FALSE(blocks.insert(0x5000, makeEntry(0x1000)));
+    EXPECT_TRUE(blocks.insert(0x5000, makeEntry(0x2000)));
+
+    EXPECT_EQ(blocks.size(), 1);
+    ASSERT_NE(blocks.find(0x5000), nullptr);
+    EXPECT_EQ(blocks.find(0x5000)->paddr, 0x2000);
+}
+
+TEST(PageBlocksTest, EraseFreesBlocks)
+{
+    Blocks blocks(PageShift);
+    blocks.insert(0x0, makeEntry(0x1000));
+    blocks.insert(PageBytes, makeEntry(0x2000));
+    blocks.insert(BlockBytes, makeEntry(0x3000));
+    EXPECT_EQ(blocks.numBlocks(), 2);
+
+    blocks.erase(0x0);
+    EXPECT_EQ(blocks.find(0x0), nullptr);
+    EXPECT_EQ(blocks.numBlocks(), 2);
+
+    // Erasing the last page of a block frees it
+    blocks.erase(PageBytes);
+    EXPECT_EQ(blocks.find(PageBytes), nullptr);
+    EXPECT_EQ(blocks.numBlocks(), 1);
+    EXPECT_EQ(blocks.size(), 1);
+
+    // The freed block is allocated again when needed
+    blocks.insert(PageBytes, makeEntry(0x4000));
+    ASSERT_NE(blocks.find(PageBytes), nullptr);
+    EXPECT_EQ(blocks.find(PageBytes)->paddr, 0x4000);
+    EXPECT_EQ(blocks.numBlocks(), 2);
+    ASSERT_NE(blocks.find(BlockBytes), nullptr);
+    EXPECT_EQ(blocks.find(BlockBytes)->paddr, 0x3000);
+}
+
+TEST(PageBlocksTest, SparseBlocks)
+{
+    // Blocks far apart in the address space, several of which compete
+    // for the same place in the block cache
+    Blocks blocks(PageShift);
+    std::map<Addr, Addr> expected;
+    for (Addr block = 0; block < 32; block++) {
+        const Addr vaddr = 0x7fff00000000 + block * 8 * BlockBytes;
+        blocks.insert(vaddr, makeEntry(block * PageBytes));
+        expected[vaddr] = block * PageBytes;
+    }
+    EXPECT_EQ(blocks.numBlocks(), 32);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (const auto &page : expected) {
+            const Entry *entry = blocks.find(page.first);
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(entry->paddr, page.second);
+            EXPECT_EQ(blocks.find(page.first + PageBytes), nullptr);
+        }
+    }
+    EXPECT_EQ(mappings(blocks), expected);
+}
+
+TEST(PageBlocksTest, ForEach)
+{
+    // With 8KB pages the addresses are rebuilt from the right page size
+    const unsigned page_shift = 13;
+    Blocks blocks(page_shift);
+    std::map<Addr, Addr> expected;
+    for (Addr vaddr : { ULL(0x0), ULL(0x2000), ULL(0x400000),
+                        ULL(0x10000000000) }) {
+        blocks.insert(vaddr, makeEntry(vaddr + 0x80000000));
+        expected[vaddr] = vaddr + 0x80000000;
+    }
+    blocks.erase(0x2000);
+    expected.erase(0x2000);
+
+    EXPECT_EQ(mappings(blocks), expected);
+    EXPECT_EQ(blocks.size(), expected.size());
+}
+
+TEST(PageBlocksTest, MatchesReference)
+{
+    // Random runs of inserts and erases over a few regions, checked
+    // against a plain map
+    Blocks blocks(PageShift);
+    std::map<Addr, Addr> expected;
+    std::mt19937_64 rng(1);
+    const Addr regions[] = { 0x400000, 0x10000000, 0x7ffff0000000 };
+
+    for (int step = 0; step < 2000; step++) {
+        const Addr start = regions[rng() % 3] +
+            (rng() % (4 * Blocks::BlockPages)) * PageBytes;
+        const Addr pages = 1 + rng() % (2 * Blocks::BlockPages);
+        const bool erase = rng() % 2;
+        for (Addr vaddr = start; vaddr < start + pages * PageBytes;
+                vaddr += PageBytes) {
+            const bool mapped = expected.count(vaddr);
+            if (erase && mapped) {
+                blocks.erase(vaddr);
+                expected.erase(vaddr);
+            } else if (!erase) {
+                EXPECT_EQ(blocks.insert(vaddr, makeEntry(step)), mapped);
+                expected[vaddr] = step;
+            }
+        }
+
+        const Addr probe = start + (rng() % pages) * PageBytes;
+        const Entry *entry = blocks.find(probe);
+        auto it = expected.find(probe);
+        ASSERT_EQ(entry != nullptr, it != expected.end());
+        if (entry) {
+            EXPECT_EQ(entry->paddr, it->second);
+        }
+    }
+
+    EXPECT_EQ(blocks.size(), expected.size());
+    EXPECT_EQ(mappings(blocks), expected);
+}
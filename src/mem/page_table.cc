@@ -35,12 +35,30 @@
 
 #include <string>
 
-#include "base/compiler.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
 #include "sim/faults.hh"
 #include "sim/serialize.hh"
 
+uint64_t EmulationPageTable::nextGeneration = 0;
+
+void
+EmulationPageTable::insert(Addr vaddr, const Entry &entry, bool clobber)
+{
+    // already mapped
+    panic_if(!clobber && pTable.find(vaddr),
+             "EmulationPageTable::allocate: addr %#x already mapped", vaddr);
+    if (pTable.insert(vaddr, entry))
+        _generation = ++nextGeneration;
+}
+
+void
+EmulationPageTable::erase(Addr vaddr)
+{
+    pTable.erase(vaddr);
+    _generation = ++nextGeneration;
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -51,16 +69,7 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+        insert(vaddr, Entry(paddr, flags), clobber);
 
         size -= pageSize;
         vaddr += pageSize;
@@ -78,12 +87,11 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
             new_vaddr, size);
 
     while (size > 0) {
-        auto new_it M5_VAR_USED = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+        const Entry *old_entry = pTable.find(vaddr);
+        assert(old_entry && !pTable.find(new_vaddr));
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+        insert(new_vaddr, *old_entry, false);
+        erase(vaddr);
         size -= pageSize;
         vaddr += pageSize;
         new_vaddr += pageSize;
@@ -93,8 +101,9 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    pTable.forEach([addr_maps](Addr vaddr, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
+    });
 }
 
 void
@@ -105,9 +114,7 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
+        erase(vaddr);
         size -= pageSize;
         vaddr += pageSize;
     }
@@ -120,7 +127,7 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     assert(pageOffset(vaddr) == 0);
 
     for (int64_t offset = 0; offset < size; offset += pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
+        if (pTable.find(vaddr + offset))
             return false;
 
     return true;
@@ -129,11 +136,7 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    return pTable.find(vaddr);
 }
 
 bool
@@ -171,14 +174,14 @@ EmulationPageTable::serialize(CheckpointOut &cp) const
     ScopedCheckpointSection sec(cp, "ptable");
     paramOut(cp, "size", pTable.size());
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    uint64_t count = 0;
+    pTable.forEach([&cp, &count](Addr vaddr, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
     assert(count == pTable.size());
 }
 
@@ -199,7 +202,7 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        insert(vaddr, Entry(paddr, flags), true);
     }
+    _generation = ++nextGeneration;
 }
-
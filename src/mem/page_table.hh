@@ -36,10 +36,11 @@
 #define __MEM_PAGE_TABLE_HH__
 
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "base/intmath.hh"
 #include "base/types.hh"
+#include "mem/page_blocks.hh"
 #include "mem/request.hh"
 #include "sim/serialize.hh"
 
@@ -58,9 +59,13 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    // The mappings, in blocks of consecutive pages.
+    PageBlocks<Entry> pTable;
+
+    // Replaced by a new, globally unique, value whenever an existing
+    // mapping changes or goes away.
+    uint64_t _generation;
+    static uint64_t nextGeneration;
 
     const Addr pageSize;
     const Addr offsetMask;
@@ -68,10 +73,14 @@ class EmulationPageTable : public Serializable
     const uint64_t _pid;
     const std::string _name;
 
+    void insert(Addr vaddr, const Entry &entry, bool clobber);
+    void erase(Addr vaddr);
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
+            pTable(floorLog2(_pageSize)), _generation(++nextGeneration),
             pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
             _pid(_pid), _name(__name), shared(false)
     {
@@ -80,6 +89,13 @@ class EmulationPageTable : public Serializable
 
     uint64_t pid() const { return _pid; };
 
+    /**
+     * Changes whenever an existing mapping changes, and is never shared
+     * with another page table, so that users which cache translations can
+     * tell when to drop them.
+     */
+    uint64_t generation() const { return _generation; }
+
     virtual ~EmulationPageTable() {};
 
     /* generic page table mapping flags
@@ -401,13 +401,15 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                 writeQueueSizes[tgt_prio] += moved_entries;
             }
 
+            // Erase element from source packet queue, this will
+            // increment the iterator. This is done before queuing the
+            // packet at its new priority, as queues may keep per-packet
+            // bookkeeping that is only valid while the packet is queued.
+            it = queues[curr_prio].erase(it);
+
             // Change QoS priority and move packet
             pkt->qosValue(tgt_prio);
             queues[tgt_prio].push_back(pkt);
-
-            // Erase element from source packet queue, this will
-            // increment the iterator
-            it = queues[curr_prio].erase(it);
             panic_if(packetPriorities[id][curr_prio] < moved_entries,
                      "QoSMemCtrl::escalate requestor %s negative packets "
                      "for priority %d",
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_FLATADDRMAP_HH__
+#define __MEM_RUBY_COMMON_FLATADDRMAP_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/Address.hh"
+
+/**
+ * An open-addressing hash table keyed by (line) addresses. All slots
+ * live in a single contiguous array and collisions are resolved by
+ * linear probing, so a lookup normally touches a single host cache
+ * line. Deletion uses backward shifting, which keeps probe sequences
+ * short without tombstones.
+ *
+ * The Ruby structures that use this map have a bounded number of live
+ * keys (cache blocks, TBEs), so the table is sized once through
+ * reserve() and never grows in steady state. Inserting beyond the
+ * reserved capacity is still supported and triggers a rehash.
+ */
+template <class T>
+class FlatAddrMap
+{
+  private:
+    struct Slot
+    {
+        Addr key;
+        T value;
+        bool used;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t count;
+    int shift;
+
+    size_t
+    home(Addr key) const
+    {
+        // Fibonacci hashing: line addresses have their low bits cleared,
+        // so take the high bits of the product instead of the low ones.
+        return (key * ULL(0x9E3779B97F4A7C15)) >> shift;
+    }
+
+    size_t
+    findSlot(Addr key) const
+    {
+        size_t i = home(key);
+        while (slots[i].used) {
+            if (slots[i].key == key)
+                return i;
+            i = (i + 1) & mask;
+        }
+        return slots.size();
+    }
+
+    void
+    resize(size_t capacity)
+    {
+        assert(isPowerOf2(capacity) && capacity >= 2);
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(capacity, Slot{0, T(), false});
+        mask = capacity - 1;
+        shift = 64 - floorLog2(capacity);
+        count = 0;
+        for (const auto &slot : old) {
+            if (slot.used)
+                insert(slot.key, slot.value);
+        }
+    }
+
+  public:
+    FlatAddrMap() : mask(0), count(0), shift(64)
+    {
+        resize(16);
+    }
+
+    /**
+     * Size the table so that n keys can be stored while keeping the
+     * load factor at or below one half.
+     */
+    void
+    reserve(size_t n)
+    {
+        size_t capacity = 16;
+        while (capacity < 2 * n)
+            capacity <<= 1;
+        if (capacity > slots.size())
+            resize(capacity);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /** Return a pointer to the value mapped to key, or nullptr. */
+    T *
+    find(Addr key)
+    {
+        size_t i = findSlot(key);
+        return i == slots.size() ? nullptr : &slots[i].value;
+    }
+
+    const T *
+    find(Addr key) const
+    {
+        size_t i = findSlot(key);
+        return i == slots.size() ? nullptr : &slots[i].value;
+    }
+
+    bool contains(Addr key) const { return findSlot(key) != slots.size(); }
+
+    /** Map key to value, overwriting any previous mapping. */
+    void
+    insert(Addr key, const T &value)
+    {
+        if (4 * (count + 1) > 3 * slots.size())
+            resize(2 * slots.size());
+
+        size_t i = home(key);
+        while (slots[i].used) {
+            if (slots[i].key == key) {
+                slots[i].value = value;
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[i].key = key;
+        slots[i].value = value;
+        slots[i].used = true;
+        count++;
+    }
+
+    /** Remove key from the map. Returns false if it was not present. */
+    bool
+    erase(Addr key)
+    {
+        size_t i = findSlot(key);
+        if (i == slots.size())
+            return false;
+
+        // Shift back any entries whose probe sequence crosses the hole,
+        // so that lookups never stop early on an empty slot.
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!slots[j].used)
+                break;
+            size_t k = home(slots[j].key);
+            bool in_range = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+            if (in_range)
+                continue;
+            slots[i] = slots[j];
+            i = j;
+        }
+        slots[i].used = false;
+        count--;
+        return true;
+    }
+
+    void
+    clear()
+    {
+        for (auto &slot : slots)
+            slot.used = false;
+        count = 0;
+    }
+
+    /** Call f(key, value) for every mapping, in unspecified order. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &slot : slots) {
+            if (slot.used)
+                f(slot.key, slot.value);
+        }
+    }
+};
+
+#endif // __MEM_RUBY_COMMON_FLATADDRMAP_HH__
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "mem/ruby/common/FlatAddrMap.hh"
+
+TEST(FlatAddrMapTest, Empty)
+{
+    FlatAddrMap<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.find(0x40), nullptr);
+    EXPECT_FALSE(map.contains(0x40));
+    EXPECT_FALSE(map.erase(0x40));
+}
+
+TEST(FlatAddrMapTest, InsertFindErase)
+{
+    FlatAddrMap<int> map;
+    map.insert(0x40, 1);
+    map.insert(0x80, 2);
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_NE(map.find(0x40), nullptr);
+    EXPECT_EQ(*map.find(0x40), 1);
+    EXPECT_EQ(*map.find(0x80), 2);
+    EXPECT_EQ(map.find(0xc0), nullptr);
+
+    // Inserting an existing key overwrites the value in place.
+    map.insert(0x40, 3);
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(*map.find(0x40), 3);
+
+    // Values can be updated through the returned pointer.
+    *map.find(0x80) = 4;
+    EXPECT_EQ(*map.find(0x80), 4);
+
+    EXPECT_TRUE(map.erase(0x40));
+    EXPECT_FALSE(map.erase(0x40));
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_FALSE(map.contains(0x40));
+    EXPECT_TRUE(map.contains(0x80));
+}
+
+TEST(FlatAddrMapTest, Clear)
+{
+    FlatAddrMap<int> map;
+    for (Addr a = 0; a < 100; a++)
+        map.insert(a << 6, a);
+    EXPECT_EQ(map.size(), 100);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    for (Addr a = 0; a < 100; a++)
+        EXPECT_FALSE(map.contains(a << 6));
+}
+
+/** Grow past the reserved capacity and check nothing is lost. */
+TEST(FlatAddrMapTest, GrowBeyondReserve)
+{
+    FlatAddrMap<Addr> map;
+    map.reserve(8);
+    for (Addr a = 0; a < 1000; a++)
+        map.insert(a << 6, a);
+    ASSERT_EQ(map.size(), 1000);
+    for (Addr a = 0; a < 1000; a++) {
+        ASSERT_NE(map.find(a << 6), nullptr);
+        EXPECT_EQ(*map.find(a << 6), a);
+    }
+}
+
+TEST(FlatAddrMapTest, ForEach)
+{
+    FlatAddrMap<int> map;
+    for (Addr a = 1; a <= 10; a++)
+        map.insert(a << 6, a);
+    Addr key_sum = 0;
+    int value_sum = 0;
+    map.forEach([&](Addr key, int value) {
+        EXPECT_EQ(key, Addr(value) << 6);
+        key_sum += key;
+        value_sum += value;
+    });
+    EXPECT_EQ(value_sum, 55);
+    EXPECT_EQ(key_sum, Addr(55) << 6);
+}
+
+/**
+ * Run a random sequence of inserts and erases on a small key space,
+ * so that probe sequences collide and wrap around the end of the
+ * table, and compare the map with std::unordered_map after each step.
+ * This exercises the backward shift done by erase().
+ */
+TEST(FlatAddrMapTest, RandomAgainstReference)
+{
+    FlatAddrMap<int> map;
+    map.reserve(64);
+    std::unordered_map<Addr, int> ref;
+    std::mt19937 rng(1);
+
+    for (int i = 0; i < 20000; i++) {
+        Addr key = (rng() % 96) << 6;
+        if (rng() % 2) {
+            map.insert(key, i);
+            ref[key] = i;
+        } else {
+            EXPECT_EQ(map.erase(key), ref.erase(key) == 1);
+        }
+
+        ASSERT_EQ(map.size(), ref.size());
+        for (Addr k = 0; k < 96; k++) {
+            auto it = ref.find(k << 6);
+            const int *v = map.find(k << 6);
+            if (it == ref.end()) {
+                ASSERT_EQ(v, nullptr);
+            } else {
+                ASSERT_NE(v, nullptr);
+                ASSERT_EQ(*v, it->second);
+            }
+        }
+    }
+}
@@ -30,6 +30,9 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+
 NetDest::NetDest()
 {
   resize();
@@ -38,16 +41,16 @@ NetDest::NetDest()
 void
 NetDest::add(MachineID newElement)
 {
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    assert(bitIndex(newElement.num) <
+           MachineType_base_count(newElement.type));
+    m_bits[wordIndex(newElement)] |= bitMask(newElement);
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
@@ -57,30 +60,28 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    std::copy_n(set.getWords(), wordsPerType,
+                &m_bits[MachineType_base_level(machine) * wordsPerType]);
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    m_bits[wordIndex(oldElement)] &= ~bitMask(oldElement);
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    std::fill_n(m_bits, numWords, 0);
 }
 
 void
@@ -95,9 +96,11 @@ NetDest::broadcast()
 void
 NetDest::broadcast(MachineType machineType)
 {
-    for (NodeID i = 0; i < MachineType_base_count(machineType); i++) {
-        MachineID mach = {machineType, i};
-        add(mach);
+    int nodes = MachineType_base_count(machineType);
+    uint64_t *words = &m_bits[MachineType_base_level(machineType) *
+                              wordsPerType];
+    for (int i = 0; i < wordsPerType && nodes > i * 64; i++) {
+        words[i] |= mask(nodes - i * 64);
     }
 }
 
@@ -107,12 +110,11 @@ NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
     dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
+    for (int i = 0; i < numWords; i++) {
+        for (uint64_t word = m_bits[i]; word; word &= word - 1) {
+            MachineID mach = machineAt(i, findLsbSet(word));
+            int id = MachineType_base_number(mach.type) + mach.num;
+            dest.push_back((NodeID)id);
         }
     }
     return dest;
@@ -122,8 +124,8 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < numWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
@@ -131,19 +133,16 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
     assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i]) {
+            return machineAt(i, findLsbSet(m_bits[i]));
         }
     }
     panic("No smallest element of an empty set.");
@@ -152,11 +151,10 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
-            return mach;
+    int first = MachineType_base_level(machine) * wordsPerType;
+    for (int i = first; i < first + wordsPerType; i++) {
+        if (m_bits[i]) {
+            return machineAt(i, findLsbSet(m_bits[i]));
         }
     }
 
@@ -167,8 +165,12 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
+    for (int m = 0; m < MachineType_NUM; m++) {
+        int nodes = 0;
+        for (int i = m * wordsPerType; i < (m + 1) * wordsPerType; i++) {
+            nodes += popCount(m_bits[i]);
+        }
+        if (nodes != MachineType_base_count((MachineType)m)) {
             return false;
         }
     }
@@ -179,22 +181,20 @@ NetDest::isBroadcast() const
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
-            return false;
-        }
+    uint64_t r = 0;
+    for (int i = 0; i < numWords; i++) {
+        r |= m_bits[i];
     }
-    return true;
+    return r == 0;
 }
 
 // returns the logical OR of "this" set and orNetDest
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -203,65 +203,55 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
 
-// Returns true if the intersection of the two sets is non-empty
-bool
-NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
-{
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
-    }
-    return false;
-}
-
 bool
 NetDest::isSuperset(const NetDest& test) const
 {
-    assert(m_bits.size() == test.getSize());
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
-            return false;
-        }
+    uint64_t r = 0;
+    for (int i = 0; i < numWords; i++) {
+        r |= test.m_bits[i] & ~m_bits[i];
     }
-    return true;
+    return r == 0;
 }
 
 bool
 NetDest::isElement(MachineID element) const
 {
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
+    return m_bits[wordIndex(element)] & bitMask(element);
 }
 
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
+    // The layout only depends on the number of machine types, which is
+    // known at compile time, but each type only has room for
+    // NUMBER_BITS_PER_SET machines.
+    for (int i = 0; i < MachineType_NUM; i++) {
+        int size = MachineType_base_count((MachineType)i);
+        if (size > NUMBER_BITS_PER_SET)
+            fatal("Number of bits(%d) < size specified(%d). "
+                  "Increase the number of bits and recompile.\n",
+                  NUMBER_BITS_PER_SET, size);
     }
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << MachineType_NUM << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (int i = 0; i < MachineType_NUM; i++) {
+        MachineType machine = MachineType_from_base_level(i);
+        for (int j = 0; j < MachineType_base_count(machine); j++) {
+            MachineID mach = {machine, NodeID(j)};
+            out << isElement(mach) << " ";
         }
         out << " - ";
     }
@@ -271,9 +261,8 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i] != n.m_bits[i])
             return false;
     }
     return true;
@@ -29,6 +29,7 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -67,10 +68,21 @@ class NetDest
     NetDest AND(const NetDest& andNetDest) const;
 
     // Returns true if the intersection of the two netDests is non-empty
-    bool intersectionIsNotEmpty(const NetDest& other_netDest) const;
+    bool
+    intersectionIsNotEmpty(const NetDest& other_netDest) const
+    {
+        uint64_t r = 0;
+        for (int i = 0; i < numWords; i++)
+            r |= m_bits[i] & other_netDest.m_bits[i];
+        return r != 0;
+    }
 
     // Returns true if the intersection of the two netDests is empty
-    bool intersectionIsEmpty(const NetDest& other_netDest) const;
+    bool
+    intersectionIsEmpty(const NetDest& other_netDest) const
+    {
+        return !intersectionIsNotEmpty(other_netDest);
+    }
 
     bool isSuperset(const NetDest& test) const;
     bool isSubset(const NetDest& test) const { return test.isSuperset(*this); }
@@ -85,7 +97,7 @@ class NetDest
     MachineID smallestElement(MachineType machine) const;
 
     void resize();
-    int getSize() const { return m_bits.size(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -93,19 +105,43 @@ class NetDest
     void print(std::ostream& out) const;
 
   private:
+    // Every machine type owns a word-aligned run of Set::numWords words
+    static const int wordsPerType = Set::numWords;
+    static const int numWords = MachineType_NUM * wordsPerType;
+
     // returns a value >= MachineType_base_level("this machine")
     // and < MachineType_base_level("next highest machine")
     int
     vecIndex(MachineID m) const
     {
         int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
+        assert(vec_index < MachineType_NUM);
         return vec_index;
     }
 
     NodeID bitIndex(NodeID index) const { return index; }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    int
+    wordIndex(MachineID m) const
+    {
+        return vecIndex(m) * wordsPerType + bitIndex(m.num) / 64;
+    }
+
+    uint64_t bitMask(MachineID m) const { return ULL(1) << (m.num % 64); }
+
+    // Converts a position in m_bits back to the machine it stands for
+    MachineID
+    machineAt(int word, int bit) const
+    {
+        MachineID mach = {MachineType_from_base_level(word / wordsPerType),
+                          NodeID((word % wordsPerType) * 64 + bit)};
+        return mach;
+    }
+
+    // A single flat bit vector holding the destinations of all machine
+    // types, so that set operations are plain word loops the compiler can
+    // vectorize, and copying a NetDest never allocates.
+    uint64_t m_bits[numWords];
 };
 
 inline std::ostream&
@@ -32,23 +32,42 @@
 #ifndef __MEM_RUBY_COMMON_SET_HH__
 #define __MEM_RUBY_COMMON_SET_HH__
 
-#include <bitset>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
+#include "base/types.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
 class Set
 {
+  public:
+    // Number of 64-bit words needed to hold NUMBER_BITS_PER_SET bits
+    static const int numWords = (NUMBER_BITS_PER_SET + 63) / 64;
+
   private:
     // Number of bits in use in this set.
     // can be defined in build_opts file (default=64).
     int m_nSize;
-    std::bitset<NUMBER_BITS_PER_SET> bits;
+    // Bits are stored in plain words rather than a std::bitset so that
+    // whole-set operations compile to a few (vectorizable) word loops and
+    // NetDest can copy sets in and out of its own flat bit vector.
+    uint64_t bits[numWords];
+
+    static int wordIndex(NodeID index) { return index / 64; }
+    static uint64_t bitMask(NodeID index) { return ULL(1) << (index % 64); }
+
+    void
+    clearWords()
+    {
+        for (int i = 0; i < numWords; i++)
+            bits[i] = 0;
+    }
 
   public:
-    Set() : m_nSize(0) {}
+    Set() : m_nSize(0) { clearWords(); }
 
     Set(int size) : m_nSize(size)
     {
@@ -56,22 +75,19 @@ class Set
             fatal("Number of bits(%d) < size specified(%d). "
                   "Increase the number of bits and recompile.\n",
                   NUMBER_BITS_PER_SET, size);
+        clearWords();
     }
 
-    Set(const Set& obj) : m_nSize(obj.m_nSize), bits(obj.bits) {}
+    Set(const Set& obj) = default;
     ~Set() {}
 
-    Set& operator=(const Set& obj)
-    {
-        m_nSize = obj.m_nSize;
-        bits = obj.bits;
-        return *this;
-    }
+    Set& operator=(const Set& obj) = default;
 
     void
     add(NodeID index)
     {
-        bits.set(index);
+        assert(index < NUMBER_BITS_PER_SET);
+        bits[wordIndex(index)] |= bitMask(index);
     }
 
     /*
@@ -82,7 +98,8 @@ class Set
     addSet(const Set& obj)
     {
         assert(m_nSize == obj.m_nSize);
-        bits |= obj.bits;
+        for (int i = 0; i < numWords; i++)
+            bits[i] |= obj.bits[i];
     }
 
     /*
@@ -91,7 +108,8 @@ class Set
     void
     remove(NodeID index)
     {
-        bits.reset(index);
+        assert(index < NUMBER_BITS_PER_SET);
+        bits[wordIndex(index)] &= ~bitMask(index);
     }
 
     /*
@@ -101,26 +119,39 @@ class Set
     removeSet(const Set& obj)
     {
         assert(m_nSize == obj.m_nSize);
-        bits &= (~obj.bits);
+        for (int i = 0; i < numWords; i++)
+            bits[i] &= ~obj.bits[i];
     }
 
-    void clear() { bits.reset(); }
+    void clear() { clearWords(); }
 
     /*
      * this function sets all bits in the set
      */
     void broadcast()
     {
-        bits.set();
-        for (int j = m_nSize; j < NUMBER_BITS_PER_SET; ++j) {
-            bits.reset(j);
+        for (int i = 0; i < numWords; i++) {
+            int lo = i * 64;
+            if (m_nSize >= lo + 64)
+                bits[i] = ~ULL(0);
+            else if (m_nSize > lo)
+                bits[i] = mask(m_nSize - lo);
+            else
+                bits[i] = 0;
         }
     }
 
     /*
      * This function returns the population count of 1's in the set
      */
-    int count() const { return bits.count(); }
+    int
+    count() const
+    {
+        int counter = 0;
+        for (int i = 0; i < numWords; i++)
+            counter += popCount(bits[i]);
+        return counter;
+    }
 
     /*
      * This function checks for set equality
@@ -129,7 +160,11 @@ class Set
     isEqual(const Set& obj) const
     {
         assert(m_nSize == obj.m_nSize);
-        return bits == obj.bits;
+        for (int i = 0; i < numWords; i++) {
+            if (bits[i] != obj.bits[i])
+                return false;
+        }
+        return true;
     }
 
     // return the logical OR of this set and orSet
@@ -138,7 +173,8 @@ class Set
     {
         assert(m_nSize == obj.m_nSize);
         Set r(m_nSize);
-        r.bits = bits | obj.bits;
+        for (int i = 0; i < numWords; i++)
+            r.bits[i] = bits[i] | obj.bits[i];
         return r;
     };
 
@@ -148,7 +184,8 @@ class Set
     {
         assert(m_nSize == obj.m_nSize);
         Set r(m_nSize);
-        r.bits = bits & obj.bits;
+        for (int i = 0; i < numWords; i++)
+            r.bits[i] = bits[i] & obj.bits[i];
         return r;
     }
 
@@ -156,8 +193,10 @@ class Set
     bool
     intersectionIsEmpty(const Set& obj) const
     {
-        std::bitset<NUMBER_BITS_PER_SET> r = bits & obj.bits;
-        return r.none();
+        uint64_t r = 0;
+        for (int i = 0; i < numWords; i++)
+            r |= bits[i] & obj.bits[i];
+        return r == 0;
     }
 
     /*
@@ -168,13 +207,20 @@ class Set
     isSuperset(const Set& test) const
     {
         assert(m_nSize == test.m_nSize);
-        std::bitset<NUMBER_BITS_PER_SET> r = bits | test.bits;
-        return (r == bits);
+        uint64_t r = 0;
+        for (int i = 0; i < numWords; i++)
+            r |= test.bits[i] & ~bits[i];
+        return r == 0;
     }
 
     bool isSubset(const Set& test) const { return test.isSuperset(*this); }
 
-    bool isElement(NodeID element) const { return bits.test(element); }
+    bool
+    isElement(NodeID element) const
+    {
+        assert(element < NUMBER_BITS_PER_SET);
+        return bits[wordIndex(element)] & bitMask(element);
+    }
 
     /*
      * this function returns true iff all bits in use are set
@@ -182,22 +228,32 @@ class Set
     bool
     isBroadcast() const
     {
-        return (bits.count() == m_nSize);
+        return (count() == m_nSize);
     }
 
-    bool isEmpty() const { return bits.none(); }
+    bool
+    isEmpty() const
+    {
+        uint64_t r = 0;
+        for (int i = 0; i < numWords; i++)
+            r |= bits[i];
+        return r == 0;
+    }
 
     NodeID smallestElement() const
     {
-        for (int i = 0; i < m_nSize; ++i) {
-            if (bits.test(i)) {
-                return i;
+        for (int i = 0; i < numWords; i++) {
+            if (bits[i]) {
+                NodeID element = i * 64 + findLsbSet(bits[i]);
+                if (element < m_nSize)
+                    return element;
+                break;
             }
         }
         panic("No smallest element of an empty set.");
     }
 
-    bool elementAt(int index) const { return bits[index]; }
+    bool elementAt(int index) const { return isElement(index); }
 
     int getSize() const { return m_nSize; }
 
@@ -209,12 +265,20 @@ class Set
                   "Increase the number of bits and recompile.\n",
                   NUMBER_BITS_PER_SET, size);
         m_nSize = size;
-        bits.reset();
+        clearWords();
     }
 
+    // Raw access to the underlying words, used by NetDest
+    const uint64_t *getWords() const { return bits; }
+    uint64_t *getWords() { return bits; }
+
     void print(std::ostream& out) const
     {
-        out << "[Set (" << m_nSize << "): " << bits << "]";
+        // Same format as printing a std::bitset: most significant bit first
+        out << "[Set (" << m_nSize << "): ";
+        for (int i = NUMBER_BITS_PER_SET - 1; i >= 0; i--)
+            out << (isElement(i) ? '1' : '0');
+        out << "]";
     }
 };
 
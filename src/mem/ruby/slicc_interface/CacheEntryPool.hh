@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_SLICC_INTERFACE_CACHEENTRYPOOL_HH__
+#define __MEM_RUBY_SLICC_INTERFACE_CACHEENTRYPOOL_HH__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Slab allocator for SLICC generated cache entry types. Each protocol
+ * entry type gets its own pool, so entries of the same cache are packed
+ * into large contiguous slabs instead of being scattered across the
+ * host heap. Freed entries are kept on a LIFO free list and handed out
+ * again on the next allocation, which means a replacement usually
+ * reuses the storage of the block it just evicted and steady-state
+ * operation does not touch the system allocator at all.
+ *
+ * SLICC emits class specific operator new/delete that forward to this
+ * pool for every type implementing AbstractCacheEntry. That includes
+ * the directory entries of most protocols (e.g. Directory_Entry), which
+ * DirectoryMemory allocates once per block and rarely frees, so they
+ * are packed the same way. Ruby runs on a single event queue, so the
+ * pool is not thread safe.
+ */
+template <class T>
+class CacheEntryPool
+{
+  private:
+    union Node
+    {
+        Node *next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    static const size_t entriesPerSlab = 256;
+
+    Node *freeList = nullptr;
+    std::vector<Node *> slabs;
+
+    static CacheEntryPool &
+    instance()
+    {
+        // Never destroyed: entries may outlive static destruction.
+        static CacheEntryPool *pool = new CacheEntryPool;
+        return *pool;
+    }
+
+    void
+    grow()
+    {
+        Node *slab = new Node[entriesPerSlab];
+        slabs.push_back(slab);
+        // Thread the slab in address order so that consecutive
+        // allocations are adjacent in memory.
+        for (size_t i = entriesPerSlab; i-- > 0; ) {
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+    }
+
+  public:
+    static void *
+    allocate(size_t size)
+    {
+        // Classes derived from T fall back to the global allocator.
+        if (size != sizeof(T))
+            return ::operator new(size);
+
+        CacheEntryPool &pool = instance();
+        if (!pool.freeList)
+            pool.grow();
+        Node *node = pool.freeList;
+        pool.freeList = node->next;
+        return node;
+    }
+
+    static void
+    release(void *ptr, size_t size)
+    {
+        if (!ptr)
+            return;
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        CacheEntryPool &pool = instance();
+        Node *node = static_cast<Node *>(ptr);
+        node->next = pool.freeList;
+        pool.freeList = node;
+    }
+};
+
+#endif // __MEM_RUBY_SLICC_INTERFACE_CACHEENTRYPOOL_HH__
@@ -97,16 +97,12 @@ CacheMemory::init()
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
-    m_cache.resize(m_cache_num_sets,
-                    std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
-    replacement_data.resize(m_cache_num_sets,
-                               std::vector<ReplData>(m_cache_assoc, nullptr));
+    m_cache.resize(getNumBlocks(), nullptr);
+    m_tag_index.reserve(getNumBlocks());
+    replacement_data.resize(getNumBlocks(), nullptr);
     // instantiate all the replacement_data here
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for ( int j = 0; j < m_cache_assoc; j++) {
-            replacement_data[i][j] =
-                                m_replacementPolicy_ptr->instantiateEntry();
-        }
+    for (auto &repl_data : replacement_data) {
+        repl_data = m_replacementPolicy_ptr->instantiateEntry();
     }
 }
 
@@ -114,10 +110,8 @@ CacheMemory::~CacheMemory()
 {
     if (m_replacementPolicy_ptr)
         delete m_replacementPolicy_ptr;
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            delete m_cache[i][j];
-        }
+    for (auto entry : m_cache) {
+        delete entry;
     }
 }
 
@@ -137,11 +131,10 @@ CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    const int *way = m_tag_index.find(tag);
+    if (way && entryAt(cacheSet, *way)->m_Permission !=
+        AccessPermission_NotPresent)
+        return *way;
     return -1; // Not found
 }
 
@@ -153,10 +146,8 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
-    return -1; // Not found
+    const int *way = m_tag_index.find(tag);
+    return way ? *way : -1;
 }
 
 // Given an unique cache block identifier (idx): return the valid address
@@ -173,7 +164,7 @@ CacheMemory::getAddressAtIdx(int idx) const
     int way = idx - set * m_cache_assoc;
     assert (way < m_cache_assoc);
 
-    AbstractCacheEntry* entry = m_cache[set][way];
+    AbstractCacheEntry* entry = entryAt(set, way);
     if (entry == NULL ||
         entry->m_Permission == AccessPermission_Invalid ||
         entry->m_Permission == AccessPermission_NotPresent) {
@@ -251,7 +242,7 @@ CacheMemory::cacheAvail(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
 
     for (int i = 0; i < m_cache_assoc; i++) {
-        AbstractCacheEntry* entry = m_cache[cacheSet][i];
+        AbstractCacheEntry* entry = entryAt(cacheSet, i);
         if (entry != NULL) {
             if (entry->m_Address == address ||
                 entry->m_Permission == AccessPermission_NotPresent) {
@@ -275,7 +266,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
-    std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    AbstractCacheEntry **set = &entryAt(cacheSet, 0);
     for (int i = 0; i < m_cache_assoc; i++) {
         if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
             if (set[i] && (set[i] != entry)) {
@@ -285,15 +276,20 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
                     "leak here. Fix your protocol to eliminate these!",
                     address);
             }
+            if (set[i]) {
+                // Drop the index entry of the block being overwritten
+                m_tag_index.erase(set[i]->m_Address);
+            }
             set[i] = entry;  // Init entry
             set[i]->m_Address = address;
             set[i]->m_Permission = AccessPermission_Invalid;
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tag_index.insert(address, i);
             set[i]->setPosition(cacheSet, i);
-            set[i]->replacementData = replacement_data[cacheSet][i];
+            set[i]->replacementData =
+                replacement_data[entryIndex(cacheSet, i)];
             set[i]->setLastAccess(curTick());
 
             // Call reset function here to set initial value for different
@@ -316,7 +312,7 @@ CacheMemory::deallocate(Addr address)
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
-    m_cache[cache_set][way] = NULL;
+    entryAt(cache_set, way) = NULL;
     m_tag_index.erase(address);
 }
 
@@ -331,10 +327,10 @@ CacheMemory::cacheProbe(Addr address) const
     std::vector<ReplaceableEntry*> candidates;
     for (int i = 0; i < m_cache_assoc; i++) {
         candidates.push_back(static_cast<ReplaceableEntry*>(
-                                                       m_cache[cacheSet][i]));
+                                                       entryAt(cacheSet, i)));
     }
-    return m_cache[cacheSet][m_replacementPolicy_ptr->
-                        getVictim(candidates)->getWay()]->m_Address;
+    return entryAt(cacheSet, m_replacementPolicy_ptr->
+                        getVictim(candidates)->getWay())->m_Address;
 }
 
 // looks an address up in the cache
@@ -345,7 +341,7 @@ CacheMemory::lookup(Addr address)
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return entryAt(cacheSet, loc);
 }
 
 // looks an address up in the cache
@@ -356,7 +352,7 @@ CacheMemory::lookup(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return entryAt(cacheSet, loc);
 }
 
 // Sets the most recently used bit for a cache block
@@ -402,8 +398,8 @@ CacheMemory::getReplacementWeight(int64_t set, int64_t loc)
     assert(set < m_cache_num_sets);
     assert(loc < m_cache_assoc);
     int ret = 0;
-    if (m_cache[set][loc] != NULL) {
-        ret = m_cache[set][loc]->getNumValidBlocks();
+    if (entryAt(set, loc) != NULL) {
+        ret = entryAt(set, loc)->getNumValidBlocks();
         assert(ret >= 0);
     }
 
@@ -419,8 +415,9 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
 
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
-                AccessPermission perm = m_cache[i][j]->m_Permission;
+            AbstractCacheEntry *entry = entryAt(i, j);
+            if (entry != NULL) {
+                AccessPermission perm = entry->m_Permission;
                 RubyRequestType request_type = RubyRequestType_NULL;
                 if (perm == AccessPermission_Read_Only) {
                     if (m_is_instruction_only_cache) {
@@ -433,11 +430,9 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
                 }
 
                 if (request_type != RubyRequestType_NULL) {
-                    Tick lastAccessTick;
-                    lastAccessTick = m_cache[i][j]->getLastAccess();
-                    tr->addRecord(cntrl, m_cache[i][j]->m_Address,
-                                  0, request_type, lastAccessTick,
-                                  m_cache[i][j]->getDataBlk());
+                    tr->addRecord(cntrl, entry->m_Address,
+                                  0, request_type, entry->getLastAccess(),
+                                  entry->getDataBlk());
                     warmedUpBlocks++;
                 }
             }
@@ -455,10 +450,10 @@ CacheMemory::print(ostream& out) const
     out << "Cache dump: " << name() << endl;
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
+            if (entryAt(i, j) != NULL) {
                 out << "  Index: " << i
                     << " way: " << j
-                    << " entry: " << *m_cache[i][j] << endl;
+                    << " entry: " << *entryAt(i, j) << endl;
             } else {
                 out << "  Index: " << i
                     << " way: " << j
@@ -496,15 +491,11 @@ void
 CacheMemory::clearLockedAll(int context)
 {
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i) {
-        std::vector<AbstractCacheEntry*> set = *i;
-        for (auto j = set.begin(); j != set.end(); ++j) {
-            AbstractCacheEntry *line = *j;
-            if (line && line->isLocked(context)) {
-                DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
-                    line->m_Address);
-                line->clearLocked();
-            }
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line && line->isLocked(context)) {
+            DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
+                line->m_Address);
+            line->clearLocked();
         }
     }
 }
@@ -705,13 +696,13 @@ CacheMemory::checkResourceAvailable(CacheResourceType res, Addr addr)
 bool
 CacheMemory::isBlockInvalid(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission == AccessPermission_Invalid);
+  return (entryAt(cache_set, loc)->m_Permission == AccessPermission_Invalid);
 }
 
 bool
 CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission != AccessPermission_Busy);
+  return (entryAt(cache_set, loc)->m_Permission != AccessPermission_Busy);
 }
 
 /* hardware transactional memory */
@@ -723,24 +714,16 @@ CacheMemory::htmAbortTransaction()
     uint64_t htmWriteSetSize = 0;
 
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                if (line->getInHtmWriteSet()) {
-                    line->invalidateEntry();
-                }
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line != nullptr) {
+            htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+            htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+            if (line->getInHtmWriteSet()) {
+                line->invalidateEntry();
             }
+            line->setInHtmWriteSet(false);
+            line->setInHtmReadSet(false);
+            line->clearLocked();
         }
     }
 
@@ -757,20 +740,13 @@ CacheMemory::htmCommitTransaction()
     uint64_t htmWriteSetSize = 0;
 
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-             }
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line != nullptr) {
+            htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+            htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+            line->setInHtmWriteSet(false);
+            line->setInHtmReadSet(false);
+            line->clearLocked();
         }
     }
 
@@ -43,13 +43,13 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/FlatAddrMap.hh"
 #include "mem/ruby/protocol/CacheRequestType.hh"
 #include "mem/ruby/protocol/CacheResourceType.hh"
 #include "mem/ruby/protocol/RubyRequest.hh"
@@ -187,6 +187,25 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Position of a (set, way) pair in the flat entry arrays
+    size_t
+    entryIndex(int64_t cacheSet, int way) const
+    {
+        return cacheSet * m_cache_assoc + way;
+    }
+
+    AbstractCacheEntry *&
+    entryAt(int64_t cacheSet, int way)
+    {
+        return m_cache[entryIndex(cacheSet, way)];
+    }
+
+    AbstractCacheEntry *
+    entryAt(int64_t cacheSet, int way) const
+    {
+        return m_cache[entryIndex(cacheSet, way)];
+    }
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -195,10 +214,15 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Maps the address of every allocated block to its way. The table is
+    // sized for the number of blocks in the cache, so lookups never
+    // allocate and usually resolve with a single host cache line access.
+    FlatAddrMap<int> m_tag_index;
+
+    // Entry pointers stored set by set: the ways of a set are contiguous,
+    // so scanning a set for a victim or a free way walks a single run of
+    // memory. Use entryAt() to index by (set, way).
+    std::vector<AbstractCacheEntry*> m_cache;
 
     /**
      * We use BaseReplacementPolicy from Classic system here, hence we can use
@@ -218,14 +242,14 @@ class CacheMemory : public SimObject
     int m_block_size;
 
     /**
-     * We store all the ReplacementData in a 2-dimensional array. By doing
-     * this, we can use all replacement policies from Classic system. Ruby
-     * cache will deallocate cache entry every time we evict the cache block
-     * so we cannot store the ReplacementData inside the cache entry.
-     * Instantiate ReplacementData for multiple times will break replacement
-     * policy like TreePLRU.
+     * We store all the ReplacementData in an array laid out like m_cache.
+     * By doing this, we can use all replacement policies from Classic
+     * system. Ruby cache will deallocate cache entry every time we evict
+     * the cache block so we cannot store the ReplacementData inside the
+     * cache entry. Instantiate ReplacementData for multiple times will
+     * break replacement policy like TreePLRU.
      */
-    std::vector<std::vector<ReplData> > replacement_data;
+    std::vector<ReplData> replacement_data;
 
     /**
      * Set to true when using WeightedLRU replacement policy, otherwise, set to
@@ -41,18 +41,34 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <cassert>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
+#include "base/logging.hh"
 #include "mem/ruby/common/Address.hh"
-
+#include "mem/ruby/common/FlatAddrMap.hh"
+
+/**
+ * Table of transaction buffer entries. The number of TBEs of a
+ * controller is bounded, so all entries are allocated up front in a
+ * single array and recycled through a free list, while an
+ * open-addressing index maps line addresses to their slot. Entries keep
+ * a stable address for as long as they are allocated and neither
+ * allocate() nor lookup() touch the heap.
+ */
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_entries(number_of_TBEs), m_number_of_TBEs(number_of_TBEs)
     {
+        // Hand out the lowest slots first
+        m_free_slots.reserve(number_of_TBEs);
+        for (int i = number_of_TBEs - 1; i >= 0; i--)
+            m_free_slots.push_back(i);
+        m_index.reserve(number_of_TBEs);
     }
 
     bool isPresent(Addr address) const;
@@ -61,7 +77,7 @@ class TBETable
     bool
     areNSlotsAvailable(int n, Tick current_time) const
     {
-        return (m_number_of_TBEs - m_map.size()) >= n;
+        return (m_number_of_TBEs - m_index.size()) >= n;
     }
 
     ENTRY *getNullEntry();
@@ -76,7 +92,9 @@ class TBETable
     TBETable& operator=(const TBETable& obj);
 
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    std::vector<ENTRY> m_entries;
+    std::vector<int> m_free_slots;
+    FlatAddrMap<int> m_index;
 
   private:
     int m_number_of_TBEs;
@@ -96,8 +114,8 @@ inline bool
 TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    assert(m_index.size() <= m_number_of_TBEs);
+    return m_index.contains(address);
 }
 
 template<class ENTRY>
@@ -105,8 +123,12 @@ inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
     assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    panic_if(m_free_slots.empty(), "All %d TBEs are in use, cannot "
+             "allocate a TBE for %#x.\n", m_number_of_TBEs, address);
+    int slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    m_entries[slot] = ENTRY();
+    m_index.insert(address, slot);
 }
 
 template<class ENTRY>
@@ -114,8 +136,9 @@ inline void
 TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
-    assert(m_map.size() > 0);
-    m_map.erase(address);
+    assert(m_index.size() > 0);
+    m_free_slots.push_back(*m_index.find(address));
+    m_index.erase(address);
 }
 
 template<class ENTRY>
@@ -130,8 +153,8 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    const int *slot = m_index.find(address);
+    return slot ? &m_entries[*slot] : nullptr;
 }
 
 
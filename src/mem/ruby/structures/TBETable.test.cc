@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/bitfield.hh"
+#include "mem/ruby/structures/TBETable.hh"
+
+// Address.cc takes the line size from RubySystem. The table only needs
+// makeLineAddress() for its sanity checks, so use 64 byte lines here.
+Addr
+makeLineAddress(Addr addr)
+{
+    return mbits<Addr>(addr, 63, 6);
+}
+
+namespace {
+
+struct TestEntry
+{
+    int state = 0;
+};
+
+} // anonymous namespace
+
+TEST(TBETableTest, AllocateLookupDeallocate)
+{
+    TBETable<TestEntry> table(4);
+    EXPECT_FALSE(table.isPresent(0x40));
+    EXPECT_EQ(table.lookup(0x40), table.getNullEntry());
+
+    table.allocate(0x40);
+    EXPECT_TRUE(table.isPresent(0x40));
+    TestEntry *entry = table.lookup(0x40);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->state, 0);
+    entry->state = 7;
+
+    // Allocating other entries does not move the first one.
+    table.allocate(0x80);
+    table.allocate(0xc0);
+    EXPECT_EQ(table.lookup(0x40), entry);
+    EXPECT_EQ(table.lookup(0x40)->state, 7);
+    EXPECT_NE(table.lookup(0x80), entry);
+
+    table.deallocate(0x40);
+    EXPECT_FALSE(table.isPresent(0x40));
+    EXPECT_EQ(table.lookup(0x40), nullptr);
+    EXPECT_TRUE(table.isPresent(0x80));
+    EXPECT_TRUE(table.isPresent(0xc0));
+}
+
+TEST(TBETableTest, SlotsAvailable)
+{
+    TBETable<TestEntry> table(2);
+    EXPECT_TRUE(table.areNSlotsAvailable(2, 0));
+    EXPECT_FALSE(table.areNSlotsAvailable(3, 0));
+
+    table.allocate(0x40);
+    EXPECT_TRUE(table.areNSlotsAvailable(1, 0));
+    EXPECT_FALSE(table.areNSlotsAvailable(2, 0));
+
+    table.allocate(0x80);
+    EXPECT_TRUE(table.areNSlotsAvailable(0, 0));
+    EXPECT_FALSE(table.areNSlotsAvailable(1, 0));
+
+    table.deallocate(0x40);
+    EXPECT_TRUE(table.areNSlotsAvailable(1, 0));
+}
+
+/** A recycled slot holds a freshly constructed entry. */
+TEST(TBETableTest, ReallocateResetsEntry)
+{
+    TBETable<TestEntry> table(1);
+    table.allocate(0x40);
+    table.lookup(0x40)->state = 3;
+    table.deallocate(0x40);
+
+    table.allocate(0x100);
+    ASSERT_NE(table.lookup(0x100), nullptr);
+    EXPECT_EQ(table.lookup(0x100)->state, 0);
+}
+
+/** Allocating more TBEs than the controller has is a protocol bug. */
+TEST(TBETableTest, Exhausted)
+{
+    TBETable<TestEntry> table(2);
+    table.allocate(0x40);
+    table.allocate(0x80);
+    EXPECT_ANY_THROW(table.allocate(0xc0));
+}
+
+/** Cycle many addresses through a small table. */
+TEST(TBETableTest, ManyAllocations)
+{
+    const int num_tbes = 16;
+    TBETable<TestEntry> table(num_tbes);
+    for (int i = 0; i < 1000; i++) {
+        Addr addr = Addr(i) << 6;
+        if (i >= num_tbes) {
+            Addr old = Addr(i - num_tbes) << 6;
+            ASSERT_TRUE(table.isPresent(old));
+            ASSERT_EQ(table.lookup(old)->state, i - num_tbes);
+            table.deallocate(old);
+        }
+        table.allocate(addr);
+        table.lookup(addr)->state = i;
+    }
+    EXPECT_FALSE(table.areNSlotsAvailable(1, 0));
+}
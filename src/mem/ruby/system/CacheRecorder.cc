@@ -46,18 +46,21 @@ TraceRecord::print(ostream& out) const
 CacheRecorder::CacheRecorder()
     : m_uncompressed_trace(NULL),
       m_uncompressed_trace_size(0),
-      m_block_size_bytes(RubySystem::getBlockSizeBytes())
+      m_block_size_bytes(RubySystem::getBlockSizeBytes()),
+      m_parallel_warmup(false)
 {
 }
 
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
                              std::vector<Sequencer*>& seq_map,
-                             uint64_t block_size_bytes)
+                             uint64_t block_size_bytes,
+                             bool parallel_warmup)
     : m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
       m_seq_map(seq_map),  m_bytes_read(0), m_records_read(0),
-      m_records_flushed(0), m_block_size_bytes(block_size_bytes)
+      m_records_flushed(0), m_block_size_bytes(block_size_bytes),
+      m_parallel_warmup(parallel_warmup)
 {
     if (m_uncompressed_trace != NULL) {
         if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
@@ -67,6 +70,9 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
             panic("Recorded cache block size (%d) < current block size (%d) !!",
                     m_block_size_bytes, RubySystem::getBlockSizeBytes());
         }
+
+        if (m_parallel_warmup)
+            setupParallelFetch();
     }
 }
 
@@ -101,55 +107,198 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
+int
+CacheRecorder::issueFetchRequest(const TraceRecord* traceRecord,
+                                 Sequencer* seq)
+{
+    assert(seq != NULL);
+    DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+
+    int packets = 0;
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        RequestPtr req;
+        MemCmd::Command requestType;
+
+        if (traceRecord->m_type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                                Request::funcRequestorId);
+        }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                    traceRecord->m_data_address + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcRequestorId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = std::make_shared<Request>(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                            Request::funcRequestorId);
+        }
+
+        Packet *pkt = new Packet(req, requestType);
+        // The trace buffer outlives the request
+        pkt->dataStatic(const_cast<uint8_t *>(traceRecord->m_data) +
+                        rec_bytes_read);
+
+        seq->makeRequest(pkt);
+        packets++;
+    }
+
+    return packets;
+}
+
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
+    if (m_parallel_warmup) {
+        // Start the replay on every sequencer at once
+        for (auto &replay : m_replays)
+            tryIssueParallelFetch(replay);
+        return;
+    }
+
     if (m_bytes_read < m_uncompressed_trace_size) {
         TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
                                                                 m_bytes_read);
+        issueFetchRequest(traceRecord, m_seq_map[traceRecord->m_cntrl_id]);
 
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
-
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            RequestPtr req;
-            MemCmd::Command requestType;
+        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        m_records_read++;
+    } else {
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+    }
+}
 
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                    Request::funcRequestorId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                        traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcRequestorId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                Request::funcRequestorId);
-            }
+void
+CacheRecorder::setupParallelFetch()
+{
+    uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    for (uint64_t offset = 0; offset < m_uncompressed_trace_size;
+         offset += record_size) {
+        const TraceRecord* rec =
+            (const TraceRecord*)(m_uncompressed_trace + offset);
+        uint64_t idx = m_fetch_records.size();
+        m_fetch_records.push_back(rec);
 
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
+        Sequencer* seq = m_seq_map[rec->m_cntrl_id];
+        assert(seq != NULL);
+        auto it = m_replay_index.find(seq);
+        if (it == m_replay_index.end()) {
+            it = m_replay_index.emplace(seq, m_replays.size()).first;
+            m_replays.push_back(SequencerReplay{seq, {}, 0});
+        }
+        m_replays[it->second].pending.push_back(idx);
+        m_block_order[rec->m_data_address].push_back(idx);
 
-            Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
-            assert(m_sequencer_ptr != NULL);
-            m_sequencer_ptr->makeRequest(pkt);
+        bool writable = rec->m_type == RubyRequestType_ST;
+        auto &expected = m_expected_data[rec->m_data_address];
+        if (writable || !expected.writable) {
+            expected.writable = writable;
+            expected.data.assign(rec->m_data,
+                                 rec->m_data + m_block_size_bytes);
         }
+    }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
-        m_records_read++;
-    } else {
+    DPRINTF(RubyCacheTrace, "Replaying %d records on %d sequencers\n",
+            m_fetch_records.size(), m_replays.size());
+}
+
+void
+CacheRecorder::tryIssueParallelFetch(SequencerReplay& replay)
+{
+    if (replay.outstanding > 0 || replay.pending.empty())
+        return;
+
+    // Only replay a record once every earlier record for the same block,
+    // possibly on another sequencer, has completed.
+    uint64_t idx = replay.pending.front();
+    const TraceRecord* rec = m_fetch_records[idx];
+    if (m_block_order[rec->m_data_address].front() != idx)
+        return;
+
+    replay.outstanding = issueFetchRequest(rec, replay.seq);
+}
+
+void
+CacheRecorder::completeFetchRequest(Sequencer* seq)
+{
+    if (!m_parallel_warmup) {
+        enqueueNextFetchRequest();
+        return;
+    }
+
+    auto it = m_replay_index.find(seq);
+    panic_if(it == m_replay_index.end(),
+             "Warmup response on a sequencer without warmup requests");
+    SequencerReplay& replay = m_replays[it->second];
+    assert(replay.outstanding > 0);
+    if (--replay.outstanding > 0)
+        return;
+
+    uint64_t idx = replay.pending.front();
+    Addr block = m_fetch_records[idx]->m_data_address;
+    auto &order = m_block_order[block];
+    panic_if(order.front() != idx, "Warmup record %d for %#x completed "
+             "out of trace order", idx, block);
+    order.pop_front();
+    if (order.empty())
+        m_block_order.erase(block);
+    replay.pending.pop_front();
+    m_records_read++;
+
+    // Completing a record may unblock the head of any other sequencer
+    for (auto &other : m_replays)
+        tryIssueParallelFetch(other);
+
+    if (m_records_read == m_fetch_records.size()) {
         DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
     }
 }
 
+bool
+CacheRecorder::fetchComplete() const
+{
+    if (m_parallel_warmup)
+        return m_records_read == m_fetch_records.size();
+    return m_bytes_read >= m_uncompressed_trace_size;
+}
+
+void
+CacheRecorder::checkFetchedState(RubySystem* rs)
+{
+    assert(m_parallel_warmup && fetchComplete());
+    panic_if(!m_block_order.empty(), "%d blocks still have warmup records "
+             "pending after the warmup completed", m_block_order.size());
+
+    uint64_t line_size = RubySystem::getBlockSizeBytes();
+    std::vector<uint8_t> data(line_size);
+    for (const auto &expected : m_expected_data) {
+        for (uint64_t offset = 0; offset < m_block_size_bytes;
+             offset += line_size) {
+            Addr addr = expected.first + offset;
+            auto req = std::make_shared<Request>(addr, line_size, 0,
+                                                 Request::funcRequestorId);
+            Packet pkt(req, MemCmd::ReadReq);
+            pkt.dataStatic(data.data());
+
+            panic_if(!rs->functionalRead(&pkt), "Block %#x has no readable "
+                     "copy after the cache warmup", addr);
+            panic_if(memcmp(data.data(), expected.second.data.data() + offset,
+                            line_size) != 0,
+                     "Block %#x does not hold the recorded data after the "
+                     "cache warmup", addr);
+        }
+    }
+
+    DPRINTF(RubyCacheTrace, "Checked %d blocks after the warmup\n",
+            m_expected_data.size());
+}
+
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
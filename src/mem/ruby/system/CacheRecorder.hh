@@ -35,6 +35,8 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <deque>
+#include <unordered_map>
 #include <vector>
 
 #include "base/types.hh"
@@ -43,6 +45,7 @@
 #include "mem/ruby/common/TypeDefines.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 
+class RubySystem;
 class Sequencer;
 
 /*!
@@ -72,7 +75,8 @@ class CacheRecorder
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
                   std::vector<Sequencer*>& SequencerMap,
-                  uint64_t block_size_bytes);
+                  uint64_t block_size_bytes,
+                  bool parallel_warmup = false);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
@@ -94,14 +98,62 @@ class CacheRecorder
      * checkpoint and issues fetch requests. Except for the first one, a
      * fetch request is issued only after the previous one has completed.
      * It should be possible to use this with any protocol.
+     *
+     * With parallel warmup, the first call instead issues one record on
+     * every sequencer and the replay then proceeds through
+     * completeFetchRequest().
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Called by a sequencer when one of the warmup requests it was
+     * given has completed.
+     */
+    void completeFetchRequest(Sequencer* seq);
+
+    /*!
+     * Returns true once every record of the trace has been replayed.
+     */
+    bool fetchComplete() const;
+
+    /*!
+     * Check the state left by a parallel warmup. Every block of the
+     * trace must be readable through a functional access and hold the
+     * data that was recorded for it, i.e., no controller may have been
+     * left in a transient state and no record may have been lost or
+     * replayed out of order.
+     */
+    void checkFetchedState(RubySystem* rs);
+
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    /*!
+     * Issue the fetch request(s) needed to bring a record back into the
+     * caches through the given sequencer. Returns the number of packets
+     * that were sent, which is more than one when the trace was recorded
+     * with a larger block size.
+     */
+    int issueFetchRequest(const TraceRecord* rec, Sequencer* seq);
+
+    /*!
+     * Per sequencer replay state for parallel warmup. Each sequencer has
+     * at most one record in flight.
+     */
+    struct SequencerReplay
+    {
+        Sequencer* seq;
+        // Indices (in trace order) of the records left to replay
+        std::deque<uint64_t> pending;
+        // Packets of the head record that have not completed yet
+        int outstanding;
+    };
+
+    void setupParallelFetch();
+    void tryIssueParallelFetch(SequencerReplay& replay);
+
     std::vector<TraceRecord*> m_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
@@ -110,6 +162,39 @@ class CacheRecorder
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
+
+    /*!
+     * Parallel warmup replays the records of different sequencers
+     * concurrently. Records touching the same block are still replayed
+     * one at a time and in trace order, so each block ends up with the
+     * data and coherence permissions the trace recorded for it.
+     *
+     * The order between records of different blocks is not kept. Caches
+     * shared by several sequencers therefore see their fills in another
+     * order than in a sequential replay. Their replacement state differs,
+     * and when a set overflows they can evict other victims. The warmed
+     * up hierarchy is thus not the one a sequential replay would build,
+     * and statistics of the restored run can differ slightly.
+     */
+    bool m_parallel_warmup;
+    std::vector<const TraceRecord*> m_fetch_records;
+    std::vector<SequencerReplay> m_replays;
+    std::unordered_map<Sequencer*, int> m_replay_index;
+    std::unordered_map<Addr, std::deque<uint64_t>> m_block_order;
+
+    /*!
+     * Data every block is expected to hold after the replay. This is
+     * taken from the last record of the block, preferring records of
+     * writable copies, which are authoritative. Read requests return
+     * their data into the trace buffer, so it is copied out before the
+     * replay starts.
+     */
+    struct ExpectedBlock
+    {
+        bool writable;
+        std::vector<uint8_t> data;
+    };
+    std::unordered_map<Addr, ExpectedBlock> m_expected_data;
 };
 
 inline bool
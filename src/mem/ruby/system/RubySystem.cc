@@ -73,7 +73,7 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params *p)
     : ClockedObject(p), m_access_backing_store(p->access_backing_store),
-      m_cache_recorder(NULL)
+      m_parallel_warmup(p->parallel_warmup), m_cache_recorder(NULL)
 {
     m_randomization = p->randomization;
 
@@ -197,7 +197,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         sequencer_map, block_size_bytes);
+                                         sequencer_map, block_size_bytes,
+                                         m_parallel_warmup);
 }
 
 void
@@ -437,6 +438,12 @@ RubySystem::startup()
         enqueueRubyEvent(curTick());
         simulate();
 
+        panic_if(!m_cache_recorder->fetchComplete(),
+                 "Ruby cache warmup stopped before the whole cache trace "
+                 "was replayed");
+        if (m_parallel_warmup && !m_access_backing_store)
+            m_cache_recorder->checkFetchedState(this);
+
         delete m_cache_recorder;
         m_cache_recorder = NULL;
         m_systems_to_warmup--;
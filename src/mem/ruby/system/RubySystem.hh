@@ -135,6 +135,7 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_parallel_warmup;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
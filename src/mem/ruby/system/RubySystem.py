@@ -47,6 +47,13 @@ class RubySystem(ClockedObject):
     access_backing_store = Param.Bool(False, "Use phys_mem as the functional \
         store and only use ruby for timing.")
 
+    parallel_warmup = Param.Bool(False, "When restoring from a checkpoint, \
+        replay the recorded cache contents on all sequencers concurrently \
+        instead of one request at a time, and check that every recorded \
+        block reads back its recorded data afterwards. Shared caches are \
+        filled in another order, so their replacement state and victims \
+        can differ from a sequential warmup.")
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
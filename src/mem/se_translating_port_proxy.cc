@@ -40,6 +40,12 @@
 
 #include "mem/se_translating_port_proxy.hh"
 
+#include <cstring>
+
+#include "base/chunk_generator.hh"
+#include "cpu/thread_context.hh"
+#include "mem/page_table.hh"
+#include "mem/physical.hh"
 #include "sim/process.hh"
 #include "sim/system.hh"
 
@@ -64,3 +70,94 @@ SETranslatingPortProxy::fixupAddr(Addr addr, BaseTLB::Mode mode) const
     }
     return false;
 }
+
+uint8_t *
+SETranslatingPortProxy::hostAddr(Addr addr) const
+{
+    System *system = _tc->getSystemPtr();
+    if (!system->bypassCaches())
+        return nullptr;
+
+    // Generations are unique across page tables, so this also catches a
+    // switch to another table.
+    EmulationPageTable *p_table = _tc->getProcessPtr()->pTable;
+    if (p_table->generation() != hostPagesGeneration) {
+        hostPages.fill(HostPage());
+        hostPagesGeneration = p_table->generation();
+    }
+
+    const Addr vaddr = roundDown(addr, pageBytes);
+    HostPage &page = hostPages[(vaddr / pageBytes) % NumHostPages];
+    if (!page.host || page.vaddr != vaddr) {
+        const auto *pte = p_table->lookup(vaddr);
+        if (!pte)
+            return nullptr;
+
+        const Addr paddr = pte->paddr + p_table->pageOffset(vaddr);
+        uint8_t *host = nullptr;
+        for (const auto &store : system->getPhysMem().getBackingStore()) {
+            if (store.pmem && !store.range.interleaved() &&
+                    store.range.contains(paddr) &&
+                    store.range.end() - paddr >= pageBytes) {
+                host = store.pmem + (paddr - store.range.start());
+                break;
+            }
+        }
+        if (!host)
+            return nullptr;
+
+        page.vaddr = vaddr;
+        page.host = host;
+    }
+    return page.host + (addr - vaddr);
+}
+
+bool
+SETranslatingPortProxy::tryReadBlob(Addr addr, void *p, int size) const
+{
+    for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
+         gen.next())
+    {
+        if (uint8_t *host = hostAddr(gen.addr())) {
+            std::memcpy(p, host, gen.size());
+        } else if (!TranslatingPortProxy::tryReadBlob(
+                    gen.addr(), p, gen.size())) {
+            return false;
+        }
+        p = static_cast<uint8_t *>(p) + gen.size();
+    }
+    return true;
+}
+
+bool
+SETranslatingPortProxy::tryWriteBlob(Addr addr, const void *p, int size) const
+{
+    for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
+         gen.next())
+    {
+        if (uint8_t *host = hostAddr(gen.addr())) {
+            std::memcpy(host, p, gen.size());
+        } else if (!TranslatingPortProxy::tryWriteBlob(
+                    gen.addr(), p, gen.size())) {
+            return false;
+        }
+        p = static_cast<const uint8_t *>(p) + gen.size();
+    }
+    return true;
+}
+
+bool
+SETranslatingPortProxy::tryMemsetBlob(Addr addr, uint8_t v, int size) const
+{
+    for (ChunkGenerator gen(addr, size, pageBytes); !gen.done();
+         gen.next())
+    {
+        if (uint8_t *host = hostAddr(gen.addr())) {
+            std::memset(host, v, gen.size());
+        } else if (!TranslatingPortProxy::tryMemsetBlob(
+                    gen.addr(), v, gen.size())) {
+            return false;
+        }
+    }
+    return true;
+}
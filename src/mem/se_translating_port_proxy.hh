@@ -41,6 +41,8 @@
 #ifndef __MEM_SE_TRANSLATING_PORT_PROXY_HH__
 #define __MEM_SE_TRANSLATING_PORT_PROXY_HH__
 
+#include <array>
+
 #include "mem/translating_port_proxy.hh"
 
 class SETranslatingPortProxy : public TranslatingPortProxy
@@ -56,12 +58,40 @@ class SETranslatingPortProxy : public TranslatingPortProxy
   private:
     AllocType allocating;
 
+    /**
+     * A direct mapped cache of the host memory backing the pages accessed
+     * last, which lets accesses to them skip translation and the memory
+     * system. Memory is only accessed directly when the system bypasses
+     * the caches, as it could otherwise be stale, and the cache is dropped
+     * whenever a mapping of the page table changes. This only serves
+     * accesses through the proxy, such as system calls; TLB misses still
+     * look pages up in the page table.
+     */
+    struct HostPage
+    {
+        Addr vaddr = 0;
+        uint8_t *host = nullptr;
+    };
+
+    static const unsigned NumHostPages = 64;
+
+    mutable std::array<HostPage, NumHostPages> hostPages;
+    // The generation of the page table the pages were cached from.
+    mutable uint64_t hostPagesGeneration = 0;
+
+    /** The host address of addr, or nullptr if it needs translating. */
+    uint8_t *hostAddr(Addr addr) const;
+
   protected:
     bool fixupAddr(Addr addr, BaseTLB::Mode mode) const override;
 
   public:
     SETranslatingPortProxy(ThreadContext *tc, AllocType alloc=NextPage,
                            Request::Flags _flags=0);
+
+    bool tryReadBlob(Addr addr, void *p, int size) const override;
+    bool tryWriteBlob(Addr addr, const void *p, int size) const override;
+    bool tryMemsetBlob(Addr addr, uint8_t v, int size) const override;
 };
 
 #endif // __MEM_SE_TRANSLATING_PORT_PROXY_HH__
@@ -71,6 +71,8 @@ def main(args=None):
                       help="Print files that SLICC will generate")
     parser.add_option("--tb", "--traceback", action='store_true',
                       help="print traceback on error")
+    parser.add_option("-T", "--table-transitions", action='store_true',
+                      help="generate table-driven transition code")
     parser.add_option("-q", "--quiet",
                       help="don't print messages")
     opts,files = parser.parse_args(args=args)
@@ -93,7 +95,8 @@ def main(args=None):
     protocol_base = os.path.join(os.path.dirname(__file__),
                                  '..', 'ruby', 'protocol')
     slicc = SLICC(slicc_file, protocol_base, verbose=True, debug=opts.debug,
-                  traceback=opts.tb)
+                  traceback=opts.tb,
+                  table_transitions=opts.table_transitions)
 
 
     if opts.print_files:
@@ -37,10 +37,12 @@ import slicc.util as util
 from slicc.symbols import SymbolTable
 
 class SLICC(Grammar):
-    def __init__(self, filename, base_dir, verbose=False, traceback=False, **kwargs):
+    def __init__(self, filename, base_dir, verbose=False, traceback=False,
+                 table_transitions=False, **kwargs):
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
+        self.table_transitions = table_transitions
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
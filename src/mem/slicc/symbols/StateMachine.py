@@ -226,7 +226,7 @@ class StateMachine(Symbol):
         self.printControllerPython(path)
         self.printControllerHH(path)
         self.printControllerCC(path, includes)
-        self.printCSwitch(path)
+        self.printCSwitch(path, includes)
         self.printCWakeup(path, includes)
 
     def printControllerPython(self, path):
@@ -452,12 +452,10 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
         code('#endif // __${ident}_CONTROLLER_H__')
         code.write(path, '%s.hh' % c_ident)
 
-    def printControllerCC(self, path, includes):
-        '''Output the actions for performing the actions'''
+    def printControllerIncludes(self, code, includes):
+        '''Output the includes needed by the controller actions'''
 
-        code = self.symtab.codeFormatter()
         ident = self.ident
-        c_ident = "%s_Controller" % self.ident
 
         # Unfortunately, clang compilers will throw a "call to function ...
         # that is neither visible in the template definition nor found by
@@ -485,12 +483,6 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 '''
 
         code('''
-/** \\file $c_ident.cc
- *
- * Auto generated C++ code started by $__file__:$__line__
- * Created by slicc definition of Module "${{self.short}}"
- */
-
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -530,6 +522,24 @@ using namespace std;
                 code('#include "mem/ruby/protocol/${{var.type.c_ident}}.hh"')
             seen_types.add(var.type.ident)
 
+    def printControllerCC(self, path, includes):
+        '''Output the actions for performing the actions'''
+
+        code = self.symtab.codeFormatter()
+        ident = self.ident
+        c_ident = "%s_Controller" % self.ident
+
+        code('''
+/** \\file $c_ident.cc
+ *
+ * Auto generated C++ code started by $__file__:$__line__
+ * Created by slicc definition of Module "${{self.short}}"
+ */
+
+''')
+
+        self.printControllerIncludes(code, includes)
+
         num_in_ports = len(self.in_ports)
 
         code('''
@@ -1017,6 +1027,70 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
 
 // Actions
 ''')
+        # With table driven transitions the actions are emitted next to
+        # doTransitionWorker() so that they can be inlined.
+        if not self.symtab.slicc.table_transitions:
+            self.printActions(code)
+
+        for func in self.functions:
+            code(func.generateCode())
+
+        # Function for functional writes to messages buffered in the controller
+        code('''
+int
+$c_ident::functionalWriteBuffers(PacketPtr& pkt)
+{
+    int num_functional_writes = 0;
+''')
+        for var in self.objects:
+            vtype = var.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('num_functional_writes += $vid->functionalWrite(pkt);')
+
+        for var in self.config_parameters:
+            vtype = var.type_ast.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('num_functional_writes += $vid->functionalWrite(pkt);')
+
+        code('''
+    return num_functional_writes;
+}
+''')
+
+        # Function for functional reads to messages buffered in the controller
+        code('''
+bool
+$c_ident::functionalReadBuffers(PacketPtr& pkt)
+{
+''')
+        for var in self.objects:
+            vtype = var.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('if ($vid->functionalRead(pkt)) return true;')
+
+        for var in self.config_parameters:
+            vtype = var.type_ast.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('if ($vid->functionalRead(pkt)) return true;')
+
+        code('''
+    return false;
+}
+''')
+
+        code.write(path, "%s.cc" % c_ident)
+
+    def printActions(self, code, inline=False):
+        '''Output the definitions of the actions'''
+
+        ident = self.ident
+        c_ident = "%s_Controller" % self.ident
+        inline = "inline " if inline else ""
+
         if self.TBEType != None and self.EntryType != None:
             for action in self.actions.values():
                 if "c_code" not in action:
@@ -1024,7 +1098,7 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
 
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, ${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1045,7 +1119,7 @@ $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, ${{self.Entry
 
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1060,7 +1134,7 @@ $c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, Addr addr)
 
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1075,7 +1149,7 @@ $c_ident::${{action.ident}}(${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Add
 
                 code('''
 /** \\brief ${{action.desc}} */
-void
+${inline}void
 $c_ident::${{action.ident}}(Addr addr)
 {
     DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
@@ -1083,57 +1157,6 @@ $c_ident::${{action.ident}}(Addr addr)
 }
 
 ''')
-        for func in self.functions:
-            code(func.generateCode())
-
-        # Function for functional writes to messages buffered in the controller
-        code('''
-int
-$c_ident::functionalWriteBuffers(PacketPtr& pkt)
-{
-    int num_functional_writes = 0;
-''')
-        for var in self.objects:
-            vtype = var.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('num_functional_writes += $vid->functionalWrite(pkt);')
-
-        for var in self.config_parameters:
-            vtype = var.type_ast.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('num_functional_writes += $vid->functionalWrite(pkt);')
-
-        code('''
-    return num_functional_writes;
-}
-''')
-
-        # Function for functional reads to messages buffered in the controller
-        code('''
-bool
-$c_ident::functionalReadBuffers(PacketPtr& pkt)
-{
-''')
-        for var in self.objects:
-            vtype = var.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('if ($vid->functionalRead(pkt)) return true;')
-
-        for var in self.config_parameters:
-            vtype = var.type_ast.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('if ($vid->functionalRead(pkt)) return true;')
-
-        code('''
-    return false;
-}
-''')
-
-        code.write(path, "%s.cc" % c_ident)
 
     def printCWakeup(self, path, includes):
         '''Output the wakeup loop for the events'''
@@ -1264,7 +1287,7 @@ ${ident}_Controller::wakeup()
 
         code.write(path, "%s_Wakeup.cc" % self.ident)
 
-    def printCSwitch(self, path):
+    def printCSwitch(self, path, includes):
         '''Output switch statement for transition table'''
 
         code = self.symtab.codeFormatter()
@@ -1286,10 +1309,32 @@ ${ident}_Controller::wakeup()
 #include "mem/ruby/protocol/Types.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
+''')
+        if self.symtab.slicc.table_transitions:
+            self.printControllerIncludes(code, includes)
+
+        code('''
 #define HASH_FUN(state, event)  ((int(state)*${ident}_Event_NUM)+int(event))
 
 #define GET_TRANSITION_COMMENT() (${ident}_transitionComment.str())
 #define CLEAR_TRANSITION_COMMENT() (${ident}_transitionComment.str(""))
+''')
+
+        if self.symtab.slicc.table_transitions:
+            # Define the actions in this file, so that they are inlined
+            # into the code blocks of doTransitionWorker().
+            code('''
+#ifndef NDEBUG
+#define APPEND_TRANSITION_COMMENT(str) (${ident}_transitionComment << str)
+#else
+#define APPEND_TRANSITION_COMMENT(str) do {} while (0)
+#endif
+
+// Actions
+''')
+            self.printActions(code, inline=True)
+
+        code('''
 
 TransitionResult
 ${ident}_Controller::doTransition(${ident}_Event event,
@@ -1407,88 +1452,109 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
         code('''
                                         Addr addr)
 {
-    switch(HASH_FUN(state, event)) {
 ''')
+        if self.symtab.slicc.table_transitions:
+            self.printTransitionTable(code)
+        else:
+            self.printTransitionSwitch(code)
+        code('''
+}
+''')
+        code.write(path, "%s_Transitions.cc" % self.ident)
 
-        # This map will allow suppress generating duplicate code
-        cases = OrderedDict()
 
-        for trans in self.transitions:
-            case_string = "%s_State_%s, %s_Event_%s" % \
-                (self.ident, trans.state.ident, self.ident, trans.event.ident)
+    def transitionCode(self, trans, set_next_state=True):
+        '''Generate the body of the code executed for a transition'''
 
-            case = self.symtab.codeFormatter()
-            # Only set next_state if it changes
-            if trans.state != trans.nextState:
-                if trans.nextState.isWildcard():
-                    # When * is encountered as an end state of a transition,
-                    # the next state is determined by calling the
-                    # machine-specific getNextState function. The next state
-                    # is determined before any actions of the transition
-                    # execute, and therefore the next state calculation cannot
-                    # depend on any of the transitionactions.
-                    case('next_state = getNextState(addr);')
-                else:
-                    ns_ident = trans.nextState.ident
-                    case('next_state = ${ident}_State_${ns_ident};')
+        ident = self.ident
+        case = self.symtab.codeFormatter()
+        # Only set next_state if it changes
+        if set_next_state and trans.state != trans.nextState:
+            if trans.nextState.isWildcard():
+                # When * is encountered as an end state of a transition,
+                # the next state is determined by calling the
+                # machine-specific getNextState function. The next state
+                # is determined before any actions of the transition
+                # execute, and therefore the next state calculation cannot
+                # depend on any of the transitionactions.
+                case('next_state = getNextState(addr);')
+            else:
+                ns_ident = trans.nextState.ident
+                case('next_state = ${ident}_State_${ns_ident};')
 
-            actions = trans.actions
-            request_types = trans.request_types
+        actions = trans.actions
+        request_types = trans.request_types
 
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key,val in res.items():
-                val = '''
+        # Check for resources
+        case_sorter = []
+        res = trans.resources
+        for key,val in res.items():
+            val = '''
 if (!%s.areNSlotsAvailable(%s, clockEdge()))
     return TransitionResult_ResourceStall;
 ''' % (key.code, val)
-                case_sorter.append(val)
+            case_sorter.append(val)
 
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = '''
+        # Check all of the request_types for resource constraints
+        for request_type in request_types:
+            val = '''
 if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
     return TransitionResult_ResourceStall;
 }
 ''' % (self.ident, request_type.ident)
-                case_sorter.append(val)
+            case_sorter.append(val)
+
+        # Emit the code sequences in a sorted order.  This makes the
+        # output deterministic (without this the output order can vary
+        # since Map's keys() on a vector of pointers is not deterministic
+        for c in sorted(case_sorter):
+            case("$c")
+
+        # Record access types for this transition
+        for request_type in request_types:
+            case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
+
+        # Figure out if we stall
+        stall = False
+        for action in actions:
+            if action.ident == "z_stall":
+                stall = True
+                break
+
+        if stall:
+            case('return TransitionResult_ProtocolStall;')
+        else:
+            if self.TBEType != None and self.EntryType != None:
+                for action in actions:
+                    case('${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);')
+            elif self.TBEType != None:
+                for action in actions:
+                    case('${{action.ident}}(m_tbe_ptr, addr);')
+            elif self.EntryType != None:
+                for action in actions:
+                    case('${{action.ident}}(m_cache_entry_ptr, addr);')
+            else:
+                for action in actions:
+                    case('${{action.ident}}(addr);')
+            case('return TransitionResult_Valid;')
 
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
+        return str(case)
 
-            # Record access types for this transition
-            for request_type in request_types:
-                case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
+    def printTransitionSwitch(self, code):
+        '''Output the transitions as a switch on (state, event)'''
 
-            # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
+        ident = self.ident
+        code.indent()
+        code('switch(HASH_FUN(state, event)) {')
 
-            if stall:
-                case('return TransitionResult_ProtocolStall;')
-            else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);')
-                elif self.TBEType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, addr);')
-                elif self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_cache_entry_ptr, addr);')
-                else:
-                    for action in actions:
-                        case('${{action.ident}}(addr);')
-                case('return TransitionResult_Valid;')
+        # This map will allow suppress generating duplicate code
+        cases = OrderedDict()
 
-            case = str(case)
+        for trans in self.transitions:
+            case_string = "%s_State_%s, %s_Event_%s" % \
+                (self.ident, trans.state.ident, self.ident, trans.event.ident)
+
+            case = self.transitionCode(trans)
 
             # Look to see if this transition code is unique.
             if case not in cases:
@@ -1506,17 +1572,114 @@ if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
             code('    $case\n')
 
         code('''
-      default:
-        panic("Invalid transition\\n"
-              "%s time: %d addr: %#x event: %s state: %s\\n",
-              name(), curCycle(), addr, event, state);
-    }
-
-    return TransitionResult_Valid;
+  default:
+    panic("Invalid transition\\n"
+          "%s time: %d addr: %#x event: %s state: %s\\n",
+          name(), curCycle(), addr, event, state);
 }
+
+return TransitionResult_Valid;
 ''')
-        code.write(path, "%s_Transitions.cc" % self.ident)
+        code.dedent()
 
+    def printTransitionTable(self, code):
+        '''Output the transitions as a constant table indexed by (state,
+        event) that selects the next state and one of the unique action
+        sequences. Since the next state lives in the table, transitions
+        that only differ in their next state share a single code block,
+        and the dispatch is a dense switch.'''
+
+        ident = self.ident
+
+        # Unique code blocks, numbered from 1. Block 0 is the invalid
+        # transition.
+        cases = OrderedDict()
+        table = {}
+        for trans in self.transitions:
+            case = self.transitionCode(trans, set_next_state=False)
+            if case not in cases:
+                cases[case] = len(cases) + 1
+            table[(trans.state.ident, trans.event.ident)] = \
+                (cases[case], trans.nextState)
+
+        code.indent()
+        code('''
+// Code block and next state for each (state, event) pair. A next state of
+// ${ident}_State_NUM means that it is computed by getNextState().
+static constexpr struct
+{
+    uint16_t block;
+    ${ident}_State nextState;
+} transitions[${ident}_State_NUM][${ident}_Event_NUM] = {
+''')
+        code.indent()
+        for state in self.states:
+            code('// ${ident}_State_${state}')
+            code('{')
+            code.indent()
+            for event in self.events:
+                block, next_state = table.get((state, event), (0, None))
+                if next_state is None:
+                    # Invalid transition, the state is never used
+                    next_state = state
+                elif next_state.isWildcard():
+                    next_state = "NUM"
+                else:
+                    next_state = next_state.ident
+                code('{ $block, ${ident}_State_${next_state} }, '
+                     '// ${ident}_Event_${event}')
+            code.dedent()
+            code('},')
+        code.dedent()
+        code('''
+};
+
+''')
+
+        # The table is indexed by the enum values, so check that its rows
+        # and columns are in enum order.
+        for i,state in enumerate(self.states):
+            code('static_assert(${ident}_State_${state} == $i, '
+                 '"Bad state order in the transition table");')
+        for i,event in enumerate(self.events):
+            code('static_assert(${ident}_Event_${event} == $i, '
+                 '"Bad event order in the transition table");')
+
+        code('''
+
+const auto &transition = transitions[state][event];
+''')
+
+        if any(t.nextState.isWildcard() for t in self.transitions):
+            code('''
+if (transition.nextState == ${ident}_State_NUM)
+    next_state = getNextState(addr);
+else
+    next_state = transition.nextState;
+''')
+        else:
+            code('''
+next_state = transition.nextState;
+''')
+
+        code('''
+
+switch (transition.block) {
+''')
+        for case,block in cases.items():
+            code('  case $block:')
+            code('    $case\n')
+
+        code('''
+  default:
+    panic("Invalid transition\\n"
+          "%s time: %d addr: %#x event: %s state: %s\\n",
+          name(), curCycle(), addr, event, state);
+}
+
+return TransitionResult_Valid;
+''')
+        code.dedent()
 
     # **************************
     # ******* HTML Files *******
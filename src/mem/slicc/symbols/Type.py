@@ -121,6 +121,9 @@ class Type(Symbol):
     @property
     def isInterface(self):
         return "interface" in self
+    @property
+    def isCacheEntry(self):
+        return self.get("interface") == "AbstractCacheEntry"
 
     # Return false on error
     def addDataMember(self, ident, type, pairs, init_code):
@@ -213,6 +216,9 @@ class Type(Symbol):
             code('#include "mem/ruby/protocol/$0.hh"', self["interface"])
             parent = " :  public %s" % self["interface"]
 
+        if self.isCacheEntry:
+            code('#include "mem/ruby/slicc_interface/CacheEntryPool.hh"')
+
         code('''
 $klass ${{self.c_ident}}$parent
 {
@@ -308,6 +314,23 @@ clone() const
 {
      return new ${{self.c_ident}}(*this);
 }
+''')
+
+        # Cache entries, and directory entries implementing the same
+        # interface, are packed into per-type slabs
+        if self.isCacheEntry:
+            code('''
+static void *
+operator new(size_t size)
+{
+    return CacheEntryPool<${{self.c_ident}}>::allocate(size);
+}
+
+static void
+operator delete(void *ptr, size_t size)
+{
+    CacheEntryPool<${{self.c_ident}}>::release(ptr, size);
+}
 ''')
 
         if not self.isGlobal:
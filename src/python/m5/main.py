@@ -118,6 +118,12 @@ def parse_options():
     option("--stats-help",
            action="callback", callback=_stats_help,
            help="Display documentation for available stat visitors")
+    option("--host-profile", action="store_true", default=False,
+        help="Profile the host time, cycles, instructions and cache misses "
+             "spent on each SimObject, reported in the hostProfile stats")
+    option("--eventq-profile", action="store_true", default=False,
+        help="Profile the events processed by the event queues, reported "
+             "in eventq_profile.txt and eventq_profile.folded")
 
     # Configuration Options
     group("Configuration Options")
@@ -146,6 +152,9 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-binary", action="store_true", default=False,
+        help="Write debug output to the debug file as binary records, to "
+        "be decoded by util/decode_debug_trace.py")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -419,7 +428,12 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_binary:
+        if options.debug_file in ("cout", "cerr"):
+            fatal("Binary debug output needs a --debug-file")
+        trace.binaryOutput(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         _check_tracing()
@@ -0,0 +1,239 @@
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Statistically sampled simulation.
+
+A Sampler runs a workload as a sequence of sampling units in the style of
+SMARTS. Each unit of `period` instructions is mostly simulated on a set of
+functional CPUs (e.g. AtomicSimpleCPU with caches, which keeps the caches
+and branch predictors warm), followed by a short detailed warmup and a
+measurement window on a set of detailed CPUs. The cycles per instruction
+of every measurement window are recorded and summarized as a mean with a
+confidence interval. Sampling can stop as soon as the confidence interval
+is narrow enough.
+
+Example:
+
+    from m5.sampling import Sampler
+
+    m5.instantiate()
+    sampler = Sampler(system, list(zip(system.cpu, system.detailed_cpu)),
+                      period=1000000, warmup=2000, measurement=1000,
+                      error_target=0.03)
+    exit_event = sampler.run()
+    print(sampler.results)
+"""
+
+from __future__ import print_function
+from __future__ import absolute_import
+
+import math
+
+from . import objects
+from . import stats
+from .simulate import simulate, switchCpus, curTick, MaxTick
+from .util import fatal
+
+def normalQuantile(confidence):
+    """Two-sided standard normal quantile for a confidence level."""
+    if not 0 < confidence < 1:
+        fatal("Confidence level %s not in (0, 1)", confidence)
+
+    lo, hi = 0.0, 10.0
+    for i in range(100):
+        mid = (lo + hi) / 2
+        if math.erf(mid / math.sqrt(2)) < confidence:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2
+
+class SampleStats(object):
+    """Cycles per instruction of a set of measurement windows."""
+
+    def __init__(self, confidence=0.95):
+        self.confidence = confidence
+        self.z = normalQuantile(confidence)
+        self.windows = []
+
+    def add(self, start_tick, insts, cycles):
+        self.windows.append((start_tick, insts, cycles))
+
+    def __len__(self):
+        return len(self.windows)
+
+    def samples(self):
+        return [ float(cycles) / insts
+                 for _, insts, cycles in self.windows if insts ]
+
+    def mean(self):
+        s = self.samples()
+        return sum(s) / len(s) if s else float('nan')
+
+    def stddev(self):
+        s = self.samples()
+        if len(s) < 2:
+            return float('nan')
+        mean = sum(s) / len(s)
+        return math.sqrt(sum((x - mean) ** 2 for x in s) / (len(s) - 1))
+
+    def halfWidth(self):
+        """Half width of the confidence interval of the mean."""
+        n = len(self.samples())
+        if n < 2:
+            return float('nan')
+        return self.z * self.stddev() / math.sqrt(n)
+
+    def relativeError(self):
+        """Confidence interval half width relative to the mean."""
+        mean = self.mean()
+        if not mean:
+            return float('nan')
+        return self.halfWidth() / mean
+
+    def __str__(self):
+        return "CPI %.4f +/- %.4f (%.2f%% at %g%% confidence, %d windows)" % \
+            (self.mean(), self.halfWidth(), 100 * self.relativeError(),
+             100 * self.confidence, len(self))
+
+def clockPeriod(cpu):
+    """Clock period of a CPU in ticks."""
+    domain = cpu.clk_domain
+    divider = 1
+    while isinstance(domain, objects.DerivedClockDomain):
+        divider *= int(domain.clk_divider)
+        domain = domain.clk_domain
+    return domain.clock[0].getValue() * divider
+
+class Sampler(object):
+    """Alternate functional warming and detailed measurement windows.
+
+    Arguments:
+      system -- Simulated system.
+      cpu_list -- (functional_cpu, detailed_cpu) tuples. The functional
+                  CPUs must be active when run() is called.
+      period -- Instructions per sampling unit.
+      warmup -- Detailed warmup instructions before each measurement.
+      measurement -- Instructions per measurement window.
+      confidence -- Confidence level of the reported interval.
+      error_target -- Stop once the interval's half width relative to the
+                      mean is at most this much. None to never stop early.
+      min_samples -- Measurement windows needed before stopping early.
+      max_samples -- Stop after this many measurement windows.
+      dump_stats -- Reset the statistics before and dump them after every
+                    measurement window.
+
+    Instruction counts refer to the first thread of the first CPU.
+    """
+
+    cause = "sampling window end"
+
+    def __init__(self, system, cpu_list, period, warmup, measurement,
+                 confidence=0.95, error_target=None, min_samples=30,
+                 max_samples=None, dump_stats=False, verbose=False):
+        if not cpu_list:
+            fatal("Sampling needs at least one pair of CPUs")
+        if period < warmup + measurement or measurement <= 0:
+            fatal("Sampling period (%d) must cover the detailed warmup (%d) "
+                  "and a non-empty measurement window (%d)",
+                  period, warmup, measurement)
+
+        self.system = system
+        self.functional = list(cpu_list)
+        self.detailed = [ (new, old) for old, new in cpu_list ]
+        self.period = period
+        self.warmup = warmup
+        self.measurement = measurement
+        self.error_target = error_target
+        self.min_samples = max(min_samples, 2)
+        self.max_samples = max_samples
+        self.dump_stats = dump_stats
+        self.verbose = verbose
+        self.results = SampleStats(confidence)
+
+    def _simulate(self, cpu, insts, max_tick):
+        """Run cpu for insts instructions. Returns the exit event and
+        whether the instruction count was reached."""
+        if insts <= 0:
+            return None, True
+        cpu.scheduleInstStop(0, insts, self.cause)
+        exit_event = simulate(max_tick - curTick())
+        return exit_event, exit_event.getCause() == self.cause
+
+    def done(self):
+        n = len(self.results)
+        if self.max_samples is not None and n >= self.max_samples:
+            return True
+        if self.error_target is None or n < self.min_samples:
+            return False
+        return self.results.relativeError() <= self.error_target
+
+    def run(self, max_tick=MaxTick):
+        """Sample until the workload exits, max_tick is reached or the
+        error target is met. Returns the last exit event."""
+        detailed_cpus = [ cpu for cpu, _ in self.detailed ]
+        period = clockPeriod(detailed_cpus[0])
+        functional_insts = self.period - self.warmup - self.measurement
+
+        while True:
+            exit_event, ok = self._simulate(self.functional[0][0],
+                                            functional_insts, max_tick)
+            if not ok:
+                return exit_event
+
+            switchCpus(self.system, self.functional, verbose=self.verbose)
+
+            exit_event, ok = self._simulate(detailed_cpus[0], self.warmup,
+                                            max_tick)
+            if not ok:
+                return exit_event
+
+            if self.dump_stats:
+                stats.reset()
+            start_tick = curTick()
+            start_insts = sum(cpu.totalInsts() for cpu in detailed_cpus)
+
+            exit_event, ok = self._simulate(detailed_cpus[0],
+                                            self.measurement, max_tick)
+            if not ok:
+                return exit_event
+
+            insts = sum(cpu.totalInsts() for cpu in detailed_cpus) - \
+                start_insts
+            cycles = (curTick() - start_tick) * len(detailed_cpus) // period
+            self.results.add(start_tick, insts, cycles)
+            if self.dump_stats:
+                stats.dump()
+            if self.verbose:
+                print("Sample %d @ tick %d: %s" %
+                      (len(self.results), start_tick, self.results))
+
+            switchCpus(self.system, self.detailed, verbose=self.verbose)
+
+            if self.done():
+                return exit_event
+
+__all__ = [ 'Sampler', 'SampleStats' ]
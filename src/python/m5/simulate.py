@@ -79,6 +79,11 @@ def instantiate(ckpt_dir=None):
     if not root:
         fatal("Need to instantiate Root() before calling instantiate()")
 
+    if options.host_profile:
+        root.host_profile = True
+    if options.eventq_profile:
+        root.eventq_profile = True
+
     # we need to fix the global frequency
     ticks.fixGlobalFrequency()
 
@@ -45,6 +45,7 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_trace.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
@@ -67,6 +68,14 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename)
+{
+    OutputStream *file_stream = simout.findOrCreate(filename, true);
+
+    Trace::setDebugLogger(new Trace::BinaryLogger(*file_stream->stream()));
+}
+
 static void
 ignore(const char *expr)
 {
@@ -119,6 +128,7 @@ pybind_init_debug(py::module &m_native)
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
@@ -73,3 +73,11 @@ class Root(SimObject):
     time_sync_period = Param.Clock("100ms", "how often to sync with real time")
     time_sync_spin_threshold = \
             Param.Clock("100us", "when less than this much time is left, spin")
+
+    # Profiles of the simulator itself, both slow the simulation down.
+    # See sim/host_profile.hh and sim/eventq_profile.hh.
+    host_profile = Param.Bool(False, "whether the host time, cycles, "
+        "instructions and cache misses spent on the events of each "
+        "SimObject are profiled")
+    eventq_profile = Param.Bool(False, "whether the events processed by "
+        "the event queues are profiled")
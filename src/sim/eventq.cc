@@ -41,6 +41,8 @@
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
 #include "sim/core.hh"
+#include "sim/eventq_profile.hh"
+#include "sim/host_profile.hh"
 
 using namespace std;
 
@@ -56,6 +58,7 @@ uint32_t numMainEventQueues = 0;
 vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+EventQueueProfile *eventqProfile = nullptr;
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -219,7 +222,12 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (DTRACE(Event))
             event->trace("executed");
-        event->process();
+        if (eventqProfile)
+            eventqProfile->process(event);
+        else if (HostProfile::active)
+            HostProfile::active->process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -227,6 +235,8 @@ EventQueue::serviceOne()
         }
     } else {
         event->flags.clear(Event::Squashed);
+        if (eventqProfile)
+            eventqProfile->squashed(event);
     }
 
     event->release();
@@ -431,6 +441,24 @@ EventQueue::asyncInsert(Event *event)
     async_queue_mutex.unlock();
 }
 
+void
+EventQueue::profileScheduled(Event *event, Tick when)
+{
+    eventqProfile->scheduled(event, when - getCurTick());
+}
+
+void
+EventQueue::profileRescheduled(Event *event, Tick when, bool was_scheduled)
+{
+    eventqProfile->rescheduled(event, when - getCurTick(), was_scheduled);
+}
+
+void
+EventQueue::profileDescheduled(Event *event)
+{
+    eventqProfile->descheduled(event);
+}
+
 void
 EventQueue::handleAsyncInsertions()
 {
@@ -51,6 +51,7 @@
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
+class EventQueueProfile;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -74,6 +75,10 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Profile the event queues report to, if they are profiled. See
+//! sim/eventq_profile.hh.
+extern EventQueueProfile *eventqProfile;
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -659,6 +664,12 @@ class EventQueue
     //! owning thread, should call this function instead of insert().
     void asyncInsert(Event *event);
 
+    //! Report to the event queue profile, only called while the
+    //! queues are profiled.
+    void profileScheduled(Event *event, Tick when);
+    void profileRescheduled(Event *event, Tick when, bool was_scheduled);
+    void profileDescheduled(Event *event);
+
     EventQueue(const EventQueue &);
 
   public:
@@ -777,6 +788,9 @@ class EventQueue
         event->flags.set(Event::Scheduled);
         event->acquire();
 
+        if (eventqProfile)
+            profileScheduled(event, when);
+
         if (DTRACE(Event))
             event->trace("scheduled");
     }
@@ -801,6 +815,9 @@ class EventQueue
         if (DTRACE(Event))
             event->trace("descheduled");
 
+        if (eventqProfile)
+            profileDescheduled(event);
+
         event->release();
     }
 
@@ -818,7 +835,8 @@ class EventQueue
         assert(event->initialized());
         assert(!inParallelMode || this == curEventQueue());
 
-        if (event->scheduled()) {
+        const bool was_scheduled = event->scheduled();
+        if (was_scheduled) {
             remove(event);
         } else {
             event->acquire();
@@ -829,6 +847,9 @@ class EventQueue
         event->flags.clear(Event::Squashed);
         event->flags.set(Event::Scheduled);
 
+        if (eventqProfile)
+            profileRescheduled(event, when, was_scheduled);
+
         if (DTRACE(Event))
             event->trace("rescheduled");
     }
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/eventq_profile.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+#include "sim/host_profile.hh"
+
+namespace {
+
+uint64_t
+hostNsecs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+/** Name the profile counts an event under */
+std::string
+eventKey(const Event *event)
+{
+    std::string name = event->name();
+    if (name.find('.') == std::string::npos)
+        return event->description();
+    return name;
+}
+
+/** Exclusive upper bound of a histogram bucket */
+uint64_t
+bucketLimit(int bucket)
+{
+    return bucket < 64 ? (1ULL << bucket) : ~0ULL;
+}
+
+} // anonymous namespace
+
+void
+EventQueueProfile::Histogram::sample(uint64_t value)
+{
+    ++buckets[value ? floorLog2(value) + 1 : 0];
+}
+
+uint64_t
+EventQueueProfile::Histogram::percentile(double fraction) const
+{
+    uint64_t total = 0;
+    for (auto count : buckets)
+        total += count;
+    if (!total)
+        return 0;
+
+    const uint64_t target = std::max<uint64_t>(1, fraction * total);
+    uint64_t seen = 0;
+    for (int i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= target)
+            return bucketLimit(i);
+    }
+    return bucketLimit(buckets.size() - 1);
+}
+
+void
+EventQueueProfile::Histogram::print(std::ostream &os, const char *unit) const
+{
+    for (int i = 0; i < buckets.size(); ++i) {
+        if (!buckets[i])
+            continue;
+        const uint64_t low = i ? (1ULL << (i - 1)) : 0;
+        ccprintf(os, "    %s [%d, %d): %d\n", unit, low, bucketLimit(i),
+                 buckets[i]);
+    }
+}
+
+EventQueueProfile::EventQueueProfile()
+{
+    fatal_if(eventqProfile, "Only one event queue profile can be active.\n");
+    eventqProfile = this;
+
+    registerExitCallback([this]() { dump(); });
+}
+
+EventQueueProfile::~EventQueueProfile()
+{
+    eventqProfile = nullptr;
+}
+
+EventQueueProfile::Entry &
+EventQueueProfile::entry(const Event *event)
+{
+    const std::string name = eventKey(event);
+
+    auto it = entries.find(name);
+    if (it == entries.end()) {
+        it = entries.emplace(name, Entry()).first;
+        it->second.name = name;
+    }
+    return it->second;
+}
+
+void
+EventQueueProfile::scheduled(const Event *event, Tick distance)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    pending[event] = std::make_pair(&entry(event), distance);
+}
+
+void
+EventQueueProfile::rescheduled(const Event *event, Tick distance,
+                               bool was_scheduled)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto &p = pending[event];
+    if (!p.first)
+        p.first = &entry(event);
+    p.second = distance;
+    if (was_scheduled)
+        ++p.first->reschedules;
+}
+
+void
+EventQueueProfile::descheduled(const Event *event)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = pending.find(event);
+    if (it != pending.end()) {
+        ++it->second.first->deschedules;
+        pending.erase(it);
+    } else {
+        ++entry(event).deschedules;
+    }
+}
+
+void
+EventQueueProfile::squashed(const Event *event)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = pending.find(event);
+    if (it != pending.end()) {
+        ++it->second.first->squashes;
+        pending.erase(it);
+    } else {
+        ++entry(event).squashes;
+    }
+}
+
+void
+EventQueueProfile::process(Event *event)
+{
+    Entry *e = nullptr;
+    Tick distance = 0;
+    bool known_distance = false;
+    {
+        // The event is likely to schedule itself again while it is
+        // processed, so take it off the pending ones first.
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = pending.find(event);
+        if (it != pending.end()) {
+            e = it->second.first;
+            distance = it->second.second;
+            known_distance = true;
+            pending.erase(it);
+        } else {
+            // Scheduled before profiling started
+            e = &entry(event);
+        }
+    }
+
+    const uint64_t start = hostNsecs();
+    if (HostProfile::active)
+        HostProfile::active->process(event);
+    else
+        event->process();
+    const uint64_t nsecs = hostNsecs() - start;
+
+    std::lock_guard<std::mutex> guard(lock);
+    ++e->processed;
+    e->hostNsecs += nsecs;
+    e->hostTime.sample(nsecs);
+    if (known_distance) {
+        ++e->distances;
+        e->totalDistance += distance;
+        e->distance.sample(distance);
+    }
+}
+
+void
+EventQueueProfile::dumpReport(std::ostream &os)
+{
+    std::vector<const Entry *> sorted;
+    uint64_t total_nsecs = 0;
+    uint64_t total_processed = 0;
+    for (const auto &e : entries) {
+        sorted.push_back(&e.second);
+        total_nsecs += e.second.hostNsecs;
+        total_processed += e.second.processed;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Entry *a, const Entry *b) {
+                  return a->hostNsecs > b->hostNsecs ||
+                      (a->hostNsecs == b->hostNsecs && a->name < b->name);
+              });
+
+    ccprintf(os, "%d events processed in %.3f s of host time\n\n",
+             total_processed, total_nsecs / 1e9);
+    ccprintf(os, "%7s %12s %12s %10s %10s %10s %12s %10s %10s %10s  %s\n",
+             "host%", "processed", "host ms", "mean ns", "p50 ns",
+             "p99 ns", "mean dist", "resched", "desched", "squashed",
+             "event");
+    for (const auto *e : sorted) {
+        ccprintf(os,
+                 "%7.2f %12d %12.3f %10d %10d %10d %12d %10d %10d %10d  %s\n",
+                 total_nsecs ? 100.0 * e->hostNsecs / total_nsecs : 0.0,
+                 e->processed, e->hostNsecs / 1e6,
+                 e->processed ? e->hostNsecs / e->processed : 0,
+                 e->hostTime.percentile(0.5), e->hostTime.percentile(0.99),
+                 e->distances ? e->totalDistance / e->distances : 0,
+                 e->reschedules, e->deschedules, e->squashes, e->name);
+    }
+
+    ccprintf(os, "\nHistograms, the p50 and p99 columns above are the "
+             "limits of their buckets\n");
+    for (const auto *e : sorted) {
+        if (!e->processed)
+            continue;
+        ccprintf(os, "\n%s\n", e->name);
+        e->hostTime.print(os, "host ns");
+        e->distance.print(os, "ticks  ");
+    }
+}
+
+void
+EventQueueProfile::dumpFolded(std::ostream &os)
+{
+    for (const auto &e : entries) {
+        if (!e.second.hostNsecs)
+            continue;
+        std::string stack = e.second.name;
+        std::replace(stack.begin(), stack.end(), '.', ';');
+        ccprintf(os, "%s %d\n", stack, e.second.hostNsecs);
+    }
+}
+
+void
+EventQueueProfile::dump()
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    OutputStream *report = simout.create("eventq_profile.txt");
+    dumpReport(*report->stream());
+    simout.close(report);
+
+    OutputStream *folded = simout.create("eventq_profile.folded");
+    dumpFolded(*folded->stream());
+    simout.close(folded);
+}
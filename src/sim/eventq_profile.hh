@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENTQ_PROFILE_HH__
+#define __SIM_EVENTQ_PROFILE_HH__
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "base/types.hh"
+
+class Event;
+
+/**
+ * Profile of the events processed by the event queues. While it is
+ * active, the event queues report every event they schedule,
+ * reschedule, deschedule and process. The profile counts them per
+ * event name, along with histograms of the host time it takes to
+ * process them and of the distance in ticks between scheduling and
+ * processing them.
+ *
+ * Events are told apart by name. Events without a name of their own
+ * are called Event_<n>, and those are told apart by their description
+ * instead.
+ *
+ * At exit, the profile writes a report sorted by host time to
+ * eventq_profile.txt, and the host time of each event in the folded
+ * stack format of flamegraph.pl to eventq_profile.folded, with the
+ * components of the event names as frames.
+ */
+class EventQueueProfile
+{
+  private:
+    /** Power of two histogram, bucket n counts values in [2^(n-1), 2^n) */
+    struct Histogram
+    {
+        std::array<uint64_t, 65> buckets{};
+
+        void sample(uint64_t value);
+
+        /** Upper bound of the bucket holding the given fraction */
+        uint64_t percentile(double fraction) const;
+
+        void print(std::ostream &os, const char *unit) const;
+    };
+
+    struct Entry
+    {
+        std::string name;
+
+        uint64_t processed = 0;
+        uint64_t hostNsecs = 0;
+        uint64_t reschedules = 0;
+        uint64_t deschedules = 0;
+        uint64_t squashes = 0;
+
+        /** Number of processed events with a known distance */
+        uint64_t distances = 0;
+        Tick totalDistance = 0;
+
+        Histogram hostTime;
+        Histogram distance;
+    };
+
+    /** Protects all of the below, events are scheduled by any thread */
+    std::mutex lock;
+
+    std::unordered_map<std::string, Entry> entries;
+
+    /**
+     * Scheduled events along with their entry and the distance they
+     * were scheduled at.
+     */
+    std::unordered_map<const Event *, std::pair<Entry *, Tick>> pending;
+
+    Entry &entry(const Event *event);
+
+    void dumpReport(std::ostream &os);
+    void dumpFolded(std::ostream &os);
+
+  public:
+    EventQueueProfile();
+    ~EventQueueProfile();
+
+    /** @{ */
+    /** Called by the event queues, see sim/eventq.hh */
+    void scheduled(const Event *event, Tick distance);
+    void rescheduled(const Event *event, Tick distance, bool was_scheduled);
+    void descheduled(const Event *event);
+    void squashed(const Event *event);
+    void process(Event *event);
+    /** @} */
+
+    /** Write the report and the flame graph input */
+    void dump();
+};
+
+#endif // __SIM_EVENTQ_PROFILE_HH__
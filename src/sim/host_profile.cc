@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_profile.hh"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "config/have_perf_event.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+#if HAVE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+HostProfile *HostProfile::active = nullptr;
+
+namespace {
+
+#if HAVE_PERF_EVENT
+/** Hardware events of the counters in HostProfile::Counter order */
+const uint64_t perfEvents[] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+#endif
+
+uint64_t
+hostNsecs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+HostProfile::ThreadProfile::ThreadProfile(size_t num_objects)
+    : counting(false), samples(num_objects + 1)
+{
+    std::fill(std::begin(fds), std::end(fds), -1);
+
+#if HAVE_PERF_EVENT
+    for (int i = 0; i < NumCounters; ++i) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = perfEvents[i];
+        attr.read_format = PERF_FORMAT_GROUP;
+        // Only count the simulator itself, which is also allowed when
+        // the kernel restricts profiling by unprivileged users.
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fds[i] = syscall(__NR_perf_event_open, &attr, 0, -1,
+                         i == 0 ? -1 : fds[0], 0);
+        if (fds[i] == -1) {
+            warn_once("Failed to open the host performance counters: %s. "
+                      "Only profiling host time.\n", strerror(errno));
+            return;
+        }
+    }
+    counting = true;
+#else
+    warn_once("Host performance counters are not supported, only "
+              "profiling host time.\n");
+#endif
+}
+
+HostProfile::ThreadProfile::~ThreadProfile()
+{
+    for (auto fd : fds) {
+        if (fd != -1)
+            close(fd);
+    }
+}
+
+bool
+HostProfile::ThreadProfile::read(uint64_t *counts)
+{
+    if (!counting)
+        return false;
+
+    // A group read returns the number of counters followed by the
+    // value of each of them.
+    uint64_t values[NumCounters + 1];
+    if (::read(fds[0], values, sizeof(values)) != sizeof(values))
+        return false;
+
+    std::copy(values + 1, values + 1 + NumCounters, counts);
+    return true;
+}
+
+HostProfile::HostProfile(Stats::Group *parent)
+    : Stats::Group(parent, "hostProfile"),
+      ADD_STAT(events, "Number of events processed"),
+      ADD_STAT(hostSeconds, "Host time spent processing events (Seconds)"),
+      ADD_STAT(hostCycles, "Host cycles spent processing events"),
+      ADD_STAT(hostInsts, "Host instructions spent processing events"),
+      ADD_STAT(hostCacheMisses, "Host cache misses processing events"),
+      ADD_STAT(hostIpc, "Host instructions per cycle",
+               hostInsts / hostCycles)
+{
+    fatal_if(active, "Only one host profile can be active.\n");
+    active = this;
+}
+
+HostProfile::~HostProfile()
+{
+    active = nullptr;
+}
+
+void
+HostProfile::regStats()
+{
+    using namespace Stats;
+
+    Stats::Group::regStats();
+
+    // All objects have been created by the time the stats are
+    // registered.
+    const auto &objects = SimObject::allObjects();
+    const size_t num_objects = objects.size();
+    for (size_t i = 0; i < num_objects; ++i)
+        objectIndices[objects[i]->name()] = i;
+
+    // The last entry counts the unattributed events
+    events.init(num_objects + 1).flags(nozero);
+    hostSeconds.init(num_objects + 1).flags(nozero);
+    hostCycles.init(num_objects + 1).flags(nozero);
+    hostInsts.init(num_objects + 1).flags(nozero);
+    hostCacheMisses.init(num_objects + 1).flags(nozero);
+    hostIpc.flags(nozero | nonan).precision(2);
+
+    for (size_t i = 0; i <= num_objects; ++i) {
+        const std::string name =
+            i < num_objects ? objects[i]->name() : "unattributed";
+        events.subname(i, name);
+        hostSeconds.subname(i, name);
+        hostCycles.subname(i, name);
+        hostInsts.subname(i, name);
+        hostCacheMisses.subname(i, name);
+        hostIpc.subname(i, name);
+    }
+}
+
+HostProfile::ThreadProfile &
+HostProfile::threadProfile()
+{
+    static __thread ThreadProfile *cached = nullptr;
+
+    if (!cached) {
+        std::lock_guard<std::mutex> guard(lock);
+        threadProfiles.emplace_back(new ThreadProfile(objectIndices.size()));
+        cached = threadProfiles.back().get();
+    }
+
+    return *cached;
+}
+
+size_t
+HostProfile::owner(ThreadProfile &tp, const Event *event)
+{
+    const std::string name = event->name();
+
+    auto cached = tp.owners.find(name);
+    if (cached != tp.owners.end())
+        return cached->second;
+
+    // Strip the components of the event name until what is left
+    // names an object.
+    size_t index = objectIndices.size();
+    std::string prefix = name;
+    while (true) {
+        auto it = objectIndices.find(prefix);
+        if (it != objectIndices.end()) {
+            index = it->second;
+            break;
+        }
+
+        const auto dot = prefix.rfind('.');
+        if (dot == std::string::npos)
+            break;
+        prefix.resize(dot);
+    }
+
+    // Events that are not named after anything are called Event_<n>,
+    // which is different for every event. Only remember the names
+    // that are made of components to keep the cache bounded.
+    if (index != objectIndices.size() || name.find('.') != std::string::npos)
+        tp.owners.emplace(name, index);
+
+    return index;
+}
+
+void
+HostProfile::process(Event *event)
+{
+    ThreadProfile &tp = threadProfile();
+
+    // Look up the owner first, the event may delete itself in process()
+    const size_t index = owner(tp, event);
+
+    uint64_t start[NumCounters], end[NumCounters];
+    const bool counted = tp.read(start);
+    const uint64_t start_nsecs = hostNsecs();
+
+    event->process();
+
+    const uint64_t end_nsecs = hostNsecs();
+    const bool counted_end = tp.read(end);
+
+    Sample &sample = tp.samples[index];
+    ++sample.events;
+    sample.nsecs += end_nsecs - start_nsecs;
+    if (counted && counted_end) {
+        for (int i = 0; i < NumCounters; ++i)
+            sample.counts[i] += end[i] - start[i];
+    }
+}
+
+void
+HostProfile::preDumpStats()
+{
+    Stats::Group::preDumpStats();
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto &tp : threadProfiles) {
+        for (size_t i = 0; i < tp->samples.size(); ++i) {
+            Sample &sample = tp->samples[i];
+            events[i] += sample.events;
+            hostSeconds[i] += sample.nsecs / 1e9;
+            hostCycles[i] += sample.counts[Cycles];
+            hostInsts[i] += sample.counts[Instructions];
+            hostCacheMisses[i] += sample.counts[CacheMisses];
+            sample = Sample();
+        }
+    }
+}
+
+void
+HostProfile::resetStats()
+{
+    Stats::Group::resetStats();
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto &tp : threadProfiles)
+        std::fill(tp->samples.begin(), tp->samples.end(), Sample());
+}
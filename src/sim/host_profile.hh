@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_HOST_PROFILE_HH__
+#define __SIM_HOST_PROFILE_HH__
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/group.hh"
+
+class Event;
+
+/**
+ * Profile of the host resources used by each SimObject. While a
+ * profile is active, EventQueue::serviceOne() hands every event to
+ * process(), which measures the host time, cycles, instructions and
+ * cache misses it takes and attributes them to the SimObject the event
+ * belongs to. The hardware counters are read through perf_event, and
+ * only the host time is measured if they are not available.
+ *
+ * Events are matched to their SimObject by name, so events named after
+ * their owner, like the usual EventFunctionWrapper, are attributed to
+ * it. The others are counted as unattributed.
+ */
+class HostProfile : public Stats::Group
+{
+  public:
+    HostProfile(Stats::Group *parent);
+    ~HostProfile();
+
+    /** The profile events are processed through, if any */
+    static HostProfile *active;
+
+    /** Process an event and attribute its cost to its owner */
+    void process(Event *event);
+
+    void regStats() override;
+    void preDumpStats() override;
+    void resetStats() override;
+
+  private:
+    enum Counter {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        NumCounters
+    };
+
+    /** Costs of one object accumulated by one thread */
+    struct Sample
+    {
+        uint64_t events = 0;
+        uint64_t nsecs = 0;
+        uint64_t counts[NumCounters] = {};
+    };
+
+    /**
+     * Counters and samples of one simulation thread. The samples are
+     * folded into the stats when they are dumped, which happens while
+     * all event queues are synchronized.
+     */
+    struct ThreadProfile
+    {
+        ThreadProfile(size_t num_objects);
+        ~ThreadProfile();
+
+        /** perf_event file descriptors, the first one leads the group */
+        int fds[NumCounters];
+
+        /** Whether the hardware counters could be opened */
+        bool counting;
+
+        /** Samples by object index, unattributed ones last */
+        std::vector<Sample> samples;
+
+        /** Object indices of the event names seen so far */
+        std::unordered_map<std::string, size_t> owners;
+
+        /** Read the counters, returns false if they are not counting */
+        bool read(uint64_t *counts);
+    };
+
+    ThreadProfile &threadProfile();
+
+    /** Index of the object an event belongs to */
+    size_t owner(ThreadProfile &tp, const Event *event);
+
+    /** Indices of the objects by name */
+    std::unordered_map<std::string, size_t> objectIndices;
+
+    std::mutex lock;
+    std::vector<std::unique_ptr<ThreadProfile>> threadProfiles;
+
+    Stats::Vector events;
+    Stats::Vector hostSeconds;
+    Stats::Vector hostCycles;
+    Stats::Vector hostInsts;
+    Stats::Vector hostCacheMisses;
+    Stats::Formula hostIpc;
+};
+
+#endif // __SIM_HOST_PROFILE_HH__
@@ -279,6 +279,12 @@ class ProbePointArg : public ProbePoint
                         listeners.end());
     }
 
+    /**
+     * @brief check if any ProbeListener is attached, so that call sites
+     * can skip preparing arguments nobody will see.
+     */
+    bool hasListeners() const { return !listeners.empty(); }
+
     /**
      * @brief called at the ProbePoint call site, passes arg to each listener.
      * @param arg the argument to pass to each listener.
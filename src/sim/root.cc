@@ -112,6 +112,11 @@ Root::Root(RootParams *p)
     lastTime.setTimer();
 
     simQuantum = p->sim_quantum;
+
+    if (p->host_profile)
+        hostProfile.reset(new HostProfile(this));
+    if (p->eventq_profile)
+        eventQueueProfile.reset(new EventQueueProfile());
 }
 
 void
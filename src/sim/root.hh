@@ -39,9 +39,13 @@
 #ifndef __SIM_ROOT_HH__
 #define __SIM_ROOT_HH__
 
+#include <memory>
+
 #include "base/time.hh"
 #include "params/Root.hh"
 #include "sim/eventq.hh"
+#include "sim/eventq_profile.hh"
+#include "sim/host_profile.hh"
 #include "sim/sim_object.hh"
 
 class Root : public SimObject
@@ -60,6 +64,12 @@ class Root : public SimObject
     void timeSync();
     EventFunctionWrapper syncEvent;
 
+    /** Host profile of the SimObjects, if enabled */
+    std::unique_ptr<HostProfile> hostProfile;
+
+    /** Profile of the event queues, if enabled */
+    std::unique_ptr<EventQueueProfile> eventQueueProfile;
+
   public:
     /**
      * Use this function to get a pointer to the single Root object in the
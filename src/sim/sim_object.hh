@@ -283,6 +283,13 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      * @ingroup api_simobject
      */
     static SimObject *find(const char *name);
+
+    /** All instantiated simulation objects in creation order */
+    static const std::vector<SimObject *> &
+    allObjects()
+    {
+        return simObjectList;
+    }
 };
 
 /**
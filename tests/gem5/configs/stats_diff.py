@@ -0,0 +1,84 @@
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from __future__ import print_function
+
+"""
+Compare the statistics of two systems that were simulated side by side.
+
+Regressions that check an optimization does not change results build two
+identical systems in one simulation, one with the optimization and one
+without, and then check that every statistic of the first matches the same
+statistic of the second.
+"""
+
+import os
+import re
+
+import m5
+
+def read_last_dump(path):
+    """Return the statistics of the last dump in a stats.txt as a dict"""
+
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith('---------- Begin'):
+                stats = {}
+                continue
+            fields = line.split('#', 1)[0].split()
+            if len(fields) < 2:
+                continue
+            stats[fields[0]] = fields[1:]
+    return stats
+
+def dump_stats():
+    """Dump the statistics and return them as read back from stats.txt"""
+
+    m5.stats.dump()
+    return read_last_dump(os.path.join(m5.options.outdir, 'stats.txt'))
+
+def compare_systems(stats, first, second, ignore=()):
+    """
+    Compare the statistics of the systems named first and second. Statistics
+    whose name matches one of the regular expressions in ignore are skipped.
+    Returns the list of differences, which is empty when the two systems
+    produced the same statistics.
+    """
+
+    ignored = [ re.compile(pattern) for pattern in ignore ]
+    differences = []
+    for name, value in sorted(stats.items()):
+        if not name.startswith(first + '.'):
+            continue
+        stat = name[len(first) + 1:]
+        if any(pattern.search(stat) for pattern in ignored):
+            continue
+        other = stats.get(second + '.' + stat)
+        if other != value:
+            differences.append('%s: %s != %s' % (stat, ' '.join(value),
+                ' '.join(other) if other else 'missing'))
+    return differences
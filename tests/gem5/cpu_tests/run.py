@@ -114,6 +114,8 @@ parser.add_argument('--cpu', choices = valid_cpu.keys(),
                     default = 'TimingSimpleCPU')
 parser.add_argument('--mem', choices = valid_mem.keys(),
                     default = 'SimpleMemory')
+parser.add_argument('--decode-block-cache', action = 'store_true',
+                    help = 'Replay decoded basic blocks (AtomicSimpleCPU)')
 
 args = parser.parse_args()
 
@@ -129,6 +131,8 @@ if args.cpu != "AtomicSimpleCPU":
 system.mem_ranges = [AddrRange('512MB')]
 
 system.cpu = valid_cpu[args.cpu]()
+if args.decode_block_cache:
+    system.cpu.decode_block_cache = True
 
 if args.cpu == "AtomicSimpleCPU":
     system.membus = SystemXBar()
@@ -51,6 +51,8 @@ valid_isas = {
     'riscv': ('AtomicSimpleCPU', 'TimingSimpleCPU', 'MinorCPU', 'DerivO3CPU'),
 }
 
+decode_block_cache_isas = ('x86', 'arm')
+
 base_path = joinpath(config.bin_path, 'cpu_tests')
 
 base_url = config.resource_url + '/gem5/cpu_tests/benchmarks/bin/'
@@ -75,3 +77,17 @@ for isa in valid_isas:
                   valid_isas=(isa.upper(),),
                   fixtures=[workload_binary]
             )
+
+        # The loops replay decoded blocks, and leaving them misses in the
+        # block cache and decodes fetched bytes again.
+        if isa in decode_block_cache_isas:
+            gem5_verify_config(
+                  name='cpu_test_AtomicSimpleCPU_decode_block_cache_{}'.format(
+                      workload),
+                  verifiers=verifiers,
+                  config=joinpath(getcwd(), 'run.py'),
+                  config_args=['--cpu=AtomicSimpleCPU',
+                               '--decode-block-cache', binary],
+                  valid_isas=(isa.upper(),),
+                  fixtures=[workload_binary]
+            )
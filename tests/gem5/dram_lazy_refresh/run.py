@@ -0,0 +1,125 @@
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from __future__ import print_function
+
+"""
+Drive two identical DRAM channels with the same idle-heavy traffic, one
+with lazy refresh and one without, and check that deferring the refreshes
+while the controller is idle leaves every statistic unchanged, including
+the DRAMPower energy and the power state residency of the ranks.
+"""
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../configs')
+
+from stats_diff import compare_systems, dump_stats
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--powerdown', action = 'store_true',
+                    help = 'Enable the DRAM low power states')
+
+args = parser.parse_args()
+
+# Bursts of traffic separated by idle phases spanning many refresh
+# intervals, repeated for the whole run
+burst = 5000000
+idle = 100000000
+phases = 8
+
+def build_system(lazy_refresh):
+    system = System(membus = IOXBar(width = 32))
+    system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                       voltage_domain =
+                                       VoltageDomain(voltage = '1V'))
+    system.mem_mode = 'timing'
+    system.mem_ranges = [AddrRange('256MB')]
+    system.mmap_using_noreserve = True
+
+    system.mem_ctrl = MemCtrl(lazy_refresh = lazy_refresh)
+    system.mem_ctrl.dram = DDR4_2400_16x4(range = system.mem_ranges[0],
+                                          ranks_per_channel = 2)
+    system.mem_ctrl.dram.null = True
+    system.mem_ctrl.dram.enable_dram_powerdown = args.powerdown
+    system.mem_ctrl.port = system.membus.master
+
+    system.tgen = PyTrafficGen()
+    system.tgen.port = system.membus.slave
+    system.system_port = system.membus.slave
+
+    return system
+
+def traffic(system):
+    max_addr = system.mem_ranges[0].end
+    # Keep the read percentage at 0 or 100 so that neither generator
+    # draws random numbers, which would make the two systems diverge
+    for phase in range(phases):
+        yield system.tgen.createLinear(burst, 0, max_addr, 64, 3000, 3000,
+                                       100 if phase % 2 else 0, 0)
+        yield system.tgen.createIdle(idle)
+    yield system.tgen.createIdle(phases * (burst + idle))
+
+root = Root(full_system = False)
+root.system0 = build_system(False)
+root.system1 = build_system(True)
+
+m5.instantiate()
+
+root.system0.tgen.start(traffic(root.system0))
+root.system1.tgen.start(traffic(root.system1))
+
+# Reset the stats half way through an idle phase so that the deferred
+# refreshes are also brought up to date on a reset
+period = burst + idle
+exit_event = m5.simulate(period + burst + idle // 2)
+if exit_event.getCause() != 'simulate() limit reached':
+    sys.exit(exit_event.getCause())
+m5.stats.reset()
+
+exit_event = m5.simulate(period * (phases - 2))
+if exit_event.getCause() != 'simulate() limit reached':
+    sys.exit(exit_event.getCause())
+
+stats = dump_stats()
+differences = compare_systems(stats, 'system0', 'system1')
+if differences:
+    print('Lazy refresh changed the statistics:')
+    for difference in differences:
+        print('  ' + difference)
+    sys.exit(1)
+
+# Make sure the ranks refreshed and spent time idle, otherwise there was
+# nothing to defer and the comparison above proves nothing.
+refresh_energy = stats.get('system1.mem_ctrl.dram.rank0.refreshEnergy',
+                           ['0'])
+if float(refresh_energy[0]) == 0:
+    print('No refresh took place')
+    sys.exit(1)
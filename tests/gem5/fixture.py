@@ -174,15 +174,30 @@ class SConsFixture(UniqueFixture):
         log_call(log.test_log, command, stderr=sys.stderr)
 
 class Gem5Fixture(SConsFixture):
-    def __new__(cls, isa, variant, protocol=None):
-        target_dir = joinpath(config.build_dir, isa.upper())
-        if protocol:
-            target_dir += '_' + protocol
+    '''
+    :param build_options: A dict of extra SCons variables to build with.
+        Every variable is added to the name of the build directory, so
+        these builds do not replace the default one.
+    '''
+    def __new__(cls, isa, variant, protocol=None, build_options=None):
+        target_dir = joinpath(config.build_dir,
+                              cls._build_name(isa, protocol, build_options))
         target = joinpath(target_dir, 'gem5.%s' % variant)
         obj = super(Gem5Fixture, cls).__new__(cls, target)
         return obj
 
-    def _init(self, isa, variant, protocol=None):
+    @staticmethod
+    def _build_name(isa, protocol, build_options):
+        name = isa.upper()
+        if protocol:
+            name += '_' + protocol
+        for var, value in sorted((build_options or {}).items()):
+            name += '_' + var
+            if value is not True:
+                name += '_' + str(value)
+        return name
+
+    def _init(self, isa, variant, protocol=None, build_options=None):
         self.name = constants.gem5_binary_fixture_name
 
         self.targets = [self.target]
@@ -190,9 +205,12 @@ class Gem5Fixture(SConsFixture):
         self.directory = config.base_dir
 
         self.options = []
+        if protocol or build_options:
+            self.options = [ '--default=' + isa.upper() ]
         if protocol:
-            self.options = [ '--default=' + isa.upper(),
-                             'PROTOCOL=' + protocol ]
+            self.options.append('PROTOCOL=' + protocol)
+        for var, value in sorted((build_options or {}).items()):
+            self.options.append('%s=%s' % (var, value))
         self.set_global()
 
 class MakeFixture(Fixture):
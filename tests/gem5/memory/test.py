@@ -88,3 +88,21 @@ for basename_noext, args in null_tests:
         valid_isas=('NULL',),
         valid_hosts=constants.supported_hosts,
     )
+
+# Run the random tester on a two level directory protocol and on a
+# broadcast protocol, with the transitions generated both as a switch
+# (the default) and as a table.
+for protocol in ('MESI_Two_Level', 'MOESI_hammer'):
+    for build_options in (None, {'SLICC_TABLE_TRANSITIONS': True}):
+        gem5_verify_config(
+            name='ruby_random_test',
+            fixtures=(),
+            verifiers=(),
+            config=joinpath(config.base_dir, 'configs',
+                'example', 'ruby_random_test.py'),
+            config_args=['--maxloads', '5000'],
+            valid_isas=('X86',),
+            valid_hosts=constants.supported_hosts,
+            protocol=protocol,
+            build_options=build_options,
+        )
@@ -0,0 +1,118 @@
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from __future__ import print_function
+
+"""
+Run the same memory-bound workload on two O3 CPUs, one with fastIdle and
+one without, and check that skipping the stalled cycles leaves every
+statistic unchanged.
+"""
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../configs')
+
+from stats_diff import compare_systems, dump_stats
+
+parser = argparse.ArgumentParser()
+parser.add_argument('binary', type = str)
+
+args = parser.parse_args()
+
+def build_system(fast_idle):
+    system = System()
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = '1GHz'
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_mode = 'timing'
+    system.mem_ranges = [AddrRange('512MB')]
+
+    system.cpu = DerivO3CPU(fastIdle = fast_idle)
+
+    # Small caches in front of DRAM so the CPU spends most of its time
+    # waiting on misses, which is where fastIdle skips cycles.
+    system.cpu.icache = Cache(size = '8kB', assoc = 2, tag_latency = 1,
+                              data_latency = 1, response_latency = 1,
+                              mshrs = 4, tgts_per_mshr = 8)
+    system.cpu.dcache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                              data_latency = 1, response_latency = 1,
+                              mshrs = 4, tgts_per_mshr = 8)
+    system.membus = SystemXBar()
+    system.cpu.icache.cpu_side = system.cpu.icache_port
+    system.cpu.icache.mem_side = system.membus.slave
+    system.cpu.dcache.cpu_side = system.cpu.dcache_port
+    system.cpu.dcache.mem_side = system.membus.slave
+
+    system.cpu.createInterruptController()
+    if buildEnv['TARGET_ISA'] == 'x86':
+        system.cpu.interrupts[0].pio = system.membus.master
+        system.cpu.interrupts[0].int_master = system.membus.slave
+        system.cpu.interrupts[0].int_slave = system.membus.master
+
+    system.mem_ctrl = DDR3_1600_8x8()
+    system.mem_ctrl.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.master
+    system.system_port = system.membus.slave
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    return system
+
+root = Root(full_system = False)
+root.system0 = build_system(False)
+root.system1 = build_system(True)
+
+m5.instantiate()
+
+exit_event = m5.simulate()
+if exit_event.getCause() != 'exiting with last active thread context':
+    sys.exit(exit_event.getCause())
+
+stats = dump_stats()
+differences = compare_systems(stats, 'system0', 'system1',
+                              ignore = [ r'\.stalledCycles$' ])
+if differences:
+    print('fastIdle changed the statistics:')
+    for difference in differences:
+        print('  ' + difference)
+    sys.exit(1)
+
+# Make sure the workload actually stalled, otherwise nothing was skipped and
+# the comparison above proves nothing.
+stalled = stats.get('system1.cpu.stalledCycles', ['0'])
+if int(stalled[0]) == 0:
+    print('fastIdle never skipped a cycle')
+    sys.exit(1)
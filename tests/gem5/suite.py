@@ -59,7 +59,8 @@ def gem5_verify_config(name,
                        valid_variants=constants.supported_variants,
                        length=constants.supported_lengths[0],
                        valid_hosts=constants.supported_hosts,
-                       protocol=None):
+                       protocol=None,
+                       build_options=None):
     '''
     Helper class to generate common gem5 tests using verifiers.
 
@@ -84,6 +85,11 @@ def gem5_verify_config(name,
 
     :param valid_variants: An iterable with the variant levels that
         this test can be ran for. (E.g. opt, debug)
+
+    :param protocol: The Ruby protocol to build gem5 with.
+
+    :param build_options: A dict of extra SCons variables to build gem5
+        with, e.g. {'SLICC_TABLE_TRANSITIONS': True}.
     '''
     fixtures = list(fixtures)
     testsuites = []
@@ -105,6 +111,8 @@ def gem5_verify_config(name,
                         opt=opt)
                 if protocol:
                     _name += '-'+protocol
+                for var in sorted(build_options or {}):
+                    _name += '-'+var
 
                 # Create the running of gem5 subtest.  NOTE: We specifically
                 # create this test before our verifiers so this is listed
@@ -126,7 +134,8 @@ def gem5_verify_config(name,
                 # Create the gem5 target for the specific architecture and
                 # variant.
                 _fixtures = copy.copy(fixtures)
-                _fixtures.append(Gem5Fixture(isa, opt, protocol))
+                _fixtures.append(Gem5Fixture(isa, opt, protocol,
+                                             build_options))
                 _fixtures.append(tempdir)
                 _fixtures.append(gem5_returncode)
 
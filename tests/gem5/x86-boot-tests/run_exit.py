@@ -42,6 +42,7 @@ parser.add_argument('--disk', type=str)
 parser.add_argument('--cpu-type', choices=['atomic', 'kvm', 'o3', 'simple',])
 parser.add_argument('--num-cpus', type=int)
 parser.add_argument('--boot-type', choices=['init', 'systemd',])
+parser.add_argument('--num-walk-slots', type=int, default=1)
 
 #(options, args) = parser.parse_args()
 args = parser.parse_args()
@@ -49,6 +50,10 @@ args = parser.parse_args()
 # create the system we are going to simulate
 system = MySystem(args.kernel, args.disk, args.cpu_type, args.num_cpus)
 
+for cpu in system.cpu:
+    cpu.itb.walker.num_walk_slots = args.num_walk_slots
+    cpu.dtb.walker.num_walk_slots = args.num_walk_slots
+
 if args.boot_type == "init":
     # Simply run "exit.sh"
     system.workload.command_line += ' init=/root/exit.sh'
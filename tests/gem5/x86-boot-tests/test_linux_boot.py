@@ -44,10 +44,13 @@ image = DownloadedProgram(image_url, base_path, image_name, True)
 kernel = DownloadedProgram(kernel_url, base_path, kernel_name)
 
 
-def test_boot(cpu_type, num_cpus, boot_type):
+def test_boot(cpu_type, num_cpus, boot_type, num_walk_slots = '1'):
+    name = 'test-ubuntu_boot-' + cpu_type + '_cpu-' + num_cpus + '_cpus-' \
+           + boot_type + '_boot'
+    if num_walk_slots != '1':
+        name += '-' + num_walk_slots + '_walk_slots'
     gem5_verify_config(
-        name = 'test-ubuntu_boot-' + cpu_type + '_cpu-' + num_cpus + '_cpus-'
-               + boot_type + '_boot',
+        name = name,
         verifiers = (),
         fixtures = (image, kernel,),
         config = joinpath(joinpath(absdirpath(__file__), 'run_exit.py')),
@@ -57,6 +60,7 @@ def test_boot(cpu_type, num_cpus, boot_type):
             '--cpu-type', cpu_type,
             '--num-cpus', num_cpus,
             '--boot-type', boot_type,
+            '--num-walk-slots', num_walk_slots,
         ],
         valid_isas = ('X86',),
         valid_hosts = constants.supported_hosts,
@@ -70,3 +74,8 @@ for cpu_type in cpu_types:
 
 # Test a multicore system
 test_boot('atomic', '4', 'systemd')
+
+# Test concurrent page table walks, which the O3 CPU starts for both
+# fetches and data accesses. Walks of the same page are only coalesced
+# when the first one also sets the bits the others need.
+test_boot('o3', '1', 'init', '4')
@@ -0,0 +1,179 @@
+#!/usr/bin/env python2.7
+
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a protobuf packet trace or instruction dependency
+# trace to the fixed-record binary trace format described in
+# src/cpu/trace/binary_trace.hh. Binary traces are memory mapped by the
+# TraceCPU and the TraceGen state of the traffic generator, and support
+# starting playback at an arbitrary record.
+#
+# Usage: convert_binary_trace.py <packet|inst_dep> <protobuf in> <binary out>
+#
+# The packet format is used for the instruction fetch trace of the
+# TraceCPU and for traffic generator traces, the inst_dep format for
+# the data dependency trace of the TraceCPU.
+
+from __future__ import print_function
+
+import protolib
+import struct
+import sys
+
+# Import the proto definitions. If they are not found, attempt to
+# generate them automatically. This assumes that the script is
+# executed from the gem5 root.
+try:
+    import inst_dep_record_pb2
+    import packet_pb2
+except:
+    print("Did not find proto definitions, attempting to generate")
+    from subprocess import call
+    error = call(['protoc', '--python_out=util', '--proto_path=src/proto',
+                  'src/proto/inst_dep_record.proto',
+                  'src/proto/packet.proto'])
+    if not error:
+        import inst_dep_record_pb2
+        import packet_pb2
+        print("Generated proto definitions")
+    else:
+        print("Failed to import proto definitions")
+        exit(-1)
+
+# These must match the structures in src/cpu/trace/binary_trace.hh
+MAGIC = b'gem5btr\0'
+VERSION = 2
+PACKET_TRACE = 1
+INST_DEP_TRACE = 2
+
+HEADER = struct.Struct('<8sIIQIIQ24x')
+PACKET_RECORD = struct.Struct('<QQQIII4x')
+INST_DEP_RECORD = struct.Struct('<QQQQQQQIIIBBB1x2I8I')
+
+MAX_ROB_DEP = 2
+MAX_REG_DEP = 8
+
+def packet_record(pkt):
+    return PACKET_RECORD.pack(pkt.tick, pkt.addr,
+                              pkt.pc if pkt.HasField('pc') else 0,
+                              pkt.size,
+                              pkt.flags if pkt.HasField('flags') else 0,
+                              pkt.cmd)
+
+def dep_distances(rec, deps, max_deps, kind):
+    if len(deps) > max_deps:
+        print("Seq. num", rec.seq_num, "has", len(deps), kind,
+              "dependencies, at most", max_deps, "are supported")
+        exit(-1)
+    dists = []
+    for dep in deps:
+        dist = rec.seq_num - dep
+        if dist <= 0 or dist >= 2**32:
+            print("Seq. num", rec.seq_num, "has an unsupported", kind,
+                  "dependency on", dep)
+            exit(-1)
+        dists.append(dist)
+    return dists + [0] * (max_deps - len(dists))
+
+def inst_dep_record(rec):
+    rob_dep = dep_distances(rec, rec.rob_dep, MAX_ROB_DEP, "order")
+    reg_dep = dep_distances(rec, rec.reg_dep, MAX_REG_DEP, "register")
+    fields = [rec.seq_num, rec.comp_delay,
+              rec.p_addr if rec.HasField('p_addr') else 0,
+              rec.v_addr if rec.HasField('v_addr') else 0,
+              rec.pc if rec.HasField('pc') else 0,
+              rec.sync_seq if rec.HasField('sync_seq') else 0,
+              rec.sync_dep if rec.HasField('sync_dep') else 0,
+              rec.size if rec.HasField('size') else 0,
+              rec.flags if rec.HasField('flags') else 0,
+              rec.weight if rec.HasField('weight') else 0,
+              rec.type, len(rec.rob_dep), len(rec.reg_dep)]
+    return INST_DEP_RECORD.pack(*(fields + rob_dep + reg_dep))
+
+def main():
+    if len(sys.argv) != 4 or sys.argv[1] not in ('packet', 'inst_dep'):
+        print("Usage:", sys.argv[0], "<packet|inst_dep> <protobuf input>",
+              "<binary output>")
+        exit(-1)
+
+    if sys.argv[1] == 'packet':
+        header = packet_pb2.PacketHeader()
+        record = packet_pb2.Packet()
+        record_type = PACKET_TRACE
+        record_struct = PACKET_RECORD
+        encode = packet_record
+    else:
+        header = inst_dep_record_pb2.InstDepRecordHeader()
+        record = inst_dep_record_pb2.InstDepRecord()
+        record_type = INST_DEP_TRACE
+        record_struct = INST_DEP_RECORD
+        encode = inst_dep_record
+
+    proto_in = protolib.openFileRd(sys.argv[2])
+
+    try:
+        binary_out = open(sys.argv[3], 'wb')
+    except IOError:
+        print("Failed to open", sys.argv[3], "for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4)
+
+    if magic_number != b"gem5":
+        print("Unrecognized file")
+        exit(-1)
+
+    protolib.decodeMessage(proto_in, header)
+    print("Object id:", header.obj_id)
+    print("Tick frequency:", header.tick_freq)
+
+    window_size = 0
+    if record_type == INST_DEP_TRACE:
+        window_size = header.window_size
+
+    # Reserve space for the header, the record count is filled in once
+    # the whole trace has been converted
+    binary_out.write(b'\0' * HEADER.size)
+
+    num_records = 0
+    while protolib.decodeMessage(proto_in, record):
+        binary_out.write(encode(record))
+        num_records += 1
+
+    binary_out.seek(0)
+    binary_out.write(HEADER.pack(MAGIC, VERSION, record_type,
+                                 header.tick_freq, window_size,
+                                 record_struct.size, num_records))
+
+    print("Converted", num_records, "records")
+
+    proto_in.close()
+    binary_out.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,567 @@
+#!/usr/bin/env python2.7
+
+# Copyright (c) 2026 agent
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script decodes the binary debug output written with
+# --debug-binary (see src/base/binary_trace.hh) into the text the
+# debug flags would have printed otherwise. The format strings are
+# expanded the way cprintf does it, including its quirks, so the
+# output can be compared with a text trace of the same run.
+#
+# Usage: decode_debug_trace.py <binary trace> [<text output>]
+#
+# Records written by different simulation threads are decoded in the
+# order they were written and are not sorted by tick.
+
+from __future__ import print_function
+
+import re
+import struct
+import sys
+
+try:
+    unichr
+except NameError:
+    unichr = chr
+
+magic = b'gem5dbg\0'
+version = 1
+
+max_tick = 2 ** 64 - 1
+
+# Entry kinds, options and argument types, see src/base/binary_trace.hh
+# and src/base/trace.hh
+STRING_ENTRY, RECORD_ENTRY, MESSAGE_ENTRY = 1, 2, 3
+SHOW_FLAG, TICKS_OFF = 0x1, 0x2
+SIGNED, UNSIGNED, FLOAT, CHAR, STRING, POINTER = range(1, 7)
+
+_u8 = struct.Struct('=B')
+_u32 = struct.Struct('=I')
+_u64 = struct.Struct('=Q')
+_s64 = struct.Struct('=q')
+_s8 = struct.Struct('=b')
+_double = struct.Struct('=d')
+_string_header = struct.Struct('=II')
+_record_header = struct.Struct('=QIIIB')
+_message_header = struct.Struct('=QII')
+
+_literal = re.compile(u'[^%\n\r]+')
+
+class Format(object):
+    """Conversion specification, mirrors cp::Format"""
+
+    def __init__(self):
+        self.alternate_form = False
+        self.flush_left = False
+        self.print_sign = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = 'dec'
+        self.format = None
+        self.float_format = 'best'
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+def _is_char(arg):
+    kind, size, value = arg
+    return kind == CHAR or (kind in (SIGNED, UNSIGNED) and size == 1)
+
+def _pad(text, width, fill, left):
+    if width <= len(text):
+        return text
+    if left:
+        return text + fill * (width - len(text))
+    return fill * (width - len(text)) + text
+
+class Print(object):
+    """Expands a format string the way cp::Print in src/base/cprintf.cc
+    does. Arguments are (type, size, value) tuples as they are stored
+    in the records.
+
+    The state of the output stream that outlives a single conversion,
+    its fill character and precision, is kept here as well."""
+
+    def __init__(self, format):
+        # cprintf stops at the terminating null character
+        self.format = format.split(u'\0', 1)[0]
+        self.ptr = 0
+        self.cont = False
+        self.fmt = Format()
+        self.fill = u' '
+        self.precision = 6
+        self.out = []
+
+    def _char(self, offset=0):
+        pos = self.ptr + offset
+        return self.format[pos] if pos < len(self.format) else u''
+
+    def _literals(self, extra_arg):
+        fmt = self.format
+        while self.ptr < len(fmt):
+            c = fmt[self.ptr]
+            if c == u'%':
+                if self._char(1) != u'%':
+                    if not extra_arg:
+                        return True
+                    self.out.append(u'<extra arg>')
+                self.out.append(u'%')
+                self.ptr += 2
+            elif c == u'\n':
+                self.out.append(u'\n')
+                self.ptr += 1
+            elif c == u'\r':
+                self.ptr += 1
+                if self._char() != u'\n':
+                    self.out.append(u'\n')
+            else:
+                match = _literal.match(fmt, self.ptr)
+                self.out.append(match.group())
+                self.ptr = match.end()
+        return False
+
+    def process(self):
+        self.fmt = Format()
+        if self._literals(False):
+            self.process_flag()
+
+    def process_flag(self):
+        fmt = self.fmt
+        done = False
+        end_number = False
+        have_precision = False
+        number = 0
+
+        self.fill = u' '
+
+        while not done:
+            self.ptr += 1
+            c = self._char()
+            if c.isdigit():
+                if end_number:
+                    continue
+            elif number > 0:
+                end_number = True
+
+            if c == u's':
+                fmt.format = 'string'
+                done = True
+            elif c == u'c':
+                fmt.format = 'character'
+                done = True
+            elif c == u'l':
+                continue
+            elif c == u'p':
+                fmt.format = 'integer'
+                fmt.base = 'hex'
+                fmt.alternate_form = True
+                done = True
+            elif c in u'xX':
+                fmt.uppercase = fmt.uppercase or c == u'X'
+                fmt.base = 'hex'
+                fmt.format = 'integer'
+                done = True
+            elif c == u'o':
+                fmt.base = 'oct'
+                fmt.format = 'integer'
+                done = True
+            elif c in u'diu':
+                fmt.format = 'integer'
+                done = True
+            elif c in u'gG':
+                fmt.uppercase = fmt.uppercase or c == u'G'
+                fmt.format = 'floating'
+                fmt.float_format = 'best'
+                done = True
+            elif c in u'eE':
+                fmt.uppercase = fmt.uppercase or c == u'E'
+                fmt.format = 'floating'
+                fmt.float_format = 'scientific'
+                done = True
+            elif c == u'f':
+                fmt.format = 'floating'
+                fmt.float_format = 'fixed'
+                done = True
+            elif c == u'n':
+                self.out.append(u"we don't do %n!!!\n")
+                done = True
+            elif c == u'#':
+                fmt.alternate_form = True
+            elif c == u'-':
+                fmt.flush_left = True
+            elif c == u'+':
+                fmt.print_sign = True
+            elif c == u' ' or c == u'%':
+                pass
+            elif c == u'.':
+                fmt.width = number
+                fmt.precision = 0
+                have_precision = True
+                number = 0
+                end_number = False
+            elif c == u'0' and number == 0:
+                fmt.fill_zero = True
+            elif c.isdigit():
+                number = number * 10 + int(c)
+            elif c == u'*':
+                if have_precision:
+                    fmt.get_precision = True
+                else:
+                    fmt.get_width = True
+            else:
+                done = True
+
+            if end_number:
+                if have_precision:
+                    fmt.precision = number
+                else:
+                    fmt.width = number
+                end_number = False
+                number = 0
+
+            if done:
+                if fmt.format == 'integer' and have_precision:
+                    fmt.width = fmt.precision
+                    fmt.fill_zero = True
+                elif (fmt.format == 'floating' and not have_precision and
+                      fmt.fill_zero):
+                    fmt.precision = fmt.width
+
+        self.ptr += 1
+
+    def add_arg(self, arg):
+        if not self.cont:
+            self.process()
+
+        fmt = self.fmt
+        if fmt.get_width:
+            fmt.get_width = False
+            self.cont = True
+            fmt.width = self._get_number(arg)
+            return
+
+        if fmt.get_precision:
+            fmt.get_precision = False
+            self.cont = True
+            fmt.precision = self._get_number(arg)
+            return
+
+        if fmt.format == 'character':
+            self._format_char(arg)
+        elif fmt.format == 'integer':
+            self._format_integer(arg)
+        elif fmt.format == 'floating':
+            self._format_float(arg)
+        elif fmt.format == 'string':
+            self._format_string(arg)
+        else:
+            self.out.append(u'<bad format>')
+
+    def end_args(self):
+        self._literals(True)
+        return u''.join(self.out)
+
+    @staticmethod
+    def _get_number(arg):
+        kind, size, value = arg
+        return value if kind == SIGNED and size == 4 else 0
+
+    @staticmethod
+    def _float(value, conv, precision, print_sign=False):
+        spec = (u'%+.*' if print_sign else u'%.*') + conv
+        return spec % (precision, value)
+
+    def _plain(self, arg, precision):
+        """What "out << data" prints with the flags cleared"""
+        kind, size, value = arg
+        if _is_char(arg):
+            return unichr(value & 0xff)
+        if kind in (SIGNED, UNSIGNED):
+            return u'%d' % value
+        if kind == FLOAT:
+            return self._float(value, u'g', precision)
+        if kind == POINTER:
+            return u'0x%x' % value if value else u'0'
+        return value
+
+    def _format_char(self, arg):
+        kind, size, value = arg
+        if kind in (SIGNED, UNSIGNED, CHAR):
+            self.out.append(unichr(value & 0xff))
+        else:
+            self.out.append(u'<bad arg type for char format>')
+
+    def _format_integer(self, arg):
+        fmt = self.fmt
+        kind, size, value = arg
+
+        showbase = False
+        if fmt.alternate_form:
+            if not fmt.fill_zero:
+                showbase = True
+            elif fmt.base == 'hex':
+                self.out.append(u'0x')
+                fmt.width -= 2
+            elif fmt.base == 'oct':
+                self.out.append(u'0')
+                fmt.width -= 1
+
+        if fmt.fill_zero:
+            self.fill = u'0'
+
+        # Characters are printed as int
+        if _is_char(arg):
+            kind = SIGNED
+            size = 4
+
+        if kind in (SIGNED, UNSIGNED):
+            if fmt.base == 'dec':
+                text = u'%d' % value
+                if kind == SIGNED and fmt.print_sign and value >= 0:
+                    text = u'+' + text
+            else:
+                # Negative values are printed as their unsigned type
+                if value < 0:
+                    value += 1 << (8 * size)
+                hex_base = fmt.base == 'hex'
+                text = (u'%x' if hex_base else u'%o') % value
+                if fmt.uppercase:
+                    text = text.upper()
+                if showbase and value:
+                    prefix = u'0x' if hex_base else u'0'
+                    if fmt.uppercase:
+                        prefix = prefix.upper()
+                    text = prefix + text
+        elif kind == POINTER:
+            # Pointers are always printed as lower case hex with a base
+            text = u'0x%x' % value if value else u'0'
+        elif kind == FLOAT:
+            text = self._float(value, u'g', self.precision, fmt.print_sign)
+        else:
+            text = value
+
+        self.out.append(_pad(text, fmt.width, self.fill,
+                             fmt.flush_left and not fmt.fill_zero))
+
+    def _format_float(self, arg):
+        fmt = self.fmt
+        kind, size, value = arg
+        if kind != FLOAT:
+            self.out.append(u'<bad arg type for float format>')
+            return
+
+        if fmt.fill_zero:
+            self.fill = u'0'
+
+        conv = u'g'
+        if fmt.float_format == 'scientific':
+            if fmt.precision != -1:
+                if fmt.precision == 0:
+                    fmt.precision = 1
+                else:
+                    conv = u'e'
+                self.precision = fmt.precision
+            if fmt.uppercase:
+                conv = conv.upper()
+        elif fmt.float_format == 'fixed':
+            if fmt.precision != -1:
+                conv = u'f'
+                self.precision = fmt.precision
+        elif fmt.precision != -1:
+            self.precision = fmt.precision
+
+        self.out.append(_pad(self._float(value, conv, self.precision),
+                             fmt.width, self.fill, False))
+
+    def _format_string(self, arg):
+        fmt = self.fmt
+        if fmt.width > 0:
+            # The padding is measured with a fresh stream
+            text = self._plain(arg, 6)
+            if fmt.width > len(text):
+                self.out.append(_pad(text, fmt.width, u' ', fmt.flush_left))
+                return
+        self.out.append(self._plain(arg, self.precision))
+
+def cprintf(format, args):
+    """Expand a format string with a list of record arguments"""
+    printer = Print(format)
+    for arg in args:
+        printer.add_arg(arg)
+    return printer.end_args()
+
+class DebugTrace(object):
+    """Reads the messages of a binary debug trace. Iterating over the
+    object yields the lines of the text trace, and readline() makes it
+    a drop-in replacement for a text trace file."""
+
+    def __init__(self, trace):
+        self.trace = trace
+        if trace.read(len(magic)) != magic:
+            raise ValueError("Not a binary debug trace")
+        file_version = self._read(_u32)[0]
+        if file_version != version:
+            raise ValueError("Unsupported binary debug trace version %d" %
+                             file_version)
+        self.options = self._read(_u8)[0]
+        self.strings = { 0 : u'' }
+        self._lines = None
+        self._pending = []
+
+    def _read_bytes(self, size):
+        data = self.trace.read(size)
+        if len(data) != size:
+            raise EOFError
+        return data
+
+    def _read(self, st):
+        return st.unpack(self._read_bytes(st.size))
+
+    def _read_string(self):
+        size = self._read(_u32)[0]
+        return self._read_bytes(size).decode('latin-1')
+
+    def _read_arg(self):
+        kind = self._read(_u8)[0]
+        if kind == SIGNED:
+            size = self._read(_u8)[0]
+            return kind, size, self._read(_s64)[0]
+        if kind in (UNSIGNED, POINTER):
+            size = self._read(_u8)[0]
+            return kind, size, self._read(_u64)[0]
+        if kind == FLOAT:
+            return kind, 8, self._read(_double)[0]
+        if kind == CHAR:
+            return kind, 1, self._read(_s8)[0]
+        if kind == STRING:
+            return kind, 0, self._read_string()
+        raise ValueError("Unknown argument type %d" % kind)
+
+    def messages(self):
+        """Yield (tick, name, flag, message) for every message"""
+        strings = self.strings
+        while True:
+            kind = self.trace.read(1)
+            if not kind:
+                return
+            kind = _u8.unpack(kind)[0]
+            try:
+                if kind == STRING_ENTRY:
+                    string_id = self._read(_u32)[0]
+                    strings[string_id] = self._read_string()
+                elif kind == RECORD_ENTRY:
+                    tick, name, flag, fmt, num_args = \
+                        self._read(_record_header)
+                    args = [ self._read_arg() for i in range(num_args) ]
+                    yield (tick, strings[name], strings[flag],
+                           cprintf(strings[fmt], args))
+                elif kind == MESSAGE_ENTRY:
+                    tick, name, flag = self._read(_message_header)
+                    yield (tick, strings[name], strings[flag],
+                           self._read_string())
+                else:
+                    raise ValueError("Unknown entry kind %d" % kind)
+            except EOFError:
+                # Simulations that did not exit cleanly can leave a
+                # partially written entry behind.
+                print("Warning: Truncated binary debug trace",
+                      file=sys.stderr)
+                return
+
+    def __iter__(self):
+        """Yield the text the messages would have been printed as,
+        formatted like Trace::OstreamLogger does it"""
+        show_ticks = not self.options & TICKS_OFF
+        show_flag = self.options & SHOW_FLAG
+        for tick, name, flag, message in self.messages():
+            prefix = []
+            if show_ticks and tick != max_tick:
+                prefix.append(u'%7d: ' % tick)
+            if show_flag and flag:
+                prefix.append(flag + u': ')
+            if name:
+                prefix.append(name + u': ')
+            yield u''.join(prefix) + message
+
+    def readline(self):
+        """Return the next line of the text trace like file.readline()"""
+        if self._lines is None:
+            self._lines = iter(self)
+        while True:
+            text = u''.join(self._pending)
+            pos = text.find(u'\n')
+            if pos >= 0:
+                self._pending = [ text[pos + 1:] ]
+                return text[:pos + 1]
+            try:
+                self._pending = [ text, next(self._lines) ]
+            except StopIteration:
+                self._pending = []
+                return text
+
+    def close(self):
+        self.trace.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+def open_trace(path):
+    """Open a text debug trace or a binary one as a text file"""
+    trace = open(path, 'rb')
+    if trace.read(len(magic)) == magic:
+        trace.seek(0)
+        return DebugTrace(trace)
+    trace.close()
+    return open(path, 'r')
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print("Usage: ", sys.argv[0], " <binary trace> [<text output>]")
+        exit(-1)
+
+    try:
+        trace = DebugTrace(open(sys.argv[1], 'rb'))
+    except (IOError, ValueError, EOFError) as e:
+        print("Failed to open %s: %s" % (sys.argv[1], e))
+        exit(-1)
+
+    if len(sys.argv) == 3:
+        out = open(sys.argv[2], 'wb')
+    else:
+        out = getattr(sys.stdout, 'buffer', sys.stdout)
+
+    with trace:
+        for text in trace:
+            out.write(text.encode('latin-1'))
+    out.flush()
+
+if __name__ == "__main__":
+    main()
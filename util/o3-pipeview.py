@@ -42,6 +42,8 @@ import os
 import sys
 import copy
 
+import decode_debug_trace
+
 # Temporary storage for instructions. The queue is filled in out-of-order
 # until it reaches 'max_threshold' number of instructions. It is then
 # sorted out and instructions are printed out until their number drops to
@@ -359,7 +361,8 @@ def main():
         sys.exit(1)
     # Process trace
     print 'Processing trace... ',
-    with open(args[0], 'r') as trace:
+    # Binary debug traces (--debug-binary) are decoded on the fly
+    with decode_debug_trace.open_trace(args[0]) as trace:
         with open(options.outfile, 'w') as out:
             process_trace(trace, out, options.cycle_time, options.width,
                           options.color, options.timestamps,